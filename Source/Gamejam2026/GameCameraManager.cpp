@@ -0,0 +1,203 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "GameCameraManager.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/SpringArmComponent.h"
+
+void AGameCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
+{
+	// modes only drive pawns. Anything else, like cinematic cameras, uses the regular behavior
+	APawn* TargetPawn = Cast<APawn>(OutVT.Target);
+
+	// reset the stack when the view target changes
+	if (TargetPawn != ModeViewTarget.Get())
+	{
+		SetModeViewTarget(TargetPawn);
+	}
+
+	float BlendTime = 0.0f;
+	float BlendExponent = 1.0f;
+	UGameCameraMode* RequestedMode = IsValid(TargetPawn) ? GetRequestedMode(BlendTime, BlendExponent) : nullptr;
+
+	if (!RequestedMode)
+	{
+		// give the view back to the pawn's own camera
+		if (ModeStack.Num() > 0)
+		{
+			SetSpringArmsEnabled(TargetPawn, true);
+			ModeStack.Reset();
+		}
+
+		Super::UpdateViewTarget(OutVT, DeltaTime);
+		return;
+	}
+
+	// take over the view from the pawn's own camera
+	if (ModeStack.Num() == 0)
+	{
+		SetSpringArmsEnabled(TargetPawn, false);
+		LastView.Location = OutVT.POV.Location;
+		LastView.Rotation = OutVT.POV.Rotation;
+		LastView.FOV = OutVT.POV.FOV;
+	}
+
+	if (ModeStack.Num() == 0 || ModeStack.Last().Mode != RequestedMode)
+	{
+		PushMode(RequestedMode, BlendTime, BlendExponent, TargetPawn);
+	}
+
+	// advance the blends. The bottom mode is always fully weighted
+	int32 FirstOpaque = 0;
+
+	for (int32 i = 1; i < ModeStack.Num(); ++i)
+	{
+		FGameCameraModeStackEntry& Entry = ModeStack[i];
+		Entry.Alpha = Entry.BlendTime > 0.0f ? FMath::Min(Entry.Alpha + DeltaTime / Entry.BlendTime, 1.0f) : 1.0f;
+
+		if (Entry.Alpha >= 1.0f)
+		{
+			FirstOpaque = i;
+		}
+	}
+
+	// drop the modes fully covered by a finished blend
+	if (FirstOpaque > 0)
+	{
+		ModeStack.RemoveAt(0, FirstOpaque, EAllowShrinking::No);
+	}
+
+	// evaluate the stack bottom to top, blending each mode over the ones below it
+	FGameCameraView View = LastView;
+	ModeStack[0].Mode->UpdateView(TargetPawn, DeltaTime, View);
+
+	for (int32 i = 1; i < ModeStack.Num(); ++i)
+	{
+		const FGameCameraModeStackEntry& Entry = ModeStack[i];
+
+		FGameCameraView ModeView = View;
+		Entry.Mode->UpdateView(TargetPawn, DeltaTime, ModeView);
+
+		View.Blend(ModeView, FMath::InterpEaseInOut(0.0f, 1.0f, Entry.Alpha, Entry.BlendExponent));
+	}
+
+	LastView = View;
+
+	// update the output
+	OutVT.POV.Location = View.Location;
+	OutVT.POV.Rotation = View.Rotation;
+	OutVT.POV.FOV = View.FOV;
+
+	// let camera shakes and other modifiers run on top
+	ApplyCameraModifiers(DeltaTime, OutVT.POV);
+}
+
+void AGameCameraManager::SetCameraMode(UGameCameraModeData* ModeData)
+{
+	OverrideMode = ModeData;
+}
+
+UGameCameraMode* AGameCameraManager::GetRequestedMode(float& OutBlendTime, float& OutBlendExponent)
+{
+	// use the override first, then the default mode
+	for (UGameCameraModeData* ModeData : { OverrideMode.Get(), DefaultMode.Get() })
+	{
+		if (UGameCameraMode* Mode = GetPooledMode(ModeData))
+		{
+			OutBlendTime = ModeData->BlendTime;
+			OutBlendExponent = ModeData->BlendExponent;
+			return Mode;
+		}
+	}
+
+	// fall back to the mode provided by the subclass, if any
+	if (!bFallbackModeCreated)
+	{
+		bFallbackModeCreated = true;
+		FallbackMode = CreateFallbackMode();
+	}
+
+	OutBlendTime = 0.0f;
+	OutBlendExponent = 1.0f;
+	return FallbackMode;
+}
+
+UGameCameraMode* AGameCameraManager::GetPooledMode(UGameCameraModeData* ModeData)
+{
+	if (!ModeData || !ModeData->Mode)
+	{
+		return nullptr;
+	}
+
+	if (TObjectPtr<UGameCameraMode>* PooledMode = ModePool.Find(ModeData))
+	{
+		return *PooledMode;
+	}
+
+	// copy the asset's configured mode so its smoothing state doesn't leak into the asset
+	UGameCameraMode* Mode = NewObject<UGameCameraMode>(this, ModeData->Mode->GetClass(), NAME_None, RF_Transient, ModeData->Mode);
+	ModePool.Add(ModeData, Mode);
+
+	return Mode;
+}
+
+void AGameCameraManager::PushMode(UGameCameraMode* Mode, float BlendTime, float BlendExponent, AActor* ViewTarget)
+{
+	ModeStack.Reserve(MaxStackDepth);
+
+	// modes already on the stack keep their state and blend back in from where they are
+	const int32 ExistingIndex = ModeStack.IndexOfByPredicate([Mode](const FGameCameraModeStackEntry& Entry) { return Entry.Mode == Mode; });
+
+	if (ExistingIndex != INDEX_NONE)
+	{
+		ModeStack.RemoveAt(ExistingIndex, EAllowShrinking::No);
+
+	} else {
+
+		Mode->OnActivated(ViewTarget, LastView);
+	}
+
+	// make room for the new mode
+	if (ModeStack.Num() >= MaxStackDepth)
+	{
+		ModeStack.RemoveAt(0, ModeStack.Num() - MaxStackDepth + 1, EAllowShrinking::No);
+	}
+
+	FGameCameraModeStackEntry& Entry = ModeStack.AddDefaulted_GetRef();
+	Entry.Mode = Mode;
+	Entry.BlendTime = BlendTime;
+	Entry.BlendExponent = BlendExponent;
+
+	// the first mode doesn't have anything to blend from
+	Entry.Alpha = (ModeStack.Num() == 1 || BlendTime <= 0.0f) ? 1.0f : 0.0f;
+}
+
+void AGameCameraManager::SetModeViewTarget(AActor* NewViewTarget)
+{
+	// hand the old target's camera back
+	if (ModeStack.Num() > 0)
+	{
+		SetSpringArmsEnabled(ModeViewTarget.Get(), true);
+	}
+
+	ModeStack.Reset();
+	ModeViewTarget = NewViewTarget;
+
+	// requested modes don't carry over to a new pawn
+	OverrideMode = nullptr;
+}
+
+void AGameCameraManager::SetSpringArmsEnabled(AActor* Actor, bool bEnabled)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	TInlineComponentArray<USpringArmComponent*> SpringArms(Actor);
+
+	for (USpringArmComponent* SpringArm : SpringArms)
+	{
+		SpringArm->SetComponentTickEnabled(bEnabled);
+	}
+}
@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameCameraMode.h"
+#include "GameCameraManager.generated.h"
+
+/**
+ *  A camera mode on the blend stack
+ */
+USTRUCT()
+struct FGameCameraModeStackEntry
+{
+	GENERATED_BODY()
+
+	/** Pooled mode instance */
+	UPROPERTY()
+	TObjectPtr<UGameCameraMode> Mode;
+
+	/** Time to blend in */
+	float BlendTime = 0.0f;
+
+	/** Ease exponent for the blend */
+	float BlendExponent = 1.0f;
+
+	/** Blend progress, from 0 to 1 */
+	float Alpha = 1.0f;
+};
+
+/**
+ *  Player camera manager that computes the view from a stack of camera modes.
+ *  Modes are configured in data assets. They are created once per asset and pooled, and the whole stack
+ *  is evaluated and blended in a single pass without per-frame allocations.
+ *  The pawn's spring arms are disabled while a mode drives the view, since their output would be ignored.
+ *  Without a mode, the camera falls back to the regular view target behavior.
+ */
+UCLASS()
+class AGameCameraManager : public APlayerCameraManager
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Mode used when no other mode is requested */
+	UPROPERTY(EditAnywhere, Category="Camera Modes")
+	TObjectPtr<UGameCameraModeData> DefaultMode;
+
+	/** Maximum number of modes blending at once. The oldest ones are dropped past this */
+	UPROPERTY(EditAnywhere, Category="Camera Modes", meta = (ClampMin = 1, ClampMax = 8))
+	int32 MaxStackDepth = 4;
+
+	/** Mode requested on top of the default mode. Cleared when the view target changes */
+	UPROPERTY(Transient)
+	TObjectPtr<UGameCameraModeData> OverrideMode;
+
+	/** Mode instances, one per data asset */
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UGameCameraModeData>, TObjectPtr<UGameCameraMode>> ModePool;
+
+	/** Mode used when no data asset is set, created by CreateFallbackMode */
+	UPROPERTY(Transient)
+	TObjectPtr<UGameCameraMode> FallbackMode;
+
+	/** Modes currently blending, bottom first */
+	UPROPERTY(Transient)
+	TArray<FGameCameraModeStackEntry> ModeStack;
+
+	/** View target the mode stack was built for */
+	TWeakObjectPtr<AActor> ModeViewTarget;
+
+	/** Last blended view, used to seed newly activated modes */
+	FGameCameraView LastView;
+
+	/** If true, CreateFallbackMode has already been called */
+	bool bFallbackModeCreated = false;
+
+public:
+
+	/** Computes the view from the mode stack */
+	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
+
+	/** Blends to a mode on top of the default mode. Pass nullptr to return to the default mode */
+	UFUNCTION(BlueprintCallable, Category="Camera Modes")
+	void SetCameraMode(UGameCameraModeData* ModeData);
+
+protected:
+
+	/** Creates the mode used when no data asset is set. Returns nullptr to use the regular view target behavior */
+	virtual UGameCameraMode* CreateFallbackMode() { return nullptr; }
+
+	/** Returns the mode that should be on top of the stack */
+	UGameCameraMode* GetRequestedMode(float& OutBlendTime, float& OutBlendExponent);
+
+	/** Returns the pooled instance for a mode asset, creating it the first time */
+	UGameCameraMode* GetPooledMode(UGameCameraModeData* ModeData);
+
+	/** Pushes a mode onto the stack, or moves it to the top if it's already blending */
+	void PushMode(UGameCameraMode* Mode, float BlendTime, float BlendExponent, AActor* ViewTarget);
+
+	/** Switches the stack to a new view target */
+	void SetModeViewTarget(AActor* NewViewTarget);
+
+	/** Enables or disables ticking on the actor's spring arms */
+	static void SetSpringArmsEnabled(AActor* Actor, bool bEnabled);
+};
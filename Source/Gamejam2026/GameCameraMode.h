@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Engine/DataAsset.h"
+#include "GameCameraMode.generated.h"
+
+/**
+ *  Camera view produced by a camera mode
+ */
+struct FGameCameraView
+{
+	/** Camera location */
+	FVector Location = FVector::ZeroVector;
+
+	/** Camera rotation */
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/** Horizontal field of view, in degrees */
+	float FOV = 90.0f;
+
+	/** Blends towards another view by the given weight */
+	void Blend(const FGameCameraView& Other, float Weight)
+	{
+		if (Weight >= 1.0f)
+		{
+			*this = Other;
+			return;
+		}
+
+		Location = FMath::Lerp(Location, Other.Location, Weight);
+		Rotation = FQuat::Slerp(Rotation.Quaternion(), Other.Rotation.Quaternion(), Weight).Rotator();
+		FOV = FMath::Lerp(FOV, Other.FOV, Weight);
+	}
+};
+
+/**
+ *  Base class for camera modes evaluated by AGameCameraManager.
+ *  Modes are configured inline on a UGameCameraModeData asset. The manager creates one instance per asset
+ *  and reuses it every time the mode is activated, so modes can keep their own smoothing state between frames.
+ */
+UCLASS(Abstract, EditInlineNew, DefaultToInstanced)
+class UGameCameraMode : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Horizontal field of view */
+	UPROPERTY(EditAnywhere, Category="Camera", meta = (ClampMin = 5, ClampMax = 170, Units = "deg"))
+	float FieldOfView = 90.0f;
+
+	/** Called when the mode is pushed onto the stack. Resets the smoothing state from the current view */
+	virtual void OnActivated(AActor* ViewTarget, const FGameCameraView& CurrentView) {}
+
+	/** Computes the view for the target */
+	virtual void UpdateView(AActor* ViewTarget, float DeltaTime, FGameCameraView& OutView) {}
+};
+
+/**
+ *  Designer-tunable camera mode.
+ *  Holds the mode's parameters and how the camera blends into it.
+ */
+UCLASS(BlueprintType)
+class UGameCameraModeData : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Mode to evaluate, and its parameters */
+	UPROPERTY(EditAnywhere, Instanced, Category="Camera Mode")
+	TObjectPtr<UGameCameraMode> Mode;
+
+	/** Time to blend into this mode */
+	UPROPERTY(EditAnywhere, Category="Camera Mode", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
+	float BlendTime = 0.5f;
+
+	/** Ease exponent for the blend. 1 is linear */
+	UPROPERTY(EditAnywhere, Category="Camera Mode", meta = (ClampMin = 1, ClampMax = 8))
+	float BlendExponent = 2.0f;
+};
@@ -0,0 +1,385 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "GameCharacterMovementComponent.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+
+bool UGameCharacterMovementComponent::Dash()
+{
+	if (MoveState.bHasDashed || IsDashing())
+	{
+		return false;
+	}
+
+	bWantsToDash = true;
+	return true;
+}
+
+void UGameCharacterMovementComponent::StopDash()
+{
+	bWantsToDash = false;
+	bWantsToStopDash = IsDashing();
+}
+
+bool UGameCharacterMovementComponent::WallJump(const FVector& InputDirection)
+{
+	// wall jumps are only available in the air, once the previous one's lock runs out
+	if (IsMovingOnGround() || IsWallJumping() || IsDashing() || !HasWallContact())
+	{
+		return false;
+	}
+
+	// optionally require the input to point into the wall
+	if (!InputDirection.IsNearlyZero() && FVector::DotProduct(InputDirection, GetWallNormal()) >= 0.0f)
+	{
+		return false;
+	}
+
+	bWantsToWallJump = true;
+	return true;
+}
+
+bool UGameCharacterMovementComponent::HasWallContact() const
+{
+	if (!MoveState.bHasWallHit || MoveState.TimeSinceWallHit > WallHitMaxAge || !CharacterOwner)
+	{
+		return false;
+	}
+
+	// the wall must still be next to the capsule
+	const float Radius = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	const float Gap = FVector::DotProduct(UpdatedComponent->GetComponentLocation() - MoveState.WallImpactPoint, GetWallNormal()) - Radius;
+
+	return Gap <= WallDetectionDistance;
+}
+
+uint8 UGameCharacterMovementComponent::GetMoveRequestFlags() const
+{
+	uint8 Flags = 0;
+
+	if (bWantsToDash)
+	{
+		Flags |= FSavedMove_Character::FLAG_Custom_0;
+	}
+
+	if (bWantsToWallJump)
+	{
+		Flags |= FSavedMove_Character::FLAG_Custom_1;
+	}
+
+	return Flags;
+}
+
+void UGameCharacterMovementComponent::SetMoveRequestFlags(uint8 Flags)
+{
+	bWantsToDash = (Flags & FSavedMove_Character::FLAG_Custom_0) != 0;
+	bWantsToWallJump = (Flags & FSavedMove_Character::FLAG_Custom_1) != 0;
+}
+
+bool UGameCharacterMovementComponent::IsFalling() const
+{
+	// wall slides are falls along the wall, so jumps and air checks keep working while sliding
+	return Super::IsFalling() || IsWallJumping() || IsWallSliding();
+}
+
+void UGameCharacterMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+	Super::UpdateFromCompressedFlags(Flags);
+
+	SetMoveRequestFlags(Flags);
+}
+
+FNetworkPredictionData_Client* UGameCharacterMovementComponent::GetPredictionData_Client() const
+{
+	if (!ClientPredictionData)
+	{
+		UGameCharacterMovementComponent* MutableThis = const_cast<UGameCharacterMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_GameCharacter(*this);
+	}
+
+	return ClientPredictionData;
+}
+
+void UGameCharacterMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	// age the cached wall. It's part of the saved move state, so it replays the same way it was predicted
+	MoveState.TimeSinceWallHit += DeltaSeconds;
+
+	// start a requested dash
+	if (bWantsToDash)
+	{
+		bWantsToDash = false;
+
+		if (!MoveState.bHasDashed && !IsDashing())
+		{
+			MoveState.bHasDashed = true;
+			MoveState.DashTimeRemaining = DashMaxDuration;
+
+			// don't carry momentum into the dash
+			Velocity = FVector::ZeroVector;
+
+			SetMovementMode(MOVE_Custom, static_cast<uint8>(EGameCustomMovementMode::Dash));
+		}
+	}
+
+	// jump off the cached wall
+	if (bWantsToWallJump)
+	{
+		bWantsToWallJump = false;
+
+		if (!IsMovingOnGround() && !IsWallJumping() && !IsDashing() && HasWallContact())
+		{
+			const FVector WallNormal = GetWallNormal();
+
+			Velocity = WallNormal * WallJumpHorizontalSpeed - GetGravityDirection() * WallJumpVerticalSpeed;
+
+			// face away from the wall, so we're oriented for the next wall jump
+			const FRotator WallOrientation(0.0f, WallNormal.Rotation().Yaw, 0.0f);
+			MoveUpdatedComponent(FVector::ZeroVector, WallOrientation, false);
+
+			// the wall has been used
+			MoveState.bHasWallHit = false;
+
+			MoveState.WallJumpTimeRemaining = WallJumpLockTime;
+			SetMovementMode(MOVE_Custom, static_cast<uint8>(EGameCustomMovementMode::WallJump));
+		}
+	}
+
+	// start sliding when falling against a wall we're pushing into
+	if (bCanWallSlide && MovementMode == MOVE_Falling && FVector::DotProduct(Velocity, GetGravityDirection()) > 0.0f && HasWallContact()
+		&& FVector::DotProduct(Acceleration, GetWallNormal()) < 0.0f)
+	{
+		SetMovementMode(MOVE_Custom, static_cast<uint8>(EGameCustomMovementMode::WallSlide));
+	}
+}
+
+void UGameCharacterMovementComponent::PhysCustom(float DeltaTime, int32 Iterations)
+{
+	switch (static_cast<EGameCustomMovementMode>(CustomMovementMode))
+	{
+	case EGameCustomMovementMode::WallSlide:
+		PhysWallSlide(DeltaTime, Iterations);
+		break;
+
+	case EGameCustomMovementMode::WallJump:
+		PhysWallJump(DeltaTime, Iterations);
+		break;
+
+	case EGameCustomMovementMode::Dash:
+		PhysDash(DeltaTime, Iterations);
+		break;
+
+	default:
+		Super::PhysCustom(DeltaTime, Iterations);
+		break;
+	}
+}
+
+void UGameCharacterMovementComponent::HandleImpact(const FHitResult& Hit, float TimeSlice, const FVector& MoveDelta)
+{
+	Super::HandleImpact(Hit, TimeSlice, MoveDelta);
+
+	// remember walls, so wall jumps and slides don't need their own traces
+	if (IsWall(Hit))
+	{
+		MoveState.WallImpactPoint = Hit.ImpactPoint;
+		MoveState.WallImpactNormal = Hit.ImpactNormal;
+		MoveState.TimeSinceWallHit = 0.0f;
+		MoveState.bHasWallHit = true;
+	}
+}
+
+void UGameCharacterMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+	// clear the state of the custom mode we left
+	if (PreviousMovementMode == MOVE_Custom)
+	{
+		switch (static_cast<EGameCustomMovementMode>(PreviousCustomMode))
+		{
+		case EGameCustomMovementMode::WallJump:
+			MoveState.WallJumpTimeRemaining = 0.0f;
+			break;
+
+		case EGameCustomMovementMode::Dash:
+			MoveState.DashTimeRemaining = 0.0f;
+			bWantsToStopDash = false;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	// landing gives the dash back
+	if (IsMovingOnGround())
+	{
+		MoveState.bHasDashed = false;
+	}
+}
+
+void UGameCharacterMovementComponent::PhysWallSlide(float DeltaTime, int32 Iterations)
+{
+	if (DeltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	const FVector WallNormal = GetWallNormal();
+
+	// let go if the wall is gone or the player stopped pushing into it
+	if (!HasWallContact() || FVector::DotProduct(Acceleration, WallNormal) >= 0.0f)
+	{
+		SetMovementMode(MOVE_Falling);
+		StartNewPhysics(DeltaTime, Iterations);
+		return;
+	}
+
+	// fall along the wall, capped at the slide speed
+	const FVector GravityDir = GetGravityDirection();
+	const float FallSpeed = FMath::Min(FVector::DotProduct(Velocity, GravityDir) - GetGravityZ() * DeltaTime, WallSlideMaxSpeed);
+
+	Velocity = FVector::VectorPlaneProject(FVector::VectorPlaneProject(Velocity, GravityDir), WallNormal) + GravityDir * FallSpeed;
+
+	// hug the wall slightly, so the move keeps touching it and refreshes the cached hit
+	const FVector Delta = Velocity * DeltaTime - WallNormal;
+
+	FHitResult Hit;
+	SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+
+	if (Hit.IsValidBlockingHit())
+	{
+		// land on walkable ground
+		if (IsWalkable(Hit) && FVector::DotProduct(Hit.ImpactNormal, GravityDir) < 0.0f)
+		{
+			ProcessLanded(Hit, DeltaTime * (1.0f - Hit.Time), Iterations);
+			return;
+		}
+
+		HandleImpact(Hit, DeltaTime, Delta);
+		SlideAlongSurface(Delta, 1.0f - Hit.Time, Hit.Normal, Hit, true);
+	}
+}
+
+void UGameCharacterMovementComponent::PhysWallJump(float DeltaTime, int32 Iterations)
+{
+	MoveState.WallJumpTimeRemaining -= DeltaTime;
+
+	// give air control back once the lock runs out
+	if (MoveState.WallJumpTimeRemaining <= 0.0f)
+	{
+		SetMovementMode(MOVE_Falling);
+		StartNewPhysics(DeltaTime, Iterations);
+		return;
+	}
+
+	// fall without air control or braking, so the jump keeps its momentum
+	Acceleration = FVector::ZeroVector;
+	PhysFalling(DeltaTime, Iterations);
+}
+
+void UGameCharacterMovementComponent::PhysDash(float DeltaTime, int32 Iterations)
+{
+	if (DeltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	MoveState.DashTimeRemaining -= DeltaTime;
+
+	// fall out of the dash once it's over. Without a max duration, only StopDash ends it.
+	// Landing on the next move gives the dash back
+	if (bWantsToStopDash || (DashMaxDuration > 0.0f && MoveState.DashTimeRemaining <= 0.0f))
+	{
+		SetMovementMode(MOVE_Falling);
+		StartNewPhysics(DeltaTime, Iterations);
+		return;
+	}
+
+	// root motion has already set the velocity for this move
+	if (!HasAnimRootMotion())
+	{
+		Velocity = UpdatedComponent->GetForwardVector() * DashSpeed;
+	}
+
+	// move without gravity
+	const FVector Delta = Velocity * DeltaTime;
+
+	FHitResult Hit;
+	SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+
+	if (Hit.IsValidBlockingHit())
+	{
+		HandleImpact(Hit, DeltaTime, Delta);
+		SlideAlongSurface(Delta, 1.0f - Hit.Time, Hit.Normal, Hit, true);
+	}
+}
+
+FVector UGameCharacterMovementComponent::GetWallNormal() const
+{
+	return FVector::VectorPlaneProject(MoveState.WallImpactNormal, GetGravityDirection()).GetSafeNormal();
+}
+
+bool UGameCharacterMovementComponent::IsWall(const FHitResult& Hit) const
+{
+	return Hit.IsValidBlockingHit() && FMath::Abs(FVector::DotProduct(Hit.ImpactNormal, GetGravityDirection())) <= WallMaxNormalZ;
+}
+
+////////////////////////////////////////////////////////////////////
+// Saved moves
+
+void FSavedMove_GameCharacter::Clear()
+{
+	Super::Clear();
+
+	SavedRequestFlags = 0;
+	SavedMoveState = FGameCharacterMoveState();
+}
+
+uint8 FSavedMove_GameCharacter::GetCompressedFlags() const
+{
+	return Super::GetCompressedFlags() | SavedRequestFlags;
+}
+
+bool FSavedMove_GameCharacter::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	// never merge away a request
+	const FSavedMove_GameCharacter* NewGameMove = static_cast<const FSavedMove_GameCharacter*>(NewMove.Get());
+
+	if (SavedRequestFlags != 0 || NewGameMove->SavedRequestFlags != 0)
+	{
+		return false;
+	}
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FSavedMove_GameCharacter::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+	if (const UGameCharacterMovementComponent* MoveComp = Cast<UGameCharacterMovementComponent>(C->GetCharacterMovement()))
+	{
+		SavedRequestFlags = MoveComp->GetMoveRequestFlags();
+		SavedMoveState = MoveComp->GetMoveState();
+	}
+}
+
+void FSavedMove_GameCharacter::PrepMoveFor(ACharacter* C)
+{
+	Super::PrepMoveFor(C);
+
+	if (UGameCharacterMovementComponent* MoveComp = Cast<UGameCharacterMovementComponent>(C->GetCharacterMovement()))
+	{
+		MoveComp->SetMoveState(SavedMoveState);
+	}
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_GameCharacter::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_GameCharacter());
+}
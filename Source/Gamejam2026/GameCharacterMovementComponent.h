@@ -0,0 +1,245 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameCharacterMovementComponent.generated.h"
+
+/**
+ *  Custom movement modes run by UGameCharacterMovementComponent
+ */
+UENUM(BlueprintType)
+enum class EGameCustomMovementMode : uint8
+{
+	None		UMETA(Hidden),
+	WallSlide	UMETA(DisplayName = "Wall Slide"),
+	WallJump	UMETA(DisplayName = "Wall Jump"),
+	Dash		UMETA(DisplayName = "Dash")
+};
+
+/**
+ *  Movement state that has to be restored when a saved move is replayed
+ */
+struct FGameCharacterMoveState
+{
+	/** Time left in the current dash */
+	float DashTimeRemaining = 0.0f;
+
+	/** Time left before air control comes back after a wall jump */
+	float WallJumpTimeRemaining = 0.0f;
+
+	/** Impact point of the last wall hit */
+	FVector WallImpactPoint = FVector::ZeroVector;
+
+	/** Impact normal of the last wall hit */
+	FVector WallImpactNormal = FVector::ZeroVector;
+
+	/** Time since the wall hit was cached, in movement time */
+	float TimeSinceWallHit = 0.0f;
+
+	/** If true, the character has dashed since it last landed */
+	bool bHasDashed = false;
+
+	/** If true, the wall hit fields hold a wall */
+	bool bHasWallHit = false;
+};
+
+/**
+ *  Character movement shared by the platforming and side scrolling characters.
+ *  Wall slides, wall jumps and dashes are native custom movement modes that run inside the movement tick.
+ *  Wall jump and dash requests travel with the saved moves, so they're predicted and replayed like jumps.
+ *  Walls are detected from the blocking hits of the character's own moves, cached for a short while,
+ *  so no extra traces are needed to find them. The cached wall is part of the replayed move state.
+ */
+UCLASS()
+class UGameCharacterMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	/** If true, the character slides down walls it pushes against while falling */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: Wall Slide")
+	bool bCanWallSlide = true;
+
+	/** Fastest the character can slide down a wall */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: Wall Slide", meta = (ClampMin = 0, ClampMax = 5000, Units = "cm/s", EditCondition = "bCanWallSlide"))
+	float WallSlideMaxSpeed = 300.0f;
+
+	/** Speed away from the wall when wall jumping */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: Wall Jump", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm/s"))
+	float WallJumpHorizontalSpeed = 800.0f;
+
+	/** Vertical speed when wall jumping */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: Wall Jump", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm/s"))
+	float WallJumpVerticalSpeed = 900.0f;
+
+	/** Time without air control after a wall jump, to preserve momentum. Also blocks further jumps */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: Wall Jump", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
+	float WallJumpLockTime = 0.1f;
+
+	/** Largest gap between the capsule and a cached wall that still allows a wall jump */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: Wall Jump", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm"))
+	float WallDetectionDistance = 25.0f;
+
+	/** How long a wall hit stays usable after the last move that touched it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: Wall Jump", meta = (ClampMin = 0, ClampMax = 1, Units = "s"))
+	float WallHitMaxAge = 0.15f;
+
+	/** Highest vertical normal component of a surface that still counts as a wall */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: Wall Jump", meta = (ClampMin = 0, ClampMax = 1))
+	float WallMaxNormalZ = 0.3f;
+
+	/** Dash speed along the character's facing. Zero lets the dash montage's root motion drive the dash */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: Dash", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm/s"))
+	float DashSpeed = 0.0f;
+
+	/** Longest a dash can last. Zero keeps dashing until StopDash is called, e.g. when the dash montage ends */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: Dash", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
+	float DashMaxDuration = 0.0f;
+
+protected:
+
+	/** State restored on replay */
+	FGameCharacterMoveState MoveState;
+
+	/** If true, a dash will start on the next move */
+	bool bWantsToDash = false;
+
+	/** If true, a wall jump will be attempted on the next move */
+	bool bWantsToWallJump = false;
+
+	/** If true, the current dash should end on the next move */
+	bool bWantsToStopDash = false;
+
+public:
+
+	/** Requests a dash. Returns false if the character can't dash right now */
+	bool Dash();
+
+	/** Ends the current dash */
+	void StopDash();
+
+	/**
+	 *  Requests a wall jump off the cached wall. Returns false if there's no wall close enough.
+	 *  If InputDirection isn't zero, the input must also point into the wall.
+	 */
+	bool WallJump(const FVector& InputDirection = FVector::ZeroVector);
+
+	/** Returns true if the character is in the given custom mode */
+	bool IsInCustomMode(EGameCustomMovementMode Mode) const { return MovementMode == MOVE_Custom && CustomMovementMode == static_cast<uint8>(Mode); }
+
+	/** Returns true while dashing */
+	UFUNCTION(BlueprintPure, Category="Character Movement")
+	bool IsDashing() const { return IsInCustomMode(EGameCustomMovementMode::Dash); }
+
+	/** Returns true while the post wall jump lock is active */
+	UFUNCTION(BlueprintPure, Category="Character Movement")
+	bool IsWallJumping() const { return IsInCustomMode(EGameCustomMovementMode::WallJump); }
+
+	/** Returns true while sliding down a wall */
+	UFUNCTION(BlueprintPure, Category="Character Movement")
+	bool IsWallSliding() const { return IsInCustomMode(EGameCustomMovementMode::WallSlide); }
+
+	/** Returns true if the character has dashed since it last landed */
+	UFUNCTION(BlueprintPure, Category="Character Movement")
+	bool HasDashed() const { return MoveState.bHasDashed; }
+
+	/** Returns true if a recent move touched a wall close to the capsule */
+	bool HasWallContact() const;
+
+	/** Returns the replayable movement state */
+	const FGameCharacterMoveState& GetMoveState() const { return MoveState; }
+
+	/** Restores the replayable movement state */
+	void SetMoveState(const FGameCharacterMoveState& InMoveState) { MoveState = InMoveState; }
+
+	/** Returns the pending requests as compressed move flags */
+	virtual uint8 GetMoveRequestFlags() const;
+
+	/** Applies the requests from compressed move flags */
+	virtual void SetMoveRequestFlags(uint8 Flags);
+
+	// ~begin UCharacterMovementComponent interface
+
+	/** Wall slides and the post wall jump arc are still falls. Dashes aren't, since they can start on the ground */
+	virtual bool IsFalling() const override;
+
+	/** Reads the requests from a saved or received move */
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+
+	/** Allocates the saved move data for this component */
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
+	// ~end UCharacterMovementComponent interface
+
+protected:
+
+	// ~begin UCharacterMovementComponent interface
+
+	/** Starts requested dashes and wall jumps, and wall slides */
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+
+	/** Runs the custom modes */
+	virtual void PhysCustom(float DeltaTime, int32 Iterations) override;
+
+	/** Caches wall hits from the character's own moves */
+	virtual void HandleImpact(const FHitResult& Hit, float TimeSlice = 0.0f, const FVector& MoveDelta = FVector::ZeroVector) override;
+
+	/** Resets the dash when landing, and clears custom mode state when leaving a mode */
+	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+
+	// ~end UCharacterMovementComponent interface
+
+	/** Slides down the cached wall */
+	void PhysWallSlide(float DeltaTime, int32 Iterations);
+
+	/** Falls without air control until the wall jump lock runs out */
+	void PhysWallJump(float DeltaTime, int32 Iterations);
+
+	/** Moves without gravity until the dash ends */
+	void PhysDash(float DeltaTime, int32 Iterations);
+
+	/** Returns the cached wall normal, flattened against gravity */
+	FVector GetWallNormal() const;
+
+	/** Returns true if the surface counts as a wall */
+	bool IsWall(const FHitResult& Hit) const;
+};
+
+/**
+ *  Saved move that carries the wall jump and dash requests
+ */
+class FSavedMove_GameCharacter : public FSavedMove_Character
+{
+	typedef FSavedMove_Character Super;
+
+public:
+
+	/** Pending requests, as compressed move flags */
+	uint8 SavedRequestFlags = 0;
+
+	/** Movement state at the start of the move */
+	FGameCharacterMoveState SavedMoveState;
+
+	virtual void Clear() override;
+	virtual uint8 GetCompressedFlags() const override;
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
+	virtual void PrepMoveFor(ACharacter* C) override;
+};
+
+/**
+ *  Client prediction data that allocates FSavedMove_GameCharacter
+ */
+class FNetworkPredictionData_Client_GameCharacter : public FNetworkPredictionData_Client_Character
+{
+	typedef FNetworkPredictionData_Client_Character Super;
+
+public:
+
+	FNetworkPredictionData_Client_GameCharacter(const UCharacterMovementComponent& ClientMovement) : Super(ClientMovement) {}
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
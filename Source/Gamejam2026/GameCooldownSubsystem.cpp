@@ -0,0 +1,254 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "GameCooldownSubsystem.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Gamejam2026.h"
+
+DECLARE_CYCLE_STAT(TEXT("Game Cooldowns"), STAT_GameCooldowns, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Game Cooldowns Pending"), STAT_GameCooldownsPending, STATGROUP_Game);
+
+static FAutoConsoleCommandWithWorld GameCooldownStatsCommand(
+	TEXT("Game.Cooldowns.Stats"),
+	TEXT("Logs the pending cooldowns and poll cost, followed by the timer manager's active timers"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UGameCooldownSubsystem* Cooldowns = World ? World->GetSubsystem<UGameCooldownSubsystem>() : nullptr)
+		{
+			Cooldowns->DumpStats();
+		}
+	})
+);
+
+void UGameCooldownSubsystem::SetCooldown(FGameCooldownHandle& Handle, float Duration, FSimpleDelegate OnExpired)
+{
+	// match SetTimer, which clears the timer for non-positive rates
+	if (Duration <= 0.0f)
+	{
+		ClearCooldown(Handle);
+		return;
+	}
+
+	const double Deadline = GetNow() + Duration;
+
+	// restart the cooldown in place if it's still pending
+	const int32 Index = FindCooldown(Handle.Id);
+
+	if (Index != INDEX_NONE)
+	{
+		FCooldown& Cooldown = Cooldowns[Index];
+		const bool bWasEarliest = Cooldown.Deadline <= NextDeadline;
+
+		Cooldown.Deadline = Deadline;
+		Cooldown.OnExpired = MoveTemp(OnExpired);
+
+		// pushing back the earliest deadline means another cooldown may be first now
+		if (bWasEarliest)
+		{
+			UpdateNextDeadline();
+		}
+		else
+		{
+			NextDeadline = FMath::Min(NextDeadline, Deadline);
+		}
+
+		return;
+	}
+
+	// don't let a callback that's about to fire in this batch run after being restarted
+	ClearCooldown(Handle);
+
+	Handle.Id = NextId++;
+
+	FCooldown& Cooldown = Cooldowns.AddDefaulted_GetRef();
+	Cooldown.Deadline = Deadline;
+	Cooldown.Id = Handle.Id;
+	Cooldown.OnExpired = MoveTemp(OnExpired);
+
+	PeakCooldowns = FMath::Max(PeakCooldowns, Cooldowns.Num());
+
+	// wake up the poll
+	NextDeadline = FMath::Min(NextDeadline, Deadline);
+	PollTickFunction.SetTickFunctionEnable(true);
+}
+
+void UGameCooldownSubsystem::ClearCooldown(FGameCooldownHandle& Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	const int32 Index = FindCooldown(Handle.Id);
+
+	if (Index != INDEX_NONE)
+	{
+		const bool bWasEarliest = Cooldowns[Index].Deadline <= NextDeadline;
+
+		Cooldowns.RemoveAtSwap(Index, EAllowShrinking::No);
+
+		if (bWasEarliest)
+		{
+			UpdateNextDeadline();
+		}
+
+	} else {
+
+		// the cooldown may have expired this frame without firing yet
+		for (FCooldown& Expired : ExpiredBatch)
+		{
+			if (Expired.Id == Handle.Id)
+			{
+				Expired.OnExpired.Unbind();
+				break;
+			}
+		}
+	}
+
+	Handle.Invalidate();
+}
+
+bool UGameCooldownSubsystem::IsCoolingDown(const FGameCooldownHandle& Handle) const
+{
+	return GetRemainingTime(Handle) > 0.0f;
+}
+
+float UGameCooldownSubsystem::GetRemainingTime(const FGameCooldownHandle& Handle) const
+{
+	// compare against the clock instead of waiting for the poll, so queries are exact mid-frame
+	const int32 Index = FindCooldown(Handle.Id);
+
+	return Index != INDEX_NONE ? FMath::Max(static_cast<float>(Cooldowns[Index].Deadline - GetNow()), 0.0f) : 0.0f;
+}
+
+void UGameCooldownSubsystem::DumpStats() const
+{
+	UE_LOG(LogGamejam2026, Log, TEXT("Game cooldowns: %d pending (peak %d, %.1f KB), %d expired"),
+		Cooldowns.Num(), PeakCooldowns, Cooldowns.GetAllocatedSize() / 1024.0f, NumExpired);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Game cooldowns: last poll %.4f ms, average poll %.4f ms over %d frames, peak poll %.4f ms"),
+		LastPollMs, NumPolls > 0 ? TotalPollMs / NumPolls : 0.0, NumPolls, PeakPollMs);
+
+	// every pending cooldown would otherwise be one more entry in the timer manager's heap.
+	// "stat Game" shows the heap size and timer tick cost next to our pending count and poll cost, so list the remaining timers too
+	UE_LOG(LogGamejam2026, Log, TEXT("Game cooldowns: %d timer manager heap entries avoided right now, %d at peak"),
+		Cooldowns.Num(), PeakCooldowns);
+
+	GetWorld()->GetTimerManager().ListTimers();
+}
+
+bool UGameCooldownSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGameCooldownSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// poll early in the frame, so expired gameplay windows close before anything moves
+	PollTickFunction.OnTick.BindUObject(this, &UGameCooldownSubsystem::PollCooldowns);
+	PollTickFunction.Register(&InWorld, TG_PrePhysics, false, TEXT("GameCooldowns"));
+
+	// only tick while cooldowns are pending
+	PollTickFunction.SetTickFunctionEnable(Cooldowns.Num() > 0);
+}
+
+void UGameCooldownSubsystem::Deinitialize()
+{
+	PollTickFunction.Unregister();
+
+	Cooldowns.Empty();
+	ExpiredBatch.Empty();
+
+	Super::Deinitialize();
+}
+
+void UGameCooldownSubsystem::PollCooldowns(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GameCooldowns);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const double Now = GetNow();
+
+	// nothing to do until the earliest deadline passes
+	if (Now >= NextDeadline)
+	{
+		// pull every expired cooldown out of the list before firing, so callbacks can safely start new ones
+		ExpiredBatch.Reset();
+
+		for (int32 i = Cooldowns.Num() - 1; i >= 0; --i)
+		{
+			if (Cooldowns[i].Deadline <= Now)
+			{
+				ExpiredBatch.Add(MoveTemp(Cooldowns[i]));
+				Cooldowns.RemoveAtSwap(i, EAllowShrinking::No);
+			}
+		}
+
+		UpdateNextDeadline();
+
+		// fire in deadline order, then in start order, so results don't depend on the list layout
+		ExpiredBatch.Sort([](const FCooldown& A, const FCooldown& B)
+		{
+			return A.Deadline != B.Deadline ? A.Deadline < B.Deadline : A.Id < B.Id;
+		});
+
+		NumExpired += ExpiredBatch.Num();
+
+		for (int32 i = 0; i < ExpiredBatch.Num(); ++i)
+		{
+			// copy the delegate, since the callback may clear its own handle and unbind the original mid-call
+			const FSimpleDelegate OnExpired = ExpiredBatch[i].OnExpired;
+			OnExpired.ExecuteIfBound();
+		}
+
+		ExpiredBatch.Reset();
+	}
+
+	LastPollMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	PeakPollMs = FMath::Max(PeakPollMs, LastPollMs);
+	TotalPollMs += LastPollMs;
+	++NumPolls;
+
+	SET_DWORD_STAT(STAT_GameCooldownsPending, Cooldowns.Num());
+}
+
+int32 UGameCooldownSubsystem::FindCooldown(uint64 Id) const
+{
+	if (Id == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// the list only holds a few dozen entries, so a linear scan beats hashing
+	return Cooldowns.IndexOfByPredicate([Id](const FCooldown& Cooldown)
+	{
+		return Cooldown.Id == Id;
+	});
+}
+
+void UGameCooldownSubsystem::UpdateNextDeadline()
+{
+	NextDeadline = TNumericLimits<double>::Max();
+
+	for (const FCooldown& Cooldown : Cooldowns)
+	{
+		NextDeadline = FMath::Min(NextDeadline, Cooldown.Deadline);
+	}
+
+	// go back to sleep once nothing is pending
+	if (Cooldowns.Num() == 0)
+	{
+		PollTickFunction.SetTickFunctionEnable(false);
+	}
+}
+
+double UGameCooldownSubsystem::GetNow() const
+{
+	// game time, so cooldowns pause and dilate like timers do
+	return GetWorld()->GetTimeSeconds();
+}
@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameWorldTickFunction.h"
+#include "GameCooldownSubsystem.generated.h"
+
+/**
+ *  Identifies a cooldown started through UGameCooldownSubsystem.
+ *  Stale handles are harmless: they simply stop matching once the cooldown expires or is cleared.
+ */
+struct FGameCooldownHandle
+{
+	/** Unique id of the cooldown, or zero if the handle was never set */
+	uint64 Id = 0;
+
+	/** Returns true if the handle was ever set */
+	bool IsValid() const { return Id != 0; }
+
+	/** Resets the handle */
+	void Invalidate() { Id = 0; }
+};
+
+/**
+ *  Lightweight replacement for one-shot gameplay timers.
+ *  Cooldowns are world time deadlines kept in a small flat array. Queries compare the deadline
+ *  against the world time directly, so they're always up to date. Expiry callbacks are polled once per frame
+ *  against the earliest deadline and fired in a single batch, in deadline order.
+ *  Callbacks bound to an object are skipped once it's destroyed, so owners don't need EndPlay cleanup.
+ */
+UCLASS()
+class UGameCooldownSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** A single pending cooldown */
+	struct FCooldown
+	{
+		/** World time the cooldown expires at */
+		double Deadline = 0.0;
+
+		/** Handle id */
+		uint64 Id = 0;
+
+		/** Called when the cooldown expires */
+		FSimpleDelegate OnExpired;
+	};
+
+	/** Pending cooldowns, unordered */
+	TArray<FCooldown> Cooldowns;
+
+	/** Cooldowns being fired this frame */
+	TArray<FCooldown> ExpiredBatch;
+
+	/** Earliest deadline in the pending list */
+	double NextDeadline = TNumericLimits<double>::Max();
+
+	/** Id handed out to the next cooldown */
+	uint64 NextId = 1;
+
+	/** Largest number of pending cooldowns seen */
+	int32 PeakCooldowns = 0;
+
+	/** Number of cooldowns that have expired since the world started */
+	int32 NumExpired = 0;
+
+	/** Cost of the last frame's poll, in milliseconds */
+	double LastPollMs = 0.0;
+
+	/** Most expensive poll, in milliseconds */
+	double PeakPollMs = 0.0;
+
+	/** Cost of all polls since the world started, in milliseconds */
+	double TotalPollMs = 0.0;
+
+	/** Number of frames the poll has run */
+	int32 NumPolls = 0;
+
+	/** Tick function that polls for expired cooldowns */
+	FGameWorldTickFunction PollTickFunction;
+
+public:
+
+	/**
+	 *  Starts a cooldown, or restarts it if the handle is still pending. OnExpired runs once the duration has passed.
+	 *  A duration of zero or less clears the cooldown without firing it.
+	 */
+	void SetCooldown(FGameCooldownHandle& Handle, float Duration, FSimpleDelegate OnExpired = FSimpleDelegate());
+
+	/** Cancels the cooldown without firing it, and invalidates the handle */
+	void ClearCooldown(FGameCooldownHandle& Handle);
+
+	/** Returns true if the cooldown hasn't expired yet */
+	bool IsCoolingDown(const FGameCooldownHandle& Handle) const;
+
+	/** Returns the time left on the cooldown, or zero if it has expired */
+	float GetRemainingTime(const FGameCooldownHandle& Handle) const;
+
+	/** Writes the cooldown counts and last, average and peak poll cost to the log, along with the world's timer manager for comparison */
+	void DumpStats() const;
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the poll tick */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Fires the cooldowns whose deadline has passed */
+	void PollCooldowns(float DeltaTime);
+
+	/** Returns the index of the pending cooldown with the id, or INDEX_NONE */
+	int32 FindCooldown(uint64 Id) const;
+
+	/** Recomputes the earliest deadline and puts the poll to sleep if nothing is pending */
+	void UpdateNextDeadline();
+
+	/** Returns the current world time */
+	double GetNow() const;
+};
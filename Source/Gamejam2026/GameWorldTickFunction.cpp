@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "GameWorldTickFunction.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+
+void FGameWorldTickFunction::Register(UWorld* World, ETickingGroup Group, bool bHighPriority, FName InDebugName)
+{
+	// ensure we have a level to register with
+	if (!World || !World->PersistentLevel || IsTickFunctionRegistered())
+	{
+		return;
+	}
+
+	DebugName = InDebugName;
+
+	// run once per frame in the requested tick group
+	bCanEverTick = true;
+	bStartWithTickEnabled = true;
+	bTickEvenWhenPaused = false;
+	TickGroup = Group;
+	EndTickGroup = Group;
+
+	SetPriorityIncludingPrerequisites(bHighPriority);
+
+	RegisterTickFunction(World->PersistentLevel);
+}
+
+void FGameWorldTickFunction::Unregister()
+{
+	if (IsTickFunctionRegistered())
+	{
+		UnRegisterTickFunction();
+	}
+
+	OnTick.Unbind();
+}
+
+void FGameWorldTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	// only run while the game is actually ticking
+	if (TickType != LEVELTICK_ViewportsOnly)
+	{
+		OnTick.ExecuteIfBound(DeltaTime);
+	}
+}
+
+FString FGameWorldTickFunction::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("FGameWorldTickFunction[%s]"), *DebugName.ToString());
+}
+
+FName FGameWorldTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return DebugName;
+}
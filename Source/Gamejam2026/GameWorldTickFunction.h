@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "GameWorldTickFunction.generated.h"
+
+/** Delegate called when a game world tick function runs */
+DECLARE_DELEGATE_OneParam(FOnGameWorldTick, float /* DeltaTime */);
+
+/**
+ *  Tick function that lets a world subsystem run its batched work at a well-defined tick group
+ */
+USTRUCT()
+struct FGameWorldTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	/** Called every time the tick function runs */
+	FOnGameWorldTick OnTick;
+
+	/** Name reported in tick diagnostics */
+	FName DebugName;
+
+	/** Sets up the tick group and priority, and registers with the world's persistent level */
+	void Register(UWorld* World, ETickingGroup Group, bool bHighPriority, FName InDebugName);
+
+	/** Unregisters the tick function and clears the delegate */
+	void Unregister();
+
+	// ~begin FTickFunction interface
+
+	/** Runs the tick delegate */
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	/** Returns the tick diagnostic message */
+	virtual FString DiagnosticMessage() override;
+
+	/** Returns the tick diagnostic context */
+	virtual FName DiagnosticContext(bool bDetailed) override;
+
+	// ~end FTickFunction interface
+};
+
+template<>
+struct TStructOpsTypeTraits<FGameWorldTickFunction> : public TStructOpsTypeTraitsBase2<FGameWorldTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
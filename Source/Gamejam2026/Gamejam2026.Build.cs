@@ -21,7 +21,7 @@ public class Gamejam2026 : ModuleRules
 			"Slate"
 		});
 
-		PrivateDependencyModuleNames.AddRange(new string[] { });
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json", "SlateCore" });
 
 		PublicIncludePaths.AddRange(new string[] {
 			"Gamejam2026",
@@ -32,6 +32,7 @@ public class Gamejam2026 : ModuleRules
 			"Gamejam2026/Variant_Combat/Animation",
 			"Gamejam2026/Variant_Combat/Gameplay",
 			"Gamejam2026/Variant_Combat/Interfaces",
+			"Gamejam2026/Variant_Combat/Subsystems",
 			"Gamejam2026/Variant_Combat/UI",
 			"Gamejam2026/Variant_SideScrolling",
 			"Gamejam2026/Variant_SideScrolling/AI",
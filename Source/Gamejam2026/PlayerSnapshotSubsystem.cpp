@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "PlayerSnapshotSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/GameplayStatics.h"
+
+const FPlayerSnapshot& UPlayerSnapshotSubsystem::GetSnapshot()
+{
+	// capture the snapshot on the first access of the frame
+	if (SnapshotFrame != GFrameCounter)
+	{
+		SnapshotFrame = GFrameCounter;
+		CaptureSnapshot();
+	}
+
+	return Snapshot;
+}
+
+const FPlayerSnapshot* UPlayerSnapshotSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+
+	if (UPlayerSnapshotSubsystem* Subsystem = World ? World->GetSubsystem<UPlayerSnapshotSubsystem>() : nullptr)
+	{
+		return &Subsystem->GetSnapshot();
+	}
+
+	return nullptr;
+}
+
+bool UPlayerSnapshotSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPlayerSnapshotSubsystem::CaptureSnapshot()
+{
+	// get the pawn possessed by the first local player
+	Snapshot.Pawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	Snapshot.Character = Cast<ACharacter>(Snapshot.Pawn);
+
+	if (Snapshot.Pawn)
+	{
+		Snapshot.Location = Snapshot.Pawn->GetActorLocation();
+		Snapshot.Velocity = Snapshot.Pawn->GetVelocity();
+		Snapshot.bIsGrounded = Snapshot.Character && Snapshot.Character->GetCharacterMovement()->IsMovingOnGround();
+	}
+	else
+	{
+		// keep the last known location, but clear the motion state
+		Snapshot.Velocity = FVector::ZeroVector;
+		Snapshot.bIsGrounded = false;
+	}
+}
@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PlayerSnapshotSubsystem.generated.h"
+
+class APawn;
+class ACharacter;
+
+/**
+ *  State of the first local player's pawn, captured once per frame
+ */
+USTRUCT(BlueprintType)
+struct FPlayerSnapshot
+{
+	GENERATED_BODY()
+
+	/** Pawn possessed by the first local player */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Player")
+	TObjectPtr<APawn> Pawn;
+
+	/** Pawn cast to a character, if applicable */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Player")
+	TObjectPtr<ACharacter> Character;
+
+	/** Pawn location */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Player")
+	FVector Location = FVector::ZeroVector;
+
+	/** Pawn velocity */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Player")
+	FVector Velocity = FVector::ZeroVector;
+
+	/** If true, the pawn is a character walking on the ground */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Player")
+	bool bIsGrounded = false;
+
+	/** Returns true if the snapshot holds a valid pawn */
+	bool IsValid() const { return Pawn != nullptr; }
+
+	/** Returns the squared distance from the given location to the player */
+	double DistSquaredTo(const FVector& From) const { return FVector::DistSquared(From, Location); }
+};
+
+/**
+ *  Shares a single per-frame snapshot of the player pawn across all AI agents,
+ *  so StateTree tasks and EQS contexts don't each look up the player and read its components.
+ *  The snapshot is captured on the first access of each frame.
+ */
+UCLASS()
+class UPlayerSnapshotSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Cached snapshot */
+	UPROPERTY()
+	FPlayerSnapshot Snapshot;
+
+	/** Frame number the snapshot was captured on */
+	uint64 SnapshotFrame = MAX_uint64;
+
+public:
+
+	/** Returns this frame's player snapshot, capturing it if needed */
+	const FPlayerSnapshot& GetSnapshot();
+
+	/** Returns this frame's player snapshot for the world the context object lives in. Returns nullptr if unavailable */
+	static const FPlayerSnapshot* Get(const UObject* WorldContextObject);
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Reads the player pawn's state into the snapshot */
+	void CaptureSnapshot();
+};
@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "Public/GravityFieldComponent.h"
+#include "Public/GravityFieldSubsystem.h"
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+
+UGravityFieldComponent::UGravityFieldComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+float UGravityFieldComponent::SampleField(const FVector& Location, FVector& OutDirection) const
+{
+	const FVector Center = GetComponentLocation();
+
+	// distance inside the field's edge. Negative when outside
+	float EdgeDistance = -1.0f;
+
+	switch (Shape)
+	{
+	case EGravityFieldShape::Point:
+	case EGravityFieldShape::SphericalShell:
+	{
+		const FVector ToCenter = Center - Location;
+		const float Distance = ToCenter.Size();
+
+		if (Distance < UE_KINDA_SMALL_NUMBER)
+		{
+			return 0.0f;
+		}
+
+		EdgeDistance = Radius - Distance;
+
+		if (Shape == EGravityFieldShape::SphericalShell)
+		{
+			EdgeDistance = FMath::Min(EdgeDistance, Distance - InnerRadius);
+		}
+
+		OutDirection = ToCenter / Distance;
+		break;
+	}
+
+	case EGravityFieldShape::Box:
+	{
+		const FVector LocalLocation = GetComponentTransform().InverseTransformPositionNoScale(Location);
+
+		EdgeDistance = FMath::Min3(
+			BoxExtent.X - FMath::Abs(LocalLocation.X),
+			BoxExtent.Y - FMath::Abs(LocalLocation.Y),
+			BoxExtent.Z - FMath::Abs(LocalLocation.Z));
+
+		OutDirection = -GetUpVector();
+		break;
+	}
+
+	case EGravityFieldShape::Spline:
+	{
+		if (!Spline)
+		{
+			return 0.0f;
+		}
+
+		const float InputKey = Spline->FindInputKeyClosestToWorldLocation(Location);
+		const FVector ToSpline = Spline->GetLocationAtSplineInputKey(InputKey, ESplineCoordinateSpace::World) - Location;
+		const float Distance = ToSpline.Size();
+
+		EdgeDistance = Radius - Distance;
+
+		// on the spline itself, fall back to the spline's down vector
+		OutDirection = Distance > UE_KINDA_SMALL_NUMBER ? ToSpline / Distance : -Spline->GetUpVectorAtSplineInputKey(InputKey, ESplineCoordinateSpace::World);
+		break;
+	}
+	}
+
+	if (EdgeDistance <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	if (bInvertDirection)
+	{
+		OutDirection = -OutDirection;
+	}
+
+	// fade the weight in from the edge
+	const float EdgeBlend = BlendDistance > 0.0f ? FMath::Min(EdgeDistance / BlendDistance, 1.0f) : 1.0f;
+
+	return Weight * EdgeBlend;
+}
+
+FBox UGravityFieldComponent::GetFieldBounds() const
+{
+	switch (Shape)
+	{
+	case EGravityFieldShape::Box:
+		return FBox(-BoxExtent, BoxExtent).TransformBy(FTransform(GetComponentQuat(), GetComponentLocation()));
+
+	case EGravityFieldShape::Spline:
+		return Spline ? Spline->Bounds.GetBox().ExpandBy(Radius) : FBox(ForceInit);
+
+	default:
+		return FBox::BuildAABB(GetComponentLocation(), FVector(Radius));
+	}
+}
+
+void UGravityFieldComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// spline fields use the spline we're attached to, or the first one on the owner
+	if (Shape == EGravityFieldShape::Spline)
+	{
+		Spline = Cast<USplineComponent>(GetAttachParent());
+
+		if (!Spline && GetOwner())
+		{
+			Spline = GetOwner()->FindComponentByClass<USplineComponent>();
+		}
+	}
+
+	if (UGravityFieldSubsystem* GravityFields = GetWorld() ? GetWorld()->GetSubsystem<UGravityFieldSubsystem>() : nullptr)
+	{
+		GravityFields->RegisterField(this);
+	}
+}
+
+void UGravityFieldComponent::OnUnregister()
+{
+	if (UGravityFieldSubsystem* GravityFields = GetWorld() ? GetWorld()->GetSubsystem<UGravityFieldSubsystem>() : nullptr)
+	{
+		GravityFields->UnregisterField(this);
+	}
+
+	Super::OnUnregister();
+}
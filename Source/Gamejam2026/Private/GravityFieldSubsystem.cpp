@@ -0,0 +1,437 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "Public/GravityFieldSubsystem.h"
+#include "Public/GravityFieldComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Gamejam2026.h"
+
+static bool GGravityFieldEnabled = true;
+static FAutoConsoleVariableRef CVarGravityFieldEnabled(
+	TEXT("Gravity.Field.Enabled"),
+	GGravityFieldEnabled,
+	TEXT("If false, gravity fields stop updating character gravity"),
+	ECVF_Default
+);
+
+static float GGravityFieldCellSize = 100.0f;
+static FAutoConsoleVariableRef CVarGravityFieldCellSize(
+	TEXT("Gravity.Field.CellSize"),
+	GGravityFieldCellSize,
+	TEXT("Size of the cells static gravity fields are baked into, in cm"),
+	ECVF_Default
+);
+
+static int32 GGravityFieldMaxCells = 262144;
+static FAutoConsoleVariableRef CVarGravityFieldMaxCells(
+	TEXT("Gravity.Field.MaxCells"),
+	GGravityFieldMaxCells,
+	TEXT("Maximum number of baked gravity cells. Locations past the budget evaluate the static fields directly"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithWorld GravityFieldStatsCommand(
+	TEXT("Gravity.Field.Stats"),
+	TEXT("Logs the gravity field grid size and the cost of the last character pass"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UGravityFieldSubsystem* GravityFields = World ? World->GetSubsystem<UGravityFieldSubsystem>() : nullptr)
+		{
+			GravityFields->DumpStats();
+		}
+	})
+);
+
+namespace
+{
+	/** Accumulates gravity tiers from highest to lowest priority. Each tier only fills the weight left by the ones above it */
+	struct FGravityBlend
+	{
+		FVector Direction = FVector::ZeroVector;
+		float Remaining = 1.0f;
+
+		void AddTier(const FVector& TierDirection, float TierWeight)
+		{
+			const float Applied = FMath::Min(TierWeight, 1.0f) * Remaining;
+			Direction += TierDirection.GetSafeNormal() * Applied;
+			Remaining -= Applied;
+		}
+	};
+
+	/** Samples a priority sorted list of fields, calling OnTier with the weighted direction and total weight of each priority */
+	template<typename TOnTier>
+	void SampleTiers(const TArray<TObjectPtr<UGravityFieldComponent>>& Fields, const FVector& Location, TOnTier&& OnTier)
+	{
+		int32 TierStart = 0;
+
+		while (TierStart < Fields.Num())
+		{
+			const int32 TierPriority = Fields[TierStart]->Priority;
+
+			FVector TierDirection = FVector::ZeroVector;
+			float TierWeight = 0.0f;
+
+			int32 FieldIndex = TierStart;
+
+			for (; FieldIndex < Fields.Num() && Fields[FieldIndex]->Priority == TierPriority; ++FieldIndex)
+			{
+				FVector FieldDirection;
+				const float FieldWeight = Fields[FieldIndex]->SampleField(Location, FieldDirection);
+
+				if (FieldWeight > 0.0f)
+				{
+					TierDirection += FieldDirection * FieldWeight;
+					TierWeight += FieldWeight;
+				}
+			}
+
+			if (TierWeight > 0.0f)
+			{
+				OnTier(TierPriority, TierDirection, TierWeight);
+			}
+
+			TierStart = FieldIndex;
+		}
+	}
+
+	/** Inserts a field keeping the list sorted by descending priority */
+	void InsertByPriority(TArray<TObjectPtr<UGravityFieldComponent>>& Fields, UGravityFieldComponent* Field)
+	{
+		const int32 Index = Fields.IndexOfByPredicate([Field](const UGravityFieldComponent* Other) { return Other->Priority < Field->Priority; });
+		Fields.Insert(Field, Index == INDEX_NONE ? Fields.Num() : Index);
+	}
+}
+
+void UGravityFieldSubsystem::RegisterField(UGravityFieldComponent* Field)
+{
+	if (!Field || BakedFields.Contains(Field) || DynamicFields.Contains(Field))
+	{
+		return;
+	}
+
+	if (Field->IsBaked())
+	{
+		InsertByPriority(BakedFields, Field);
+		bGridDirty = true;
+	}
+	else
+	{
+		InsertByPriority(DynamicFields, Field);
+	}
+}
+
+void UGravityFieldSubsystem::UnregisterField(UGravityFieldComponent* Field)
+{
+	if (BakedFields.Remove(Field) > 0)
+	{
+		bGridDirty = true;
+	}
+
+	DynamicFields.Remove(Field);
+}
+
+FVector UGravityFieldSubsystem::GetGravityDirection(const FVector& Location)
+{
+	// get the pre-blended static fields
+	const FGravityFieldCell* Cell = nullptr;
+	FGravityFieldCell GridCell;
+
+	if (BakedFields.Num() > 0)
+	{
+		GridCell = SampleGrid(Location);
+		Cell = &GridCell;
+	}
+
+	bool bCellPending = Cell && Cell->Coverage > 0.0f;
+
+	// blend the movable fields, slotting the baked cell in at its priority
+	FGravityBlend Blend;
+
+	SampleTiers(DynamicFields, Location, [&](int32 TierPriority, const FVector& TierDirection, float TierWeight)
+	{
+		if (bCellPending && Cell->Priority >= TierPriority)
+		{
+			Blend.AddTier(FVector(Cell->Direction), Cell->Coverage);
+			bCellPending = false;
+		}
+
+		Blend.AddTier(TierDirection, TierWeight);
+	});
+
+	if (bCellPending)
+	{
+		Blend.AddTier(FVector(Cell->Direction), Cell->Coverage);
+	}
+
+	// anything not covered by a field falls back to regular gravity
+	Blend.AddTier(FVector::DownVector, 1.0f);
+
+	return Blend.Direction.GetSafeNormal(UE_SMALL_NUMBER, FVector::DownVector);
+}
+
+void UGravityFieldSubsystem::DumpStats() const
+{
+	UE_LOG(LogGamejam2026, Log, TEXT("Gravity fields: %d baked, %d movable, %d baked cells (%.1f KB)"),
+		BakedFields.Num(), DynamicFields.Num(), Stats.BakedCells, (Cells.GetAllocatedSize() + CellLookup.GetAllocatedSize()) / 1024.0f);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Gravity fields: %d characters, %d direction changes, %d cell misses, %.3f ms last pass"),
+		Stats.Characters, Stats.DirectionChanges, Stats.CellMisses, Stats.PassTimeMs);
+}
+
+bool UGravityFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGravityFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// collect the characters already in the level, and any spawned later
+	for (TActorIterator<ACharacter> It(&InWorld); It; ++It)
+	{
+		OnActorSpawned(*It);
+	}
+
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UGravityFieldSubsystem::OnActorSpawned));
+
+	// update gravity before the movement components tick
+	ApplyTickFunction.OnTick.BindUObject(this, &UGravityFieldSubsystem::ApplyGravity);
+	ApplyTickFunction.Register(&InWorld, TG_PrePhysics, true, TEXT("GravityFields"));
+}
+
+void UGravityFieldSubsystem::Deinitialize()
+{
+	ApplyTickFunction.Unregister();
+
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+
+	MovementComponents.Empty();
+	CellLookup.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+void UGravityFieldSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (ACharacter* Character = Cast<ACharacter>(Actor))
+	{
+		if (UCharacterMovementComponent* MoveComp = Character->GetCharacterMovement())
+		{
+			MovementComponents.AddUnique(MoveComp);
+		}
+	}
+}
+
+void UGravityFieldSubsystem::ApplyGravity(float DeltaTime)
+{
+	const bool bHasFields = BakedFields.Num() > 0 || DynamicFields.Num() > 0;
+
+	// leave gravity alone in levels without fields
+	if (!GGravityFieldEnabled || (!bHasFields && !bDrivingGravity))
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Stats.DirectionChanges = 0;
+	Stats.CellMisses = 0;
+
+	// drop destroyed characters
+	MovementComponents.RemoveAllSwap([](const TWeakObjectPtr<UCharacterMovementComponent>& MoveComp) { return !MoveComp.IsValid(); }, EAllowShrinking::No);
+
+	// gather the locations first so the sampling loop only touches the field data
+	PassLocations.Reset(MovementComponents.Num());
+
+	for (const TWeakObjectPtr<UCharacterMovementComponent>& MoveComp : MovementComponents)
+	{
+		PassLocations.Add(MoveComp->GetOwner()->GetActorLocation());
+	}
+
+	for (int32 i = 0; i < MovementComponents.Num(); ++i)
+	{
+		UCharacterMovementComponent* MoveComp = MovementComponents[i].Get();
+
+		const FVector NewDirection = bHasFields ? GetGravityDirection(PassLocations[i]) : FVector::DownVector;
+
+		// only touch the movement component if gravity actually changed
+		if (!NewDirection.Equals(MoveComp->GetGravityDirection(), 1e-4f))
+		{
+			MoveComp->SetGravityDirection(NewDirection);
+			++Stats.DirectionChanges;
+		}
+	}
+
+	bDrivingGravity = bHasFields;
+
+	Stats.Characters = MovementComponents.Num();
+	Stats.BakedCells = Cells.Num();
+	Stats.PassTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void UGravityFieldSubsystem::RebuildGrid()
+{
+	bGridDirty = false;
+	BakedCellSize = FMath::Max(GGravityFieldCellSize, 1.0f);
+
+	CellLookup.Reset();
+	Cells.Reset();
+
+	// bake every cell covered by a baked field, as long as it fits in the budget. Anything else bakes on demand
+	for (const UGravityFieldComponent* Field : BakedFields)
+	{
+		const FBox Bounds = Field->GetFieldBounds();
+
+		if (!Bounds.IsValid)
+		{
+			continue;
+		}
+
+		const FIntVector Min = GetCellKey(Bounds.Min);
+		const FIntVector Max = GetCellKey(Bounds.Max);
+		const int64 NumCells = int64(Max.X - Min.X + 1) * int64(Max.Y - Min.Y + 1) * int64(Max.Z - Min.Z + 1);
+
+		if (Cells.Num() + NumCells > GGravityFieldMaxCells)
+		{
+			UE_LOG(LogGamejam2026, Warning, TEXT("Gravity field %s covers %lld cells, over the bake budget. It will bake on demand"), *GetPathNameSafe(Field), NumCells);
+			continue;
+		}
+
+		Cells.Reserve(Cells.Num() + NumCells);
+		CellLookup.Reserve(Cells.Num() + NumCells);
+
+		for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+			{
+				for (int32 X = Min.X; X <= Max.X; ++X)
+				{
+					const FIntVector Key(X, Y, Z);
+
+					if (!CellLookup.Contains(Key))
+					{
+						const FVector CellCenter = (FVector(Key) + 0.5f) * BakedCellSize;
+						CellLookup.Add(Key, Cells.Add(BakeCell(CellCenter)));
+					}
+				}
+			}
+		}
+	}
+
+	Stats.BakedCells = Cells.Num();
+}
+
+FGravityFieldCell UGravityFieldSubsystem::SampleGrid(const FVector& Location)
+{
+	// pick up field and cell size changes
+	if (bGridDirty || BakedCellSize != FMath::Max(GGravityFieldCellSize, 1.0f))
+	{
+		RebuildGrid();
+	}
+
+	// find the cell centers around the location
+	const FVector GridLocation = Location / BakedCellSize - 0.5f;
+	const FVector Floor(FMath::FloorToDouble(GridLocation.X), FMath::FloorToDouble(GridLocation.Y), FMath::FloorToDouble(GridLocation.Z));
+	const FVector Alpha = GridLocation - Floor;
+	const FIntVector BaseKey(static_cast<int32>(Floor.X), static_cast<int32>(Floor.Y), static_cast<int32>(Floor.Z));
+
+	FGravityFieldCell Result;
+	FVector Direction = FVector::ZeroVector;
+	bool bHasPriority = false;
+
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		const FIntVector Offset(Corner & 1, (Corner >> 1) & 1, (Corner >> 2) & 1);
+
+		const FGravityFieldCell* Cell = FindOrBakeCell(BaseKey + Offset);
+
+		// past the cell budget, evaluate the static fields directly
+		if (!Cell)
+		{
+			return BakeCell(Location);
+		}
+
+		const double Weight = (Offset.X ? Alpha.X : 1.0 - Alpha.X) * (Offset.Y ? Alpha.Y : 1.0 - Alpha.Y) * (Offset.Z ? Alpha.Z : 1.0 - Alpha.Z);
+
+		if (Cell->Coverage <= 0.0f || Weight <= 0.0)
+		{
+			continue;
+		}
+
+		// weight the directions by coverage, so cells outside the fields fade the gravity out instead of bending it
+		Direction += FVector(Cell->Direction) * (Cell->Coverage * Weight);
+		Result.Coverage += static_cast<float>(Cell->Coverage * Weight);
+
+		Result.Priority = bHasPriority ? FMath::Max(Result.Priority, Cell->Priority) : Cell->Priority;
+		bHasPriority = true;
+	}
+
+	Result.Direction = FVector3f(Direction.GetSafeNormal());
+
+	return Result;
+}
+
+const FGravityFieldCell* UGravityFieldSubsystem::FindOrBakeCell(const FIntVector& Key)
+{
+	if (const int32* CellIndex = CellLookup.Find(Key))
+	{
+		return &Cells[*CellIndex];
+	}
+
+	if (Cells.Num() >= GGravityFieldMaxCells)
+	{
+		return nullptr;
+	}
+
+	++Stats.CellMisses;
+
+	const FVector CellCenter = (FVector(Key) + 0.5f) * BakedCellSize;
+	const int32 CellIndex = Cells.Add(BakeCell(CellCenter));
+	CellLookup.Add(Key, CellIndex);
+
+	return &Cells[CellIndex];
+}
+
+FGravityFieldCell UGravityFieldSubsystem::BakeCell(const FVector& Location) const
+{
+	FGravityFieldCell Cell;
+	FGravityBlend Blend;
+
+	bool bFirstTier = true;
+
+	SampleTiers(BakedFields, Location, [&](int32 TierPriority, const FVector& TierDirection, float TierWeight)
+	{
+		if (bFirstTier)
+		{
+			Cell.Priority = TierPriority;
+			bFirstTier = false;
+		}
+
+		Blend.AddTier(TierDirection, TierWeight);
+	});
+
+	Cell.Coverage = 1.0f - Blend.Remaining;
+	Cell.Direction = FVector3f(Blend.Direction.GetSafeNormal());
+
+	return Cell;
+}
+
+FIntVector UGravityFieldSubsystem::GetCellKey(const FVector& Location) const
+{
+	const float CellSize = BakedCellSize > 0.0f ? BakedCellSize : FMath::Max(GGravityFieldCellSize, 1.0f);
+
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
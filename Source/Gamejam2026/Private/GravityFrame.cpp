@@ -0,0 +1,214 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "Public/GravityFrame.h"
+#include "Public/GravityController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Gamejam2026.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	/** Compares the per-call rotator conversions against the cached frame, one rotation at a time and batched */
+	void RunGravityFrameBenchmark()
+	{
+		constexpr int32 NumRotations = 65536;
+		constexpr int32 NumIterations = 20;
+
+		FRandomStream Random(1234);
+
+		const FVector GravityDirection = Random.GetUnitVector();
+
+		TArray<FRotator> Rotators;
+		TArray<FQuat> Quats;
+		Rotators.Reserve(NumRotations);
+		Quats.Reserve(NumRotations);
+
+		for (int32 i = 0; i < NumRotations; ++i)
+		{
+			const FRotator Rotation(Random.FRandRange(-89.0f, 89.0f), Random.FRandRange(-180.0f, 180.0f), 0.0f);
+			Rotators.Add(Rotation);
+			Quats.Add(Rotation.Quaternion());
+		}
+
+		TArray<FRotator> RotatorResults;
+		RotatorResults.SetNumUninitialized(NumRotations);
+
+		TArray<FQuat> QuatResults;
+		QuatResults.SetNumUninitialized(NumRotations);
+
+		// per-call conversions, building the gravity rotation every time
+		double StartTime = FPlatformTime::Seconds();
+
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 i = 0; i < NumRotations; ++i)
+			{
+				const FRotator Relative = AGravityController::GetGravityRelativeRotation(Rotators[i], GravityDirection);
+				RotatorResults[i] = AGravityController::GetGravityWorldRotation(Relative, GravityDirection);
+			}
+		}
+
+		const double LegacyMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+		// cached frame, rotator round trip
+		const FGravityFrame Frame(GravityDirection);
+
+		StartTime = FPlatformTime::Seconds();
+
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 i = 0; i < NumRotations; ++i)
+			{
+				RotatorResults[i] = Frame.ToWorld(Frame.ToRelative(Rotators[i]));
+			}
+		}
+
+		const double FrameRotatorMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+		// cached frame, quaternion round trip
+		StartTime = FPlatformTime::Seconds();
+
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 i = 0; i < NumRotations; ++i)
+			{
+				QuatResults[i] = Frame.ToWorld(Frame.ToRelative(Quats[i]));
+			}
+		}
+
+		const double FrameQuatMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+		// cached frame, batched vector register round trip
+		StartTime = FPlatformTime::Seconds();
+
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Frame.ToRelative(Quats, QuatResults);
+			Frame.ToWorld(QuatResults, QuatResults);
+		}
+
+		const double FrameBatchMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+		// make sure the batch matches the scalar path
+		double MaxError = 0.0;
+
+		for (int32 i = 0; i < NumRotations; ++i)
+		{
+			MaxError = FMath::Max(MaxError, QuatResults[i].AngularDistance(Quats[i]));
+		}
+
+		UE_LOG(LogGamejam2026, Log, TEXT("Gravity frame benchmark, %d rotations to gravity space and back:"), NumRotations);
+		UE_LOG(LogGamejam2026, Log, TEXT("  per-call rotator conversion  %8.3f ms"), LegacyMs);
+		UE_LOG(LogGamejam2026, Log, TEXT("  cached frame, rotators       %8.3f ms"), FrameRotatorMs);
+		UE_LOG(LogGamejam2026, Log, TEXT("  cached frame, quaternions    %8.3f ms"), FrameQuatMs);
+		UE_LOG(LogGamejam2026, Log, TEXT("  cached frame, batched        %8.3f ms (round trip error %.3g deg)"), FrameBatchMs, FMath::RadiansToDegrees(MaxError));
+	}
+
+	/**
+	 *  Simulates a camera orbiting a spherical gravity source for ten minutes at 60 Hz with no look input,
+	 *  running the same steps as AGravityController::UpdateRotation. The gravity relative view should come back
+	 *  to where it started after every orbit. Reports the worst deviation for the old and the cached frame paths.
+	 */
+	void RunGravityFramePrecisionTest()
+	{
+		constexpr double StepTime = 1.0 / 60.0;
+		constexpr int32 StepsPerOrbit = 1200;
+		constexpr int32 NumSteps = 10 * 60 * 60;
+		constexpr double MaxDriftDegrees = 0.01;
+
+		const FRotator StartRelative(-20.0, 30.0, 0.0);
+
+		// orbit around the equator so gravity never lines up with the world up vector
+		auto GetGravityAtStep = [](int32 Step)
+		{
+			const double Angle = UE_DOUBLE_TWO_PI * (Step % StepsPerOrbit) / StepsPerOrbit;
+			return -FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0);
+		};
+
+		const FVector StartGravity = GetGravityAtStep(0);
+
+		// old path: rotators in and out of every conversion
+		FRotator LegacyView = AGravityController::GetGravityWorldRotation(StartRelative, StartGravity);
+		FVector LegacyLastGravity = StartGravity;
+		double LegacyDrift = 0.0;
+
+		// cached frame path
+		FGravityFrame Frame(StartGravity);
+		FRotator FrameView = Frame.ToWorld(StartRelative);
+		double FrameDrift = 0.0;
+
+		const FQuat StartRelativeQuat = StartRelative.Quaternion();
+
+		for (int32 Step = 1; Step <= NumSteps; ++Step)
+		{
+			const FVector Gravity = GetGravityAtStep(Step);
+
+			// old path
+			{
+				const FQuat DeltaGravityRotation = FQuat::FindBetweenNormals(LegacyLastGravity, Gravity);
+				LegacyView = (DeltaGravityRotation * FQuat(LegacyView)).Rotator();
+				LegacyLastGravity = Gravity;
+
+				FRotator Relative = AGravityController::GetGravityRelativeRotation(LegacyView, Gravity);
+				Relative.Roll = 0;
+				LegacyView = AGravityController::GetGravityWorldRotation(Relative, Gravity);
+
+				if (Step % StepsPerOrbit == 0)
+				{
+					LegacyDrift = FMath::Max(LegacyDrift, FMath::RadiansToDegrees(Relative.Quaternion().AngularDistance(StartRelativeQuat)));
+				}
+			}
+
+			// cached frame path
+			{
+				const FVector LastGravity = Frame.GetGravityDirection();
+				FQuat ViewQuat = FrameView.Quaternion();
+
+				if (Frame.SetGravityDirection(Gravity))
+				{
+					ViewQuat = FQuat::FindBetweenNormals(LastGravity, Frame.GetGravityDirection()) * ViewQuat;
+				}
+
+				FRotator Relative = Frame.ToRelative(ViewQuat).Rotator();
+				Relative.Roll = 0;
+				FrameView = Frame.ToWorld(Relative);
+
+				if (Step % StepsPerOrbit == 0)
+				{
+					FrameDrift = FMath::Max(FrameDrift, FMath::RadiansToDegrees(Relative.Quaternion().AngularDistance(StartRelativeQuat)));
+				}
+			}
+		}
+
+		UE_LOG(LogGamejam2026, Log, TEXT("Gravity frame precision, %d orbits over %.0f s:"), NumSteps / StepsPerOrbit, NumSteps * StepTime);
+		UE_LOG(LogGamejam2026, Log, TEXT("  per-call rotator conversion  max drift %.6f deg"), LegacyDrift);
+		UE_LOG(LogGamejam2026, Log, TEXT("  cached frame                 max drift %.6f deg"), FrameDrift);
+
+		if (FrameDrift <= MaxDriftDegrees)
+		{
+			UE_LOG(LogGamejam2026, Log, TEXT("Gravity frame precision test passed (limit %.3f deg)"), MaxDriftDegrees);
+		}
+		else
+		{
+			UE_LOG(LogGamejam2026, Error, TEXT("Gravity frame precision test FAILED: %.6f deg drift (limit %.3f deg)"), FrameDrift, MaxDriftDegrees);
+		}
+	}
+}
+
+static FAutoConsoleCommand GravityFrameBenchmarkCommand(
+	TEXT("Gravity.Frame.Benchmark"),
+	TEXT("Times gravity relative rotation conversions with per-call rotators, the cached frame and the batched frame"),
+	FConsoleCommandDelegate::CreateStatic(&RunGravityFrameBenchmark)
+);
+
+static FAutoConsoleCommand GravityFramePrecisionTestCommand(
+	TEXT("Gravity.Frame.PrecisionTest"),
+	TEXT("Orbits a spherical gravity source for ten simulated minutes and reports how far the camera drifts"),
+	FConsoleCommandDelegate::CreateStatic(&RunGravityFramePrecisionTest)
+);
+
+#endif
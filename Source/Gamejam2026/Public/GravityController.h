@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "GravityFrame.h"
 #include "GravityController.generated.h"
 
 /**
@@ -30,4 +31,7 @@ public:
 	 
 private:
 	FVector LastFrameGravity = FVector::ZeroVector;
+
+	// Cached conversion between world space and the current gravity relative space.
+	FGravityFrame GravityFrame;
 };
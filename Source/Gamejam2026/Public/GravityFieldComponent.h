@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "GravityFieldComponent.generated.h"
+
+class USplineComponent;
+
+/**
+ *  Shape of the volume a gravity field affects
+ */
+UENUM(BlueprintType)
+enum class EGravityFieldShape : uint8
+{
+	// pulls towards the component's location, within Radius
+	Point,
+
+	// pulls towards the component's location, between InnerRadius and Radius
+	SphericalShell,
+
+	// pulls along the component's down vector, inside BoxExtent
+	Box,
+
+	// pulls towards the closest point on a spline, within Radius
+	Spline
+};
+
+/**
+ *  A gravity source. Characters inside the field have their gravity direction set by the UGravityFieldSubsystem.
+ *  Overlapping fields blend by priority: higher priority fields take precedence,
+ *  and fields with the same priority are averaged by weight.
+ *  Fields with static mobility are baked into the subsystem's direction grid, movable fields are evaluated every frame.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class GAMEJAM2026_API UGravityFieldComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Shape of the field */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Gravity Field")
+	EGravityFieldShape Shape = EGravityFieldShape::Point;
+
+	/** Higher priority fields override lower priority ones where they overlap */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Gravity Field")
+	int32 Priority = 0;
+
+	/** Blend weight of the field at full strength. Fields with the same priority are averaged by weight */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Gravity Field", meta = (ClampMin = 0, ClampMax = 1))
+	float Weight = 1.0f;
+
+	/** Distance from the edge of the field over which its weight fades in */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Gravity Field", meta = (ClampMin = 0, Units = "cm"))
+	float BlendDistance = 200.0f;
+
+	/** If true, the field pushes away instead of pulling */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Gravity Field")
+	bool bInvertDirection = false;
+
+	/** Outer radius for point, spherical shell and spline fields */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Gravity Field", meta = (ClampMin = 0, Units = "cm", EditCondition = "Shape != EGravityFieldShape::Box", EditConditionHides))
+	float Radius = 2000.0f;
+
+	/** Inner radius for spherical shell fields */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Gravity Field", meta = (ClampMin = 0, Units = "cm", EditCondition = "Shape == EGravityFieldShape::SphericalShell", EditConditionHides))
+	float InnerRadius = 1000.0f;
+
+	/** Half extents of box fields */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Gravity Field", meta = (EditCondition = "Shape == EGravityFieldShape::Box", EditConditionHides))
+	FVector BoxExtent = FVector(1000.0f);
+
+public:
+
+	/** Constructor */
+	UGravityFieldComponent();
+
+	/** Returns the field's weight at a location, and the direction it pulls in. Returns zero outside the field */
+	float SampleField(const FVector& Location, FVector& OutDirection) const;
+
+	/** Returns the world space bounds affected by the field */
+	FBox GetFieldBounds() const;
+
+	/** Returns true if the field is baked into the direction grid */
+	bool IsBaked() const { return Mobility == EComponentMobility::Static; }
+
+protected:
+
+	/** Spline used by spline fields. Found on the owner when the component registers */
+	UPROPERTY(Transient)
+	TObjectPtr<USplineComponent> Spline;
+
+	/** Registers with the gravity field subsystem */
+	virtual void OnRegister() override;
+
+	/** Unregisters from the gravity field subsystem */
+	virtual void OnUnregister() override;
+};
@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameWorldTickFunction.h"
+#include "GravityFieldSubsystem.generated.h"
+
+class UGravityFieldComponent;
+class UCharacterMovementComponent;
+
+/**
+ *  Pre-blended gravity from all baked fields at one grid cell
+ */
+struct FGravityFieldCell
+{
+	/** Blended direction of the baked fields */
+	FVector3f Direction = FVector3f::ZeroVector;
+
+	/** Total weight of the baked fields. Zero if no baked field covers the cell */
+	float Coverage = 0.0f;
+
+	/** Highest priority of the baked fields covering the cell */
+	int32 Priority = 0;
+};
+
+/**
+ *  Running statistics for the gravity field subsystem
+ */
+USTRUCT(BlueprintType)
+struct FGravityFieldStats
+{
+	GENERATED_BODY()
+
+	/** Number of characters updated in the last pass */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Gravity Field")
+	int32 Characters = 0;
+
+	/** Number of characters whose gravity direction changed in the last pass */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Gravity Field")
+	int32 DirectionChanges = 0;
+
+	/** Number of baked grid cells */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Gravity Field")
+	int32 BakedCells = 0;
+
+	/** Number of cells baked on demand during the last pass */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Gravity Field")
+	int32 CellMisses = 0;
+
+	/** Time spent in the last pass */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Gravity Field", meta = (Units = "ms"))
+	float PassTimeMs = 0.0f;
+};
+
+/**
+ *  Owns the world's gravity fields and drives character gravity from them.
+ *  Static fields are blended once per cell into a sparse direction grid, so sampling them is a trilinear blend
+ *  of the eight surrounding cells regardless of how many fields overlap. Movable fields are evaluated live and blended with the grid by priority.
+ *  Every character movement component gets its gravity direction updated in one batched pass before movement ticks.
+ */
+UCLASS()
+class GAMEJAM2026_API UGravityFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Fields baked into the grid, highest priority first */
+	UPROPERTY()
+	TArray<TObjectPtr<UGravityFieldComponent>> BakedFields;
+
+	/** Fields evaluated every sample, highest priority first */
+	UPROPERTY()
+	TArray<TObjectPtr<UGravityFieldComponent>> DynamicFields;
+
+	/** Movement components driven by the fields */
+	TArray<TWeakObjectPtr<UCharacterMovementComponent>> MovementComponents;
+
+	/** Grid cell to baked cell index */
+	TMap<FIntVector, int32> CellLookup;
+
+	/** Baked cells, packed */
+	TArray<FGravityFieldCell> Cells;
+
+	/** Cell size the grid was baked with */
+	float BakedCellSize = 0.0f;
+
+	/** If true, the baked fields changed and the grid needs to be rebuilt */
+	bool bGridDirty = false;
+
+	/** If true, the last pass set character gravity, so characters get reset once the last field goes away */
+	bool bDrivingGravity = false;
+
+	/** Scratch locations for the batched pass */
+	TArray<FVector> PassLocations;
+
+	/** Tick function that runs the batched pass */
+	FGameWorldTickFunction ApplyTickFunction;
+
+	/** Handle for the actor spawned delegate */
+	FDelegateHandle ActorSpawnedHandle;
+
+	/** Statistics */
+	FGravityFieldStats Stats;
+
+public:
+
+	/** Adds a gravity field */
+	void RegisterField(UGravityFieldComponent* Field);
+
+	/** Removes a gravity field */
+	void UnregisterField(UGravityFieldComponent* Field);
+
+	/** Returns the blended gravity direction at a location */
+	UFUNCTION(BlueprintCallable, Category="Gravity Field")
+	FVector GetGravityDirection(const FVector& Location);
+
+	/** Returns the statistics */
+	const FGravityFieldStats& GetStats() const { return Stats; }
+
+	/** Writes the statistics to the log */
+	void DumpStats() const;
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Collects the characters and registers the batched pass */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Starts driving newly spawned characters */
+	void OnActorSpawned(AActor* Actor);
+
+	/** Samples the gravity for every character and updates the ones that changed */
+	void ApplyGravity(float DeltaTime);
+
+	/** Clears the grid and pre-bakes the cells covered by baked fields, up to the cell budget */
+	void RebuildGrid();
+
+	/** Trilinearly blends the eight baked cells around a location, so the direction doesn't step at cell borders */
+	FGravityFieldCell SampleGrid(const FVector& Location);
+
+	/** Returns the baked cell for a grid key, baking it if needed. Returns nullptr if over the cell budget */
+	const FGravityFieldCell* FindOrBakeCell(const FIntVector& Key);
+
+	/** Blends the baked fields at a location into a cell */
+	FGravityFieldCell BakeCell(const FVector& Location) const;
+
+	/** Returns the grid cell containing a location */
+	FIntVector GetCellKey(const FVector& Location) const;
+};
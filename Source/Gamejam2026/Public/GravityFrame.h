@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ *  Converts rotations between world space and gravity relative space.
+ *  The rotation between the gravity direction and the world down vector is cached,
+ *  and only recomputed when the gravity direction actually changes.
+ *  All conversions are quaternion multiplies. Rotator overloads convert to and from quaternions exactly once.
+ */
+struct GAMEJAM2026_API FGravityFrame
+{
+public:
+
+	/** Creates a frame for regular world gravity */
+	FGravityFrame() = default;
+
+	/** Creates a frame for a gravity direction */
+	explicit FGravityFrame(const FVector& InGravityDirection)
+	{
+		SetGravityDirection(InGravityDirection);
+	}
+
+	/** Updates the cached basis if the gravity direction changed. Returns true if it did */
+	bool SetGravityDirection(const FVector& InGravityDirection)
+	{
+		const FVector NewDirection = InGravityDirection.GetSafeNormal(UE_SMALL_NUMBER, FVector::DownVector);
+
+		if (NewDirection.Equals(GravityDirection, DirectionTolerance))
+		{
+			return false;
+		}
+
+		GravityDirection = NewDirection;
+		bIsWorldGravity = GravityDirection.Equals(FVector::DownVector);
+
+		WorldToGravity = bIsWorldGravity ? FQuat::Identity : FQuat::FindBetweenNormals(GravityDirection, FVector::DownVector);
+		GravityToWorld = WorldToGravity.Inverse();
+
+		WorldToGravityRegister = VectorLoad(&WorldToGravity.X);
+		GravityToWorldRegister = VectorLoad(&GravityToWorld.X);
+
+		return true;
+	}
+
+	/** Returns the gravity direction */
+	const FVector& GetGravityDirection() const { return GravityDirection; }
+
+	/** Returns true if the frame matches regular world gravity, making conversions a no-op */
+	bool IsWorldGravity() const { return bIsWorldGravity; }
+
+	/** Returns the rotation from world space to gravity relative space */
+	const FQuat& GetWorldToGravity() const { return WorldToGravity; }
+
+	/** Returns the rotation from gravity relative space to world space */
+	const FQuat& GetGravityToWorld() const { return GravityToWorld; }
+
+	/** Converts a world space rotation to gravity relative space */
+	FQuat ToRelative(const FQuat& WorldRotation) const
+	{
+		return bIsWorldGravity ? WorldRotation : WorldToGravity * WorldRotation;
+	}
+
+	/** Converts a gravity relative rotation to world space */
+	FQuat ToWorld(const FQuat& RelativeRotation) const
+	{
+		return bIsWorldGravity ? RelativeRotation : GravityToWorld * RelativeRotation;
+	}
+
+	/** Converts a world space rotation to gravity relative space */
+	FRotator ToRelative(const FRotator& WorldRotation) const
+	{
+		return bIsWorldGravity ? WorldRotation : (WorldToGravity * WorldRotation.Quaternion()).Rotator();
+	}
+
+	/** Converts a gravity relative rotation to world space */
+	FRotator ToWorld(const FRotator& RelativeRotation) const
+	{
+		return bIsWorldGravity ? RelativeRotation : (GravityToWorld * RelativeRotation.Quaternion()).Rotator();
+	}
+
+	/** Converts a world space quaternion held in a vector register to gravity relative space */
+	VectorRegister ToRelative(const VectorRegister& WorldRotation) const
+	{
+		return VectorQuaternionMultiply2(WorldToGravityRegister, WorldRotation);
+	}
+
+	/** Converts a gravity relative quaternion held in a vector register to world space */
+	VectorRegister ToWorld(const VectorRegister& RelativeRotation) const
+	{
+		return VectorQuaternionMultiply2(GravityToWorldRegister, RelativeRotation);
+	}
+
+	/** Converts an array of world space rotations to gravity relative space. In and Out may be the same array */
+	void ToRelative(TConstArrayView<FQuat> WorldRotations, TArrayView<FQuat> OutRelativeRotations) const
+	{
+		ConvertBatch(WorldToGravityRegister, WorldRotations, OutRelativeRotations);
+	}
+
+	/** Converts an array of gravity relative rotations to world space. In and Out may be the same array */
+	void ToWorld(TConstArrayView<FQuat> RelativeRotations, TArrayView<FQuat> OutWorldRotations) const
+	{
+		ConvertBatch(GravityToWorldRegister, RelativeRotations, OutWorldRotations);
+	}
+
+protected:
+
+	/** Directions closer than this are treated as unchanged */
+	static constexpr double DirectionTolerance = 1.e-6;
+
+	/** Multiplies every rotation by the basis, four components at a time */
+	static void ConvertBatch(const VectorRegister& Basis, TConstArrayView<FQuat> In, TArrayView<FQuat> Out)
+	{
+		check(In.Num() == Out.Num());
+
+		for (int32 i = 0; i < In.Num(); ++i)
+		{
+			VectorStore(VectorQuaternionMultiply2(Basis, VectorLoad(&In[i].X)), &Out[i].X);
+		}
+	}
+
+	/** Current gravity direction */
+	FVector GravityDirection = FVector::DownVector;
+
+	/** Rotation from world space to gravity relative space */
+	FQuat WorldToGravity = FQuat::Identity;
+
+	/** Rotation from gravity relative space to world space */
+	FQuat GravityToWorld = FQuat::Identity;
+
+	/** Register copies of the cached rotations */
+	VectorRegister WorldToGravityRegister = GlobalVectorConstants::Double0001;
+	VectorRegister GravityToWorldRegister = GlobalVectorConstants::Double0001;
+
+	/** True if the gravity direction is the world down vector */
+	bool bIsWorldGravity = true;
+};
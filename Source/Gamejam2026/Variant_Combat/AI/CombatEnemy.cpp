@@ -2,15 +2,28 @@
 
 
 #include "CombatEnemy.h"
+#include "CombatStats.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "CombatAIController.h"
 #include "Components/WidgetComponent.h"
 #include "Engine/DamageEvents.h"
 #include "CombatLifeBar.h"
+#include "CombatLifeBarSubsystem.h"
 #include "TimerManager.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Animation/AnimInstance.h"
+#include "BrainComponent.h"
+#include "CombatEnemyPoolSubsystem.h"
+#include "CombatAttackTraceSubsystem.h"
+#include "CombatSpatialSubsystem.h"
+#include "CombatQuerySubsystem.h"
+#include "CombatSignificanceSubsystem.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatReplaySubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Gamejam2026.h"
 
 ACombatEnemy::ACombatEnemy()
 {
@@ -38,6 +51,9 @@ ACombatEnemy::ACombatEnemy()
 	// set the character movement properties
 	GetCharacterMovement()->bUseControllerDesiredRotation = true;
 
+	// allow the significance manager to throttle animation updates
+	GetMesh()->bEnableUpdateRateOptimizations = true;
+
 	// reset HP to maximum
 	CurrentHP = MaxHP;
 }
@@ -50,25 +66,40 @@ void ACombatEnemy::DoAIComboAttack()
 		return;
 	}
 
+	// the montage is streamed in the background. If it isn't resident yet, end the attack on the next tick so the StateTree moves on
+	UAnimMontage* AttackMontage = ComboAttackMontage.Get();
+
+	if (!AttackMontage)
+	{
+		UE_LOG(LogGamejam2026, Verbose, TEXT("%s: combo attack montage isn't loaded yet"), *GetName());
+
+		bIsAttacking = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ACombatEnemy::AttackMontageEnded, static_cast<UAnimMontage*>(nullptr), true));
+		return;
+	}
+
 	// raise the attacking flag
 	bIsAttacking = true;
 
 	// choose how many times we're going to attack
-	TargetComboCount = FMath::RandRange(1, ComboSectionNames.Num() - 1);
+	TargetComboCount = AttackRandomStream.RandRange(1, ComboSectionNames.Num() - 1);
 
 	// reset the attack counter
 	CurrentComboAttack = 0;
 
+	// start a new swing
+	BeginAttackSwing();
+
 	// play the attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		const float MontageLength = AnimInstance->Montage_Play(ComboAttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
+		const float MontageLength = AnimInstance->Montage_Play(AttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
 
 		// subscribe to montage completed and interrupted events
 		if (MontageLength > 0.0f)
 		{
 			// set the end delegate for the montage
-			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ComboAttackMontage);
+			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, AttackMontage);
 		}
 	}
 }
@@ -81,25 +112,40 @@ void ACombatEnemy::DoAIChargedAttack()
 		return;
 	}
 
+	// the montage is streamed in the background. If it isn't resident yet, end the attack on the next tick so the StateTree moves on
+	UAnimMontage* AttackMontage = ChargedAttackMontage.Get();
+
+	if (!AttackMontage)
+	{
+		UE_LOG(LogGamejam2026, Verbose, TEXT("%s: charged attack montage isn't loaded yet"), *GetName());
+
+		bIsAttacking = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ACombatEnemy::AttackMontageEnded, static_cast<UAnimMontage*>(nullptr), true));
+		return;
+	}
+
 	// raise the attacking flag
 	bIsAttacking = true;
 
 	// choose how many loops are we going to charge for
-	TargetChargeLoops = FMath::RandRange(MinChargeLoops, MaxChargeLoops);
+	TargetChargeLoops = AttackRandomStream.RandRange(MinChargeLoops, MaxChargeLoops);
 
 	// reset the charge loop counter
 	CurrentChargeLoop = 0;
 
+	// start a new swing
+	BeginAttackSwing();
+
 	// play the attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		const float MontageLength = AnimInstance->Montage_Play(ChargedAttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
+		const float MontageLength = AnimInstance->Montage_Play(AttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
 
 		// subscribe to montage completed and interrupted events
 		if (MontageLength > 0.0f)
 		{
 			// set the end delegate for the montage
-			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ChargedAttackMontage);
+			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, AttackMontage);
 		}
 	}
 }
@@ -113,21 +159,31 @@ void ACombatEnemy::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 	OnAttackCompleted.ExecuteIfBound();
 }
 
-const FVector& ACombatEnemy::GetLastDangerLocation() const
+FVector ACombatEnemy::GetLastDangerLocation() const
 {
-	return LastDangerLocation;
+	// danger records are kept by the spatial index
+	const UCombatSpatialSubsystem* Spatial = GetWorld()->GetSubsystem<UCombatSpatialSubsystem>();
+	return Spatial ? Spatial->GetLastDangerLocation(this) : FVector::ZeroVector;
 }
 
 float ACombatEnemy::GetLastDangerTime() const
 {
-	return LastDangerTime;
+	// danger records are kept by the spatial index
+	const UCombatSpatialSubsystem* Spatial = GetWorld()->GetSubsystem<UCombatSpatialSubsystem>();
+	return Spatial ? Spatial->GetLastDangerTime(this) : UCombatSpatialSubsystem::NoDangerTime;
 }
 
-void ACombatEnemy::DoAttackTrace(FName DamageSourceBone)
+void ACombatEnemy::BeginAttackSwing()
 {
-	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
+	// reset the per-swing hit list
+	if (UCombatAttackTraceSubsystem* AttackTraces = GetWorld()->GetSubsystem<UCombatAttackTraceSubsystem>())
+	{
+		AttackTraces->BeginSwing(this);
+	}
+}
 
+void ACombatEnemy::DoAttackTrace(FName DamageSourceBone)
+{
 	// start at the provided socket location, sweep forward
 	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
 	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
@@ -136,35 +192,28 @@ void ACombatEnemy::DoAttackTrace(FName DamageSourceBone)
 	FCollisionObjectQueryParams ObjectParams;
 	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
 
-	// use a sphere shape for the sweep
-	FCollisionShape CollisionShape;
-	CollisionShape.SetSphere(MeleeTraceRadius);
-
-	// ignore self
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	// queue the sweep. Hits will be resolved in a batch through ApplyAttackHit
+	if (UCombatAttackTraceSubsystem* AttackTraces = GetWorld()->GetSubsystem<UCombatAttackTraceSubsystem>())
 	{
-		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
-		{
-			/** does the actor have the player tag? */
-			if (CurrentHit.GetActor()->ActorHasTag(FName("Player")))
-			{
-				// check if the actor is damageable
-				ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
+		AttackTraces->QueueAttackTrace(this, TraceStart, TraceEnd, MeleeTraceRadius, ObjectParams);
+	}
+}
 
-				if (Damageable)
-				{
-					// knock upwards and away from the impact normal
-					const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+void ACombatEnemy::ApplyAttackHit(const FHitResult& Hit)
+{
+	/** does the actor have the player tag? */
+	if (Hit.GetActor()->ActorHasTag(FName("Player")))
+	{
+		// check if the actor is damageable
+		ICombatDamageable* Damageable = Cast<ICombatDamageable>(Hit.GetActor());
 
-					// pass the damage event to the actor
-					Damageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
+		if (Damageable)
+		{
+			// knock upwards and away from the impact normal
+			const FVector Impulse = (Hit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
 
-				}
-			}
+			// queue the damage event. The damage pipeline applies it after physics
+			UCombatDamageSubsystem::SendDamage(this, Hit.GetActor(), MeleeDamage, ECombatDamageType::Melee, Hit.ImpactPoint, Impulse);
 		}
 	}
 }
@@ -177,10 +226,13 @@ void ACombatEnemy::CheckCombo()
 	// do we still have attacks to play in this string?
 	if (CurrentComboAttack < TargetComboCount)
 	{
+		// start a new swing
+		BeginAttackSwing();
+
 		// jump to the next attack section
 		if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 		{
-			AnimInstance->Montage_JumpToSection(ComboSectionNames[CurrentComboAttack], ComboAttackMontage);
+			AnimInstance->Montage_JumpToSection(ComboSectionNames[CurrentComboAttack], ComboAttackMontage.Get());
 		}
 	}
 }
@@ -193,7 +245,7 @@ void ACombatEnemy::CheckChargedAttack()
 	// jump to either the loop or attack section of the montage depending on whether we hit the loop target
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		AnimInstance->Montage_JumpToSection(CurrentChargeLoop >= TargetChargeLoops ? ChargeAttackSection : ChargeLoopSection, ChargedAttackMontage);
+		AnimInstance->Montage_JumpToSection(CurrentChargeLoop >= TargetChargeLoops ? ChargeAttackSection : ChargeLoopSection, ChargedAttackMontage.Get());
 	}
 }
 
@@ -220,8 +272,16 @@ void ACombatEnemy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector
 		// stop the attack montages to interrupt the attack
 		if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 		{
-			AnimInstance->Montage_Stop(0.1f, ComboAttackMontage);
-			AnimInstance->Montage_Stop(0.1f, ChargedAttackMontage);
+			// a null montage would stop every montage, so only stop the ones that are loaded
+			if (UAnimMontage* AttackMontage = ComboAttackMontage.Get())
+			{
+				AnimInstance->Montage_Stop(0.1f, AttackMontage);
+			}
+
+			if (UAnimMontage* AttackMontage = ChargedAttackMontage.Get())
+			{
+				AnimInstance->Montage_Stop(0.1f, AttackMontage);
+			}
 		}
 
 		// pass control to BP to play effects, etc.
@@ -243,11 +303,20 @@ void ACombatEnemy::HandleDeath()
 	// enable full ragdoll physics
 	GetMesh()->SetSimulatePhysics(true);
 
+	// dead enemies can't be threatened anymore
+	if (UCombatSpatialSubsystem* Spatial = GetWorld()->GetSubsystem<UCombatSpatialSubsystem>())
+	{
+		Spatial->UnregisterEnemy(this);
+	}
+
 	// call the died delegate to notify any subscribers
 	OnEnemyDied.Broadcast();
 
-	// set up the death timer
-	GetWorld()->GetTimerManager().SetTimer(DeathTimer, this, &ACombatEnemy::RemoveFromLevel, DeathRemovalTime);
+	// schedule the removal from the level
+	if (UGameCooldownSubsystem* Cooldowns = GetWorld()->GetSubsystem<UGameCooldownSubsystem>())
+	{
+		Cooldowns->SetCooldown(DeathCooldown, DeathRemovalTime, FSimpleDelegate::CreateUObject(this, &ACombatEnemy::RemoveFromLevel));
+	}
 }
 
 void ACombatEnemy::ApplyHealing(float Healing, AActor* Healer)
@@ -261,19 +330,154 @@ void ACombatEnemy::NotifyDanger(const FVector& DangerLocation, AActor* DangerSou
 	if (DangerSource && DangerSource->ActorHasTag(FName("Player")))
 	{
 		// save the danger location and game time
-		LastDangerLocation = DangerLocation;
-		LastDangerTime = GetWorld()->GetTimeSeconds();
+		if (UCombatSpatialSubsystem* Spatial = GetWorld()->GetSubsystem<UCombatSpatialSubsystem>())
+		{
+			Spatial->RecordDanger(this, DangerLocation);
+		}
 	}
 }
 
 void ACombatEnemy::RemoveFromLevel()
 {
+	// return pool-owned enemies to the pool instead of destroying them
+	if (bIsPooled)
+	{
+		if (UCombatEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UCombatEnemyPoolSubsystem>())
+		{
+			Pool->ReleaseEnemy(this);
+			return;
+		}
+	}
+
 	// destroy this actor
 	Destroy();
 }
 
+void ACombatEnemy::DeactivateForPool()
+{
+	// raise the pooled flag
+	bIsInPool = true;
+
+	// clear the death cooldown in case we're parked early
+	if (UGameCooldownSubsystem* Cooldowns = GetWorld()->GetSubsystem<UGameCooldownSubsystem>())
+	{
+		Cooldowns->ClearCooldown(DeathCooldown);
+	}
+
+	// remove ourselves from the spatial index
+	if (UCombatSpatialSubsystem* Spatial = GetWorld()->GetSubsystem<UCombatSpatialSubsystem>())
+	{
+		Spatial->UnregisterEnemy(this);
+	}
+
+	// go back to full rate updates, so we don't come out of the pool throttled
+	if (UCombatSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UCombatSignificanceSubsystem>())
+	{
+		Significance->ReleaseEnemy(this);
+	}
+
+	// free up any positioning point we were holding
+	if (UCombatQuerySubsystem* Query = GetWorld()->GetSubsystem<UCombatQuerySubsystem>())
+	{
+		Query->ReleaseReservation(this);
+	}
+
+	// stop the StateTree and any pathing
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		AIController->StopMovement();
+		AIController->ClearFocus(EAIFocusPriority::Gameplay);
+
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->StopLogic(TEXT("Returned to enemy pool"));
+		}
+	}
+
+	// stop any attack montages
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->StopAllMontages(0.0f);
+	}
+
+	// hide the enemy and take it out of the simulation
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetComponentTickEnabled(false);
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+}
+
+void ACombatEnemy::ActivateFromPool(const FTransform& SpawnTransform)
+{
+	// lower the pooled flag
+	bIsInPool = false;
+
+	// move to the spawn transform
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	// reset the ragdoll and snap the mesh back onto the capsule
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetPhysicsBlendWeight(0.0f);
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	GetMesh()->SetRelativeTransform(MeshStartingTransform);
+	GetMesh()->SetComponentTickEnabled(true);
+
+	// re-enable collision and movement
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	SetActorEnableCollision(true);
+
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	// reset the combat state
+	CurrentHP = MaxHP;
+	bIsAttacking = false;
+
+	// reseed the attack choices, so reused enemies stay deterministic in replays
+	AttackRandomStream.Initialize(UCombatReplaySubsystem::MakeSeed(this));
+
+	// add ourselves back to the spatial index with a clean danger record
+	if (UCombatSpatialSubsystem* Spatial = GetWorld()->GetSubsystem<UCombatSpatialSubsystem>())
+	{
+		Spatial->RegisterEnemy(this);
+	}
+
+	// refill and show the life bar
+	UCombatLifeBarSubsystem::UpdateLifeBar(LifeBar, LifeBarWidget, 1.0f);
+	LifeBar->SetHiddenInGame(false);
+
+	// show the enemy
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+
+	// restart the StateTree from its root state
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->RestartLogic();
+		}
+	}
+}
+
+void ACombatEnemy::SetHP(float NewHP)
+{
+	CurrentHP = FMath::Clamp(NewHP, 0.0f, MaxHP);
+
+	// update the life bar
+	UCombatLifeBarSubsystem::UpdateLifeBar(LifeBar, LifeBarWidget, CurrentHP / MaxHP);
+}
+
 float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(TakeDamage);
+
 	// only process damage if the character is still alive
 	if (CurrentHP <= 0.0f)
 	{
@@ -292,7 +496,7 @@ float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEv
 	else
 	{
 		// update the life bar
-		LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
+		UCombatLifeBarSubsystem::UpdateLifeBar(LifeBar, LifeBarWidget, CurrentHP / MaxHP);
 
 		// enable partial ragdoll physics, but keep the pelvis vertical
 		GetMesh()->SetPhysicsBlendWeight(0.5f);
@@ -326,18 +530,79 @@ void ACombatEnemy::BeginPlay()
 	// we top the HP before BeginPlay so StateTree picks it up at the right value
 	Super::BeginPlay();
 
+	// seed the attack choices
+	AttackRandomStream.Initialize(UCombatReplaySubsystem::MakeSeed(this));
+
 	// get the life bar widget from the widget comp
 	LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
 	check(LifeBarWidget);
 
+	// let the life bar subsystem coalesce updates and draw the bar in the shared enemy layer
+	if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+	{
+		LifeBars->RegisterLifeBar(LifeBar, LifeBarWidget, true);
+	}
+
 	// fill the life bar
-	LifeBarWidget->SetLifePercentage(1.0f);
+	UCombatLifeBarSubsystem::UpdateLifeBar(LifeBar, LifeBarWidget, 1.0f);
+
+	// save the relative transform for the mesh so we can reset the ragdoll when reused from the pool
+	MeshStartingTransform = GetMesh()->GetRelativeTransform();
+
+	// add ourselves to the spatial index
+	if (UCombatSpatialSubsystem* Spatial = GetWorld()->GetSubsystem<UCombatSpatialSubsystem>())
+	{
+		Spatial->RegisterEnemy(this);
+	}
+
+	// register our modifiers and resistances with the damage pipeline
+	if (UCombatDamageSubsystem* Damage = GetWorld()->GetSubsystem<UCombatDamageSubsystem>())
+	{
+		Damage->RegisterDamageProfile(this, DamageProfile);
+	}
+
+	// stream in the attack montages. They're usually resident already from the game mode's preload
+	TArray<FSoftObjectPath> PreloadPaths;
+	GetPreloadAssets(PreloadPaths);
+
+	if (PreloadPaths.Num() > 0)
+	{
+		MontageLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(PreloadPaths);
+	}
+}
+
+void ACombatEnemy::GetPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const
+{
+	if (!ComboAttackMontage.IsNull())
+	{
+		OutPaths.AddUnique(ComboAttackMontage.ToSoftObjectPath());
+	}
+
+	if (!ChargedAttackMontage.IsNull())
+	{
+		OutPaths.AddUnique(ChargedAttackMontage.ToSoftObjectPath());
+	}
 }
 
 void ACombatEnemy::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the death timer
-	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+	// remove ourselves from the spatial index
+	if (UCombatSpatialSubsystem* Spatial = GetWorld()->GetSubsystem<UCombatSpatialSubsystem>())
+	{
+		Spatial->UnregisterEnemy(this);
+	}
+
+	// stop tracking the life bar
+	if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+	{
+		LifeBars->UnregisterLifeBar(LifeBar);
+	}
+
+	// remove our damage profile
+	if (UCombatDamageSubsystem* Damage = GetWorld()->GetSubsystem<UCombatDamageSubsystem>())
+	{
+		Damage->UnregisterDamageProfile(this);
+	}
 }
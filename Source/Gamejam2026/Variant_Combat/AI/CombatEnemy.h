@@ -6,13 +6,16 @@
 #include "GameFramework/Character.h"
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
+#include "CombatDamageTypes.h"
 #include "Animation/AnimMontage.h"
-#include "Engine/TimerHandle.h"
+#include "GameCooldownSubsystem.h"
+#include "Math/RandomStream.h"
 #include "CombatEnemy.generated.h"
 
 class UWidgetComponent;
 class UCombatLifeBar;
 class UAnimMontage;
+struct FStreamableHandle;
 
 /** Completed attack animation delegate for StateTree */
 DECLARE_DELEGATE(FOnEnemyAttackCompleted);
@@ -59,6 +62,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	FName PelvisBoneName;
 
+	/** Damage modifiers, resistances and invulnerability applied by the damage pipeline */
+	UPROPERTY(EditAnywhere, Category="Damage")
+	FCombatDamageProfile DamageProfile;
+
 	/** Pointer to the life bar widget */
 	UPROPERTY(EditAnywhere, Category="Damage")
 	UCombatLifeBar* LifeBarWidget;
@@ -86,9 +93,9 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Damage", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm/s"))
 	float MeleeLaunchImpulse = 350.0f;
 
-	/** AnimMontage that will play for combo attacks */
+	/** AnimMontage that will play for combo attacks. Streamed in the background */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Combo")
-	UAnimMontage* ComboAttackMontage;
+	TSoftObjectPtr<UAnimMontage> ComboAttackMontage;
 
 	/** Names of the AnimMontage sections that correspond to each stage of the combo attack */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Combo")
@@ -100,9 +107,9 @@ protected:
 	/** Index of the current stage of the melee attack combo */
 	int32 CurrentComboAttack = 0;
 
-	/** AnimMontage that will play for charged attacks */
+	/** AnimMontage that will play for charged attacks. Streamed in the background */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Charged")
-	UAnimMontage* ChargedAttackMontage;
+	TSoftObjectPtr<UAnimMontage> ChargedAttackMontage;
 
 	/** Name of the AnimMontage section that corresponds to the charge loop */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Charged")
@@ -126,21 +133,30 @@ protected:
 	/** Number of charge animation loop currently playing */
 	int32 CurrentChargeLoop = 0;
 
+	/** Random stream used to pick attack lengths. Seeded by the replay subsystem so replays pick the same attacks */
+	FRandomStream AttackRandomStream;
+
 	/** Time to wait before removing this character from the level after it dies */
 	UPROPERTY(EditAnywhere, Category="Death")
 	float DeathRemovalTime = 5.0f;
 
-	/** Enemy death timer */
-	FTimerHandle DeathTimer;
+	/** Cooldown before the dead enemy is removed from the level */
+	FGameCooldownHandle DeathCooldown;
 
 	/** Attack montage ended delegate */
 	FOnMontageEnded OnAttackMontageEnded;
 
-	/** Last recorded location we're being attacked from */
-	FVector LastDangerLocation = FVector::ZeroVector;
+	/** Keeps the attack montages loaded while the enemy is alive */
+	TSharedPtr<FStreamableHandle> MontageLoadHandle;
+
+	/** Copy of the mesh's relative transform so we can reset it after ragdoll physics */
+	FTransform MeshStartingTransform;
+
+	/** If true, this enemy is owned by the enemy pool and will be returned to it instead of destroyed */
+	bool bIsPooled = false;
 
-	/** Last recorded game time we were attacked */
-	float LastDangerTime = -1000.0f;
+	/** If true, this enemy is currently deactivated and parked in the enemy pool */
+	bool bIsInPool = false;
 
 public:
 	/** Attack completed internal delegate to notify StateTree tasks */
@@ -164,12 +180,18 @@ public:
 	/** Called from a delegate when the attack montage ends */
 	void AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted);
 
+	/** Starts a new attack swing so its traces can hit each target once */
+	void BeginAttackSwing();
+
 	/** Returns the last recorded location we were attacked from */
-	const FVector& GetLastDangerLocation() const;
+	FVector GetLastDangerLocation() const;
 
 	/** Returns the last game time we were attacked */
 	float GetLastDangerTime() const;
 
+	/** Adds the assets this enemy streams in, such as its attack montages, to the list */
+	void GetPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const;
+
 public:
 
 	// ~begin ICombatAttacker interface
@@ -177,6 +199,9 @@ public:
 	/** Performs an attack's collision check */
 	virtual void DoAttackTrace(FName DamageSourceBone) override;
 
+	/** Applies damage and effects to an actor hit by an attack */
+	virtual void ApplyAttackHit(const FHitResult& Hit) override;
+
 	/** Performs a combo attack's check to continue the string */
 	UFUNCTION(BlueprintCallable, Category="Attacker")
 	virtual void CheckCombo() override;
@@ -208,6 +233,29 @@ protected:
 	/** Removes this character from the level after it dies */
 	void RemoveFromLevel();
 
+public:
+
+	/** Flags this enemy as owned by the enemy pool */
+	void SetPooled(bool bPooled) { bIsPooled = bPooled; }
+
+	/** Returns true if this enemy is currently parked in the enemy pool */
+	bool IsInPool() const { return bIsInPool; }
+
+	/** Returns true if this enemy has run out of HP */
+	bool IsDead() const { return CurrentHP <= 0.0f; }
+
+	/** Hides and disables the enemy so it can be parked in the enemy pool */
+	void DeactivateForPool();
+
+	/** Resets HP, ragdoll, life bar and StateTree so a parked enemy can be reused at the given transform */
+	void ActivateFromPool(const FTransform& SpawnTransform);
+
+	/** Returns the max amount of HP the character will have on respawn */
+	float GetMaxHP() const { return MaxHP; }
+
+	/** Sets the current HP and updates the life bar. Used to carry HP over from crowd entities */
+	void SetHP(float NewHP);
+
 public:
 
 	/** Overrides the default TakeDamage functionality */
@@ -2,12 +2,15 @@
 
 
 #include "CombatEnemySpawner.h"
+#include "CombatStats.h"
 #include "Engine/World.h"
 #include "Components/SceneComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/ArrowComponent.h"
-#include "TimerManager.h"
 #include "CombatEnemy.h"
+#include "CombatEnemyPoolSubsystem.h"
+#include "CombatCrowdSubsystem.h"
+#include "CombatReplaySubsystem.h"
 
 ACombatEnemySpawner::ACombatEnemySpawner()
 {
@@ -31,46 +34,150 @@ ACombatEnemySpawner::ACombatEnemySpawner()
 void ACombatEnemySpawner::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// seed the crowd scatter
+	ScatterRandomStream.Initialize(UCombatReplaySubsystem::MakeSeed(this));
+
+	// create our enemies ahead of time so spawning them later doesn't hitch
+	if (UCombatEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UCombatEnemyPoolSubsystem>())
+	{
+		Pool->Prewarm(EnemyClass, FMath::Min(PoolPrewarmCount, SpawnCount), SpawnCapsule->GetComponentTransform());
+	}
 	
 	// should we spawn an enemy right away?
 	if (bShouldSpawnEnemiesImmediately)
 	{
 		// schedule the first enemy spawn
-		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, InitialSpawnDelay);
+		if (UGameCooldownSubsystem* Cooldowns = GetWorld()->GetSubsystem<UGameCooldownSubsystem>())
+		{
+			Cooldowns->SetCooldown(SpawnCooldown, InitialSpawnDelay, FSimpleDelegate::CreateUObject(this, &ACombatEnemySpawner::SpawnEnemy));
+		}
 	}
 
 }
 
-void ACombatEnemySpawner::EndPlay(EEndPlayReason::Type EndPlayReason)
+void ACombatEnemySpawner::SpawnEnemy()
 {
-	Super::EndPlay(EndPlayReason);
+	COMBAT_SCOPE_CYCLE_COUNTER(SpawnerEvents);
 
-	// clear the spawn timer
-	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
-}
+	// spawn everything into the crowd if requested
+	if (bSpawnAsCrowd && SpawnCrowd())
+	{
+		return;
+	}
 
-void ACombatEnemySpawner::SpawnEnemy()
-{
 	// ensure the enemy class is valid
 	if (IsValid(EnemyClass))
 	{
-		// spawn the enemy at the reference capsule's transform
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		ACombatEnemy* SpawnedEnemy = nullptr;
+
+		// get the enemy from the pool at the reference capsule's transform
+		if (UCombatEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UCombatEnemyPoolSubsystem>())
+		{
+			SpawnedEnemy = Pool->AcquireEnemy(EnemyClass, SpawnCapsule->GetComponentTransform());
+		}
+		else
+		{
+			// no pool in this world, so spawn the enemy directly
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-		ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+			SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+		}
 
 		// was the enemy successfully created?
 		if (SpawnedEnemy)
 		{
 			// subscribe to the death delegate
-			SpawnedEnemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+			AdoptEnemy(SpawnedEnemy);
+		}
+	}
+}
+
+bool ACombatEnemySpawner::SpawnCrowd()
+{
+	UCombatCrowdSubsystem* Crowd = GetWorld()->GetSubsystem<UCombatCrowdSubsystem>();
+
+	// ensure we have a crowd and an enemy class
+	if (!Crowd || !IsValid(EnemyClass))
+	{
+		return false;
+	}
+
+	const FVector Origin = SpawnCapsule->GetComponentLocation();
+	const float Yaw = SpawnDirection->GetComponentRotation().Yaw;
+
+	// scatter the enemies around the spawn capsule
+	for (int32 i = 0; i < SpawnCount; ++i)
+	{
+		const float Angle = ScatterRandomStream.FRandRange(0.0f, UE_TWO_PI);
+		const float Distance = CrowdSettings.SpawnRadius * FMath::Sqrt(ScatterRandomStream.FRand());
+		const FVector2D Offset(Distance * FMath::Cos(Angle), Distance * FMath::Sin(Angle));
+
+		if (!Crowd->AddEntity(this, EnemyClass, Origin + FVector(Offset, 0.0f), Yaw))
+		{
+			// nothing made it in, so fall back to spawning actors
+			if (i == 0)
+			{
+				return false;
+			}
+
+			// only wait for the deaths of the enemies that actually made it into the crowd
+			SpawnCount = i;
+			break;
+		}
+	}
+
+	bSpawnedCrowd = true;
+
+	return true;
+}
+
+void ACombatEnemySpawner::AdoptEnemy(ACombatEnemy* Enemy)
+{
+	if (Enemy)
+	{
+		Enemy->OnEnemyDied.AddUniqueDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+		AdoptedEnemies.AddUnique(Enemy);
+	}
+}
+
+void ACombatEnemySpawner::ReleaseEnemy(ACombatEnemy* Enemy)
+{
+	if (Enemy)
+	{
+		// only remove our own binding, other subscribers keep theirs
+		Enemy->OnEnemyDied.RemoveDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+		AdoptedEnemies.Remove(Enemy);
+	}
+}
+
+void ACombatEnemySpawner::ReleaseDeadEnemies()
+{
+	for (int32 i = AdoptedEnemies.Num() - 1; i >= 0; --i)
+	{
+		ACombatEnemy* Enemy = AdoptedEnemies[i].Get();
+
+		if (!Enemy || Enemy->IsDead() || Enemy->IsInPool())
+		{
+			// only remove our own binding, other subscribers keep theirs
+			if (Enemy)
+			{
+				Enemy->OnEnemyDied.RemoveDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+			}
+
+			AdoptedEnemies.RemoveAtSwap(i, EAllowShrinking::No);
 		}
 	}
 }
 
 void ACombatEnemySpawner::OnEnemyDied()
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(SpawnerEvents);
+
+	// stop listening to the enemy that just died
+	ReleaseDeadEnemies();
+
 	// decrease the spawn counter
 	--SpawnCount;
 
@@ -78,16 +185,30 @@ void ACombatEnemySpawner::OnEnemyDied()
 	if (SpawnCount <= 0)
 	{
 		// schedule the activation on depleted message
-		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnerDepleted, ActivationDelay);
+		if (UGameCooldownSubsystem* Cooldowns = GetWorld()->GetSubsystem<UGameCooldownSubsystem>())
+		{
+			Cooldowns->SetCooldown(SpawnCooldown, ActivationDelay, FSimpleDelegate::CreateUObject(this, &ACombatEnemySpawner::SpawnerDepleted));
+		}
+		return;
+	}
+
+	// crowd enemies are all spawned at once, so there's nothing to respawn
+	if (bSpawnedCrowd)
+	{
 		return;
 	}
 
 	// schedule the next enemy spawn
-	GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, RespawnDelay);
+	if (UGameCooldownSubsystem* Cooldowns = GetWorld()->GetSubsystem<UGameCooldownSubsystem>())
+	{
+		Cooldowns->SetCooldown(SpawnCooldown, RespawnDelay, FSimpleDelegate::CreateUObject(this, &ACombatEnemySpawner::SpawnEnemy));
+	}
 }
 
 void ACombatEnemySpawner::SpawnerDepleted()
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(SpawnerEvents);
+
 	// process the actors to activate list
 	for (AActor* CurrentActor : ActorsToActivateWhenDepleted)
 	{
@@ -100,6 +221,15 @@ void ACombatEnemySpawner::SpawnerDepleted()
 	}
 }
 
+void ACombatEnemySpawner::SetupSpawner(TSubclassOf<ACombatEnemy> InEnemyClass, int32 InSpawnCount, float InInitialSpawnDelay, bool bInSpawnAsCrowd)
+{
+	EnemyClass = InEnemyClass;
+	SpawnCount = InSpawnCount;
+	InitialSpawnDelay = InInitialSpawnDelay;
+	bSpawnAsCrowd = bInSpawnAsCrowd;
+	bShouldSpawnEnemiesImmediately = true;
+}
+
 void ACombatEnemySpawner::ToggleInteraction(AActor* ActivationInstigator)
 {
 	// stub
@@ -5,11 +5,39 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatActivatable.h"
+#include "GameCooldownSubsystem.h"
+#include "Math/RandomStream.h"
 #include "CombatEnemySpawner.generated.h"
 
 class UCapsuleComponent;
 class UArrowComponent;
 class ACombatEnemy;
+class UStaticMesh;
+
+/**
+ *  Settings for enemies spawned into the crowd instead of as full actors
+ */
+USTRUCT(BlueprintType)
+struct FCombatEnemyCrowdSettings
+{
+	GENERATED_BODY()
+
+	/** Optional mesh used to render the enemies while they're in crowd mode */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Crowd")
+	TObjectPtr<UStaticMesh> ProxyMesh;
+
+	/** Radius around the spawner the crowd will be scattered in */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Crowd", meta = (ClampMin = 0, ClampMax = 5000, Units = "cm"))
+	float SpawnRadius = 500.0f;
+
+	/** Movement speed while in crowd mode */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Crowd", meta = (ClampMin = 0, ClampMax = 2000, Units = "cm/s"))
+	float MoveSpeed = 300.0f;
+
+	/** Distance to the player at which crowd enemies stop and wait to be promoted. Enemies in the crowd can't attack */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Crowd", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm"))
+	float AttackRange = 150.0f;
+};
 
 /**
  *  A basic Actor in charge of spawning Enemy Characters and monitoring their deaths.
@@ -50,6 +78,24 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 0, ClampMax = 10))
 	float RespawnDelay = 5.0f;
 
+	/** Number of enemies to create ahead of time in the enemy pool, so spawning doesn't construct new actors */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner|Pooling", meta = (ClampMin = 0, ClampMax = 100))
+	int32 PoolPrewarmCount = 2;
+
+	/** If true, all enemies will be spawned at once as lightweight crowd entities, and promoted to full actors near the player */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner|Crowd")
+	bool bSpawnAsCrowd = false;
+
+	/** Settings for crowd enemies */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner|Crowd", meta = (EditCondition = "bSpawnAsCrowd"))
+	FCombatEnemyCrowdSettings CrowdSettings;
+
+	/** If true, this spawner's enemies were spawned into the crowd */
+	bool bSpawnedCrowd = false;
+
+	/** Random stream used to scatter crowd entities. Seeded by the replay subsystem */
+	FRandomStream ScatterRandomStream;
+
 	/** Time to wait after this spawner is depleted before activating the actor list */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Activation", meta = (ClampMin = 0, ClampMax = 10))
 	float ActivationDelay = 1.0f;
@@ -61,8 +107,11 @@ protected:
 	/** Flag to ensure this is only activated once */
 	bool bHasBeenActivated = false;
 
-	/** Timer to spawn enemies after a delay */
-	FTimerHandle SpawnTimer;
+	/** Cooldown to spawn enemies after a delay */
+	FGameCooldownHandle SpawnCooldown;
+
+	/** Enemies whose death we're subscribed to */
+	TArray<TWeakObjectPtr<ACombatEnemy>> AdoptedEnemies;
 
 public:	
 	
@@ -74,9 +123,6 @@ public:
 	/** Initialization */
 	virtual void BeginPlay() override;
 
-	/** Cleanup */
-	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
-
 protected:
 
 	/** Spawn an enemy and subscribe to its death event */
@@ -89,6 +135,29 @@ protected:
 	/** Called after the last spawned enemy has died */
 	void SpawnerDepleted();
 
+	/** Scatters the remaining enemies into the crowd. Returns false if none could be added. On partial failure the spawn count is lowered to match */
+	bool SpawnCrowd();
+
+	/** Unsubscribes from adopted enemies that have died, so pooled enemies don't report to us in their next life */
+	void ReleaseDeadEnemies();
+
+public:
+
+	/** Returns the settings for crowd enemies */
+	const FCombatEnemyCrowdSettings& GetCrowdSettings() const { return CrowdSettings; }
+
+	/** Subscribes to the death of an enemy spawned on our behalf, such as a promoted crowd enemy */
+	void AdoptEnemy(ACombatEnemy* Enemy);
+
+	/** Unsubscribes from an adopted enemy that's leaving our control without dying, such as a demoted crowd enemy */
+	void ReleaseEnemy(ACombatEnemy* Enemy);
+
+	/** Returns the type of enemy to spawn */
+	TSubclassOf<ACombatEnemy> GetEnemyClass() const { return EnemyClass; }
+
+	/** Configures a spawner created at runtime. Must be called before BeginPlay */
+	void SetupSpawner(TSubclassOf<ACombatEnemy> InEnemyClass, int32 InSpawnCount, float InInitialSpawnDelay, bool bInSpawnAsCrowd);
+
 public:
 
 	// ~begin ICombatActivatable interface
@@ -2,6 +2,7 @@
 
 
 #include "CombatStateTreeUtility.h"
+#include "CombatStats.h"
 #include "StateTreeExecutionContext.h"
 #include "StateTreeExecutionTypes.h"
 #include "Engine/World.h"
@@ -9,11 +10,16 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "AIController.h"
 #include "CombatEnemy.h"
-#include "Kismet/GameplayStatics.h"
+#include "CombatSpatialSubsystem.h"
+#include "CombatQuerySubsystem.h"
+#include "CombatSightSubsystem.h"
+#include "PlayerSnapshotSubsystem.h"
 #include "StateTreeAsyncExecutionContext.h"
 
 bool FStateTreeCharacterGroundedCondition::TestCondition(FStateTreeExecutionContext& Context) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeConditions);
+
 	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
 	// is the character currently grounded?
@@ -33,23 +39,24 @@ FText FStateTreeCharacterGroundedCondition::GetDescription(const FGuid& ID, FSta
 
 bool FStateTreeIsInDangerCondition::TestCondition(FStateTreeExecutionContext& Context) const
 {
-	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeConditions);
+
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
 	// ensure we have a valid enemy character
 	if (InstanceData.Character)
 	{
-		// is the last detected danger event within the reaction threshold?
-		const float ReactionDelta = InstanceData.Character->GetWorld()->GetTimeSeconds() - InstanceData.Character->GetLastDangerTime();
-
-		if (ReactionDelta < InstanceData.MaxReactionTime && ReactionDelta > InstanceData.MinReactionTime)
+		// check the danger record kept by the spatial index
+		if (const UCombatSpatialSubsystem* Spatial = InstanceData.Character->GetWorld()->GetSubsystem<UCombatSpatialSubsystem>())
 		{
-			// do a dot product check to determine if the danger location is within the character's detection cone
-			const FVector DangerDir = (InstanceData.Character->GetLastDangerLocation() - InstanceData.Character->GetActorLocation()).GetSafeNormal2D();
-
-			const float DangerDot = FVector::DotProduct(DangerDir, InstanceData.Character->GetActorForwardVector());
-			const float ConeAngleCos = FMath::Cos(FMath::DegreesToRadians(InstanceData.DangerSightConeAngle));
+			// only recompute the cone cosine when the angle changes
+			if (InstanceData.DangerSightConeAngle != InstanceData.CachedConeAngle)
+			{
+				InstanceData.CachedConeAngle = InstanceData.DangerSightConeAngle;
+				InstanceData.CachedConeCos = FMath::Cos(FMath::DegreesToRadians(InstanceData.DangerSightConeAngle));
+			}
 
-			return DangerDot > ConeAngleCos;
+			return Spatial->IsInDanger(InstanceData.Character, InstanceData.MinReactionTime, InstanceData.MaxReactionTime, InstanceData.CachedConeCos);
 		}
 	}
 
@@ -65,8 +72,45 @@ FText FStateTreeIsInDangerCondition::GetDescription(const FGuid& ID, FStateTreeD
 
 ////////////////////////////////////////////////////////////////////
 
+bool FStateTreeHasLineOfSightCondition::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeConditions);
+
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// ensure we have a valid enemy character and target
+	if (InstanceData.Character && InstanceData.Target)
+	{
+		// read the cached result from the sight service
+		if (UCombatSightSubsystem* Sight = InstanceData.Character->GetWorld()->GetSubsystem<UCombatSightSubsystem>())
+		{
+			bool bHasLineOfSight = false;
+
+			if (Sight->QueryLineOfSight(InstanceData.Character, InstanceData.Target, bHasLineOfSight))
+			{
+				return bHasLineOfSight;
+			}
+
+			return InstanceData.bAssumeVisibleWhenUnknown;
+		}
+	}
+
+	return false;
+}
+
+#if WITH_EDITOR
+FText FStateTreeHasLineOfSightCondition::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Has Line of Sight</b>");
+}
+#endif // WITH_EDITOR
+
+////////////////////////////////////////////////////////////////////
+
 EStateTreeRunStatus FStateTreeComboAttackTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// have we transitioned from another state?
 	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
 	{
@@ -91,6 +135,8 @@ EStateTreeRunStatus FStateTreeComboAttackTask::EnterState(FStateTreeExecutionCon
 
 void FStateTreeComboAttackTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// have we transitioned from another state?
 	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
 	{
@@ -113,6 +159,8 @@ FText FStateTreeComboAttackTask::GetDescription(const FGuid& ID, FStateTreeDataV
 
 EStateTreeRunStatus FStateTreeChargedAttackTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// have we transitioned from another state?
 	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
 	{
@@ -136,6 +184,8 @@ EStateTreeRunStatus FStateTreeChargedAttackTask::EnterState(FStateTreeExecutionC
 
 void FStateTreeChargedAttackTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// have we transitioned from another state?
 	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
 	{
@@ -158,6 +208,8 @@ FText FStateTreeChargedAttackTask::GetDescription(const FGuid& ID, FStateTreeDat
 
 EStateTreeRunStatus FStateTreeWaitForLandingTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// have we transitioned from another state?
 	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
 	{
@@ -178,6 +230,8 @@ EStateTreeRunStatus FStateTreeWaitForLandingTask::EnterState(FStateTreeExecution
 
 void FStateTreeWaitForLandingTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// have we transitioned from another state?
 	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
 	{
@@ -200,6 +254,8 @@ FText FStateTreeWaitForLandingTask::GetDescription(const FGuid& ID, FStateTreeDa
 
 EStateTreeRunStatus FStateTreeFaceActorTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// have we transitioned from another state?
 	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
 	{
@@ -215,6 +271,8 @@ EStateTreeRunStatus FStateTreeFaceActorTask::EnterState(FStateTreeExecutionConte
 
 void FStateTreeFaceActorTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// have we transitioned to another state?
 	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
 	{
@@ -237,6 +295,8 @@ FText FStateTreeFaceActorTask::GetDescription(const FGuid& ID, FStateTreeDataVie
 
 EStateTreeRunStatus FStateTreeFaceLocationTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// have we transitioned from another state?
 	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
 	{
@@ -252,6 +312,8 @@ EStateTreeRunStatus FStateTreeFaceLocationTask::EnterState(FStateTreeExecutionCo
 
 void FStateTreeFaceLocationTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// have we transitioned to another state?
 	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
 	{
@@ -274,6 +336,8 @@ FText FStateTreeFaceLocationTask::GetDescription(const FGuid& ID, FStateTreeData
 
 EStateTreeRunStatus FStateTreeSetCharacterSpeedTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// have we transitioned from another state?
 	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
 	{
@@ -298,21 +362,32 @@ FText FStateTreeSetCharacterSpeedTask::GetDescription(const FGuid& ID, FStateTre
 
 EStateTreeRunStatus FStateTreeGetPlayerInfoTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
 	// get the instance data
 	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-	// get the character possessed by the first local player
-	InstanceData.TargetPlayerCharacter = Cast<ACharacter>(UGameplayStatics::GetPlayerPawn(InstanceData.Character, 0));
-
-	// do we have a valid target?
-	if (InstanceData.TargetPlayerCharacter)
+	// read the shared player snapshot for this frame
+	if (const FPlayerSnapshot* PlayerSnapshot = UPlayerSnapshotSubsystem::Get(InstanceData.Character))
 	{
-		// update the last known location
-		InstanceData.TargetPlayerLocation = InstanceData.TargetPlayerCharacter->GetActorLocation();
+		// get the character possessed by the first local player
+		InstanceData.TargetPlayerCharacter = PlayerSnapshot->Character;
+
+		// do we have a valid target?
+		if (InstanceData.TargetPlayerCharacter)
+		{
+			// update the last known location
+			InstanceData.TargetPlayerLocation = PlayerSnapshot->Location;
+		}
 	}
 
 	// update the distance
-	InstanceData.DistanceToTarget = FVector::Distance(InstanceData.TargetPlayerLocation, InstanceData.Character->GetActorLocation());
+	InstanceData.DistanceSquaredToTarget = FVector::DistSquared(InstanceData.TargetPlayerLocation, InstanceData.Character->GetActorLocation());
+
+	if (InstanceData.bComputeDistance)
+	{
+		InstanceData.DistanceToTarget = FMath::Sqrt(InstanceData.DistanceSquaredToTarget);
+	}
 
 	return EStateTreeRunStatus::Running;
 }
@@ -322,4 +397,96 @@ FText FStateTreeGetPlayerInfoTask::GetDescription(const FGuid& ID, FStateTreeDat
 {
 	return FText::FromString("<b>Get Player Info</b>");
 }
-#endif // WITH_EDITOR
\ No newline at end of file
+#endif // WITH_EDITOR
+
+////////////////////////////////////////////////////////////////////
+
+EStateTreeRunStatus FStateTreeSharedEnvQueryTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	InstanceData.bFinished = false;
+	InstanceData.bSucceeded = false;
+
+	ACombatEnemy* Querier = Cast<ACombatEnemy>(InstanceData.QueryOwner);
+	UCombatQuerySubsystem* Query = Querier ? Querier->GetWorld()->GetSubsystem<UCombatQuerySubsystem>() : nullptr;
+
+	if (!Query || !InstanceData.QueryTemplate)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	// queue the request. The result is written back into the instance data once it resolves
+	InstanceData.RequestId = Query->RequestQuery(Querier, InstanceData.QueryTemplate, FOnCombatQueryFinished::CreateLambda(
+		[InstanceDataRef = Context.GetInstanceDataStructRef(*this)](bool bSuccess, const FVector& Location) mutable
+		{
+			if (FInstanceDataType* Data = InstanceDataRef.GetPtr())
+			{
+				Data->RequestId = INDEX_NONE;
+				Data->bFinished = true;
+				Data->bSucceeded = bSuccess;
+
+				if (bSuccess)
+				{
+					Data->ResultLocation = Location;
+				}
+			}
+		}
+	), InstanceData.RunMode, InstanceData.QueryConfig);
+
+	return InstanceData.RequestId != INDEX_NONE ? EStateTreeRunStatus::Running : EStateTreeRunStatus::Failed;
+}
+
+EStateTreeRunStatus FStateTreeSharedEnvQueryTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
+	// get the instance data
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// wait for the request to resolve
+	if (!InstanceData.bFinished)
+	{
+		return EStateTreeRunStatus::Running;
+	}
+
+	// the result can only be written to the bound property from inside the tree's execution
+	if (InstanceData.bSucceeded)
+	{
+		if (FVector* ResultLocation = InstanceData.Result.GetMutablePtr<FVector>(Context))
+		{
+			*ResultLocation = InstanceData.ResultLocation;
+		}
+	}
+
+	return InstanceData.bSucceeded ? EStateTreeRunStatus::Succeeded : EStateTreeRunStatus::Failed;
+}
+
+void FStateTreeSharedEnvQueryTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(StateTreeTasks);
+
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// cancel the request if it's still queued
+	if (InstanceData.RequestId != INDEX_NONE && InstanceData.QueryOwner)
+	{
+		if (UCombatQuerySubsystem* Query = InstanceData.QueryOwner->GetWorld()->GetSubsystem<UCombatQuerySubsystem>())
+		{
+			Query->CancelQuery(InstanceData.RequestId);
+		}
+
+		InstanceData.RequestId = INDEX_NONE;
+	}
+}
+
+#if WITH_EDITOR
+FText FStateTreeSharedEnvQueryTask::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Run Shared Env Query</b>");
+}
+#endif // WITH_EDITOR
@@ -5,12 +5,16 @@
 #include "CoreMinimal.h"
 #include "StateTreeTaskBase.h"
 #include "StateTreeConditionBase.h"
+#include "StateTreePropertyRef.h"
+#include "EnvironmentQuery/EnvQueryTypes.h"
+#include "DataProviders/AIDataProvider.h"
 
 #include "CombatStateTreeUtility.generated.h"
 
 class ACharacter;
 class AAIController;
 class ACombatEnemy;
+class UEnvQuery;
 
 /**
  *  Instance data struct for the FStateTreeCharacterGroundedCondition condition
@@ -81,6 +85,12 @@ struct FStateTreeIsInDangerConditionInstanceData
 	/** Line of sight half angle for detecting incoming danger, in degrees*/
 	UPROPERTY(EditAnywhere, Category = "Parameters", meta = (Units = "degrees"))
 	float DangerSightConeAngle = 120.0f;
+
+	/** Cone angle the cached cosine was computed for. The angle can be bound, so it's checked on every test */
+	float CachedConeAngle = -1.0f;
+
+	/** Cosine of the danger sight cone angle */
+	float CachedConeCos = 0.0f;
 };
 STATETREE_POD_INSTANCEDATA(FStateTreeIsInDangerConditionInstanceData);
 
@@ -112,6 +122,56 @@ struct FStateTreeIsInDangerCondition : public FStateTreeConditionCommonBase
 
 ////////////////////////////////////////////////////////////////////
 
+/**
+ *  Instance data struct for the FStateTreeHasLineOfSightCondition condition
+ */
+USTRUCT()
+struct FStateTreeHasLineOfSightConditionInstanceData
+{
+	GENERATED_BODY()
+
+	/** Character doing the looking */
+	UPROPERTY(EditAnywhere, Category = "Context")
+	TObjectPtr<ACombatEnemy> Character;
+
+	/** Actor to check line of sight to */
+	UPROPERTY(EditAnywhere, Category = "Input")
+	TObjectPtr<AActor> Target;
+
+	/** Result to use until the sight service has traced the target */
+	UPROPERTY(EditAnywhere, Category = "Parameters")
+	bool bAssumeVisibleWhenUnknown = false;
+};
+
+/**
+ *  StateTree condition to check if the character can see an actor.
+ *  Results come from the combat sight service cache, so they can be a few frames old.
+ */
+USTRUCT(DisplayName = "Character has Line of Sight")
+struct FStateTreeHasLineOfSightCondition : public FStateTreeConditionCommonBase
+{
+	GENERATED_BODY()
+
+	/** Set the instance data type */
+	using FInstanceDataType = FStateTreeHasLineOfSightConditionInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Default constructor */
+	FStateTreeHasLineOfSightCondition() = default;
+
+	/** Tests the StateTree condition */
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+
+#if WITH_EDITOR
+
+	/** Provides the description string */
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif
+
+};
+
+////////////////////////////////////////////////////////////////////
+
 /**
  *  Instance data struct for the Combat StateTree tasks
  */
@@ -342,6 +402,14 @@ struct FStateTreeGetPlayerInfoInstanceData
 	/** Distance to the target */
 	UPROPERTY(VisibleAnywhere)
 	float DistanceToTarget = 0.0f;
+
+	/** Squared distance to the target. Cheaper to compare against squared thresholds */
+	UPROPERTY(VisibleAnywhere)
+	float DistanceSquaredToTarget = 0.0f;
+
+	/** If false, only the squared distance will be updated, skipping the square root */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	bool bComputeDistance = true;
 };
 
 /**
@@ -362,4 +430,76 @@ struct FStateTreeGetPlayerInfoTask : public FStateTreeTaskCommonBase
 #if WITH_EDITOR
 	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
 #endif // WITH_EDITOR
-};
\ No newline at end of file
+};
+
+////////////////////////////////////////////////////////////////////
+
+/**
+ *  Instance data struct for the Run Shared Env Query task
+ */
+USTRUCT()
+struct FStateTreeSharedEnvQueryInstanceData
+{
+	GENERATED_BODY()
+
+	/** Enemy that will run the query. Must be a combat enemy */
+	UPROPERTY(EditAnywhere, Category = Context)
+	TObjectPtr<AActor> QueryOwner;
+
+	/** Query template to run */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	TObjectPtr<UEnvQuery> QueryTemplate;
+
+	/** Query config overrides. Only requests with the same overrides share a run */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	TArray<FAIDynamicParam> QueryConfig;
+
+	/** Receives the result point reserved for this enemy */
+	UPROPERTY(EditAnywhere, Category = Output, meta = (RefType = "/Script/CoreUObject.Vector"))
+	FStateTreePropertyRef Result;
+
+	/** How the result point is picked from the shared run */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	TEnumAsByte<EEnvQueryRunMode::Type> RunMode = EEnvQueryRunMode::SingleResult;
+
+	/** Result point reserved for this enemy, copied to Result once the request resolves */
+	FVector ResultLocation = FVector::ZeroVector;
+
+	/** Handle for the queued request */
+	int32 RequestId = INDEX_NONE;
+
+	/** Set once the request resolves */
+	bool bFinished = false;
+
+	/** Set if the request found a result point */
+	bool bSucceeded = false;
+};
+
+/**
+ *  StateTree task to run an EQS query through the shared combat query cache.
+ *  Enemies with near-identical contexts share a single query run and each reserve a distinct result point.
+ *  Its properties mirror the stock Run Env Query task, which is redirected to it in DefaultEngine.ini
+ *  so the enemy StateTree's existing queries go through the cache with their bindings intact.
+ */
+USTRUCT(meta=(DisplayName="Run Shared Env Query", Category="Combat"))
+struct FStateTreeSharedEnvQueryTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	/* Ensure we're using the correct instance data struct */
+	using FInstanceDataType = FStateTreeSharedEnvQueryInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Runs when the owning state is entered */
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+	/** Runs while the owning state is active */
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+
+	/** Runs when the owning state is ended */
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+#if WITH_EDITOR
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif // WITH_EDITOR
+};
@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatWaveData.h"
+#include "CombatEnemy.h"
+
+int32 FCombatWave::GetTotalCount() const
+{
+	int32 Total = 0;
+
+	for (const FCombatWaveGroup& Group : Groups)
+	{
+		Total += FMath::Max(Group.Count, 0);
+	}
+
+	return Total;
+}
+
+void UCombatWaveData::GetWaveAssets(int32 WaveIndex, TArray<FSoftObjectPath>& OutPaths) const
+{
+	if (!Waves.IsValidIndex(WaveIndex))
+	{
+		return;
+	}
+
+	for (const FCombatWaveGroup& Group : Waves[WaveIndex].Groups)
+	{
+		if (!Group.EnemyClass.IsNull())
+		{
+			OutPaths.AddUnique(Group.EnemyClass.ToSoftObjectPath());
+		}
+	}
+}
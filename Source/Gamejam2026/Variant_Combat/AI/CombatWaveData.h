@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CombatWaveData.generated.h"
+
+class ACombatEnemy;
+
+/**
+ *  A group of enemies of the same class in a wave
+ */
+USTRUCT(BlueprintType)
+struct FCombatWaveGroup
+{
+	GENERATED_BODY()
+
+	/** Type of enemy to spawn. Loaded in the background before the wave starts */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Wave")
+	TSoftClassPtr<ACombatEnemy> EnemyClass;
+
+	/** Number of enemies of this class to spawn */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Wave", meta = (ClampMin = 0, ClampMax = 200))
+	int32 Count = 1;
+};
+
+/**
+ *  A single wave of enemies
+ */
+USTRUCT(BlueprintType)
+struct FCombatWave
+{
+	GENERATED_BODY()
+
+	/** Enemies to spawn in this wave. Groups are interleaved so the classes are mixed as they arrive */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Wave")
+	TArray<FCombatWaveGroup> Groups;
+
+	/** Maximum number of enemies from this wave alive at the same time. Zero for no limit */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Wave", meta = (ClampMin = 0, ClampMax = 200))
+	int32 MaxAlive = 20;
+
+	/** Maximum number of enemies this wave can spawn in a single frame. Zero uses the global budget */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Wave", meta = (ClampMin = 0, ClampMax = 20))
+	int32 MaxSpawnsPerFrame = 0;
+
+	/** Time to wait after the previous wave is cleared before starting this one */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Wave", meta = (ClampMin = 0, ClampMax = 60, Units = "s"))
+	float StartDelay = 3.0f;
+
+	/** Returns the total number of enemies in the wave */
+	int32 GetTotalCount() const;
+};
+
+/**
+ *  Wave definitions for a combat encounter, played back by ACombatWaveDirector
+ */
+UCLASS(BlueprintType)
+class UCombatWaveData : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Waves to play, in order */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Waves")
+	TArray<FCombatWave> Waves;
+
+	/** Number of waves past the current one whose enemy classes are loaded ahead of time */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Waves", meta = (ClampMin = 0, ClampMax = 5))
+	int32 PreloadAhead = 1;
+
+	/** Adds the soft class paths for the wave's enemies to the list */
+	void GetWaveAssets(int32 WaveIndex, TArray<FSoftObjectPath>& OutPaths) const;
+};
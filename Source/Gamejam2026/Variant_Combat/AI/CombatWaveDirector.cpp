@@ -0,0 +1,401 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatWaveDirector.h"
+#include "CombatStats.h"
+#include "CombatWaveData.h"
+#include "CombatEnemy.h"
+#include "CombatEnemyPoolSubsystem.h"
+#include "CombatReplaySubsystem.h"
+#include "Engine/World.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Algo/Reverse.h"
+#include "Components/SceneComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Gamejam2026.h"
+
+static int32 GCombatWavesSpawnsPerFrame = 2;
+static FAutoConsoleVariableRef CVarCombatWavesSpawnsPerFrame(
+	TEXT("Combat.Waves.SpawnsPerFrame"),
+	GCombatWavesSpawnsPerFrame,
+	TEXT("Maximum number of enemies a wave director spawns in a single frame, unless the wave overrides it"),
+	ECVF_Default
+);
+
+static float GCombatWavesSpawnBudgetMs = 2.0f;
+static FAutoConsoleVariableRef CVarCombatWavesSpawnBudgetMs(
+	TEXT("Combat.Waves.SpawnBudgetMs"),
+	GCombatWavesSpawnBudgetMs,
+	TEXT("Time a wave director can spend spawning enemies each frame, in milliseconds. At least one enemy spawns per frame"),
+	ECVF_Default
+);
+
+ACombatWaveDirector::ACombatWaveDirector()
+{
+	// only tick while enemies are waiting to spawn
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	// create the root
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ACombatWaveDirector::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// seed the spawn scatter
+	SpawnRandomStream.Initialize(UCombatReplaySubsystem::MakeSeed(this));
+
+	// start loading the first waves right away, so they're ready when the encounter starts
+	if (WaveData)
+	{
+		for (int32 WaveIndex = 0; WaveIndex <= WaveData->PreloadAhead; ++WaveIndex)
+		{
+			PreloadWave(WaveIndex);
+		}
+	}
+
+	// should we start right away?
+	if (bStartImmediately)
+	{
+		StartNextWave();
+	}
+}
+
+void ACombatWaveDirector::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// cancel any loads still in flight
+	for (const TPair<int32, TSharedPtr<FStreamableHandle>>& Pair : WaveLoadHandles)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->CancelHandle();
+		}
+	}
+
+	WaveLoadHandles.Empty();
+}
+
+void ACombatWaveDirector::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	COMBAT_SCOPE_CYCLE_COUNTER(SpawnerEvents);
+
+	const FCombatWave& Wave = WaveData->Waves[CurrentWave];
+
+	// work out how many enemies we can spawn this frame
+	int32 NumToSpawn = Wave.MaxSpawnsPerFrame > 0 ? Wave.MaxSpawnsPerFrame : GCombatWavesSpawnsPerFrame;
+
+	if (Wave.MaxAlive > 0)
+	{
+		NumToSpawn = FMath::Min(NumToSpawn, Wave.MaxAlive - NumAlive);
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 i = 0; i < NumToSpawn && SpawnQueue.Num() > 0; ++i)
+	{
+		// the queue is stored back to front
+		SpawnQueuedEnemy(SpawnQueue.Pop(EAllowShrinking::No));
+
+		// stop early if spawning is taking too long this frame
+		if ((FPlatformTime::Seconds() - StartTime) * 1000.0 >= GCombatWavesSpawnBudgetMs)
+		{
+			break;
+		}
+	}
+
+	// stop ticking once the whole wave is out
+	if (SpawnQueue.Num() == 0)
+	{
+		SetActorTickEnabled(false);
+
+		// every enemy failed to spawn, so don't wait for deaths that won't come
+		if (NumAlive <= 0)
+		{
+			StartNextWave();
+		}
+	}
+}
+
+void ACombatWaveDirector::PreloadWave(int32 WaveIndex)
+{
+	// skip waves that don't exist or are already loading
+	if (!WaveData || !WaveData->Waves.IsValidIndex(WaveIndex) || WaveLoadHandles.Contains(WaveIndex))
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> Paths;
+	WaveData->GetWaveAssets(WaveIndex, Paths);
+
+	if (Paths.Num() == 0)
+	{
+		return;
+	}
+
+	// the handle keeps the classes loaded until the wave is over
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths,
+		FStreamableDelegate::CreateUObject(this, &ACombatWaveDirector::OnWaveLoaded, WaveIndex));
+
+	WaveLoadHandles.Add(WaveIndex, Handle);
+}
+
+void ACombatWaveDirector::StartNextWave()
+{
+	// release the loads for the waves we're done with. Living enemies keep their classes referenced
+	for (auto It = WaveLoadHandles.CreateIterator(); It; ++It)
+	{
+		if (It.Key() <= CurrentWave)
+		{
+			if (It.Value().IsValid())
+			{
+				It.Value()->ReleaseHandle();
+			}
+
+			It.RemoveCurrent();
+		}
+	}
+
+	++CurrentWave;
+
+	// have we run out of waves?
+	if (!WaveData || !WaveData->Waves.IsValidIndex(CurrentWave))
+	{
+		// schedule the activation on depleted message
+		if (UGameCooldownSubsystem* Cooldowns = GetWorld()->GetSubsystem<UGameCooldownSubsystem>())
+		{
+			Cooldowns->SetCooldown(WaveCooldown, ActivationDelay, FSimpleDelegate::CreateUObject(this, &ACombatWaveDirector::WavesDepleted));
+		}
+		return;
+	}
+
+	// keep the loads ahead of the current wave
+	for (int32 WaveIndex = CurrentWave; WaveIndex <= CurrentWave + WaveData->PreloadAhead; ++WaveIndex)
+	{
+		PreloadWave(WaveIndex);
+	}
+
+	// schedule the wave start
+	const float StartDelay = WaveData->Waves[CurrentWave].StartDelay;
+
+	if (StartDelay > 0.0f)
+	{
+		if (UGameCooldownSubsystem* Cooldowns = GetWorld()->GetSubsystem<UGameCooldownSubsystem>())
+		{
+			Cooldowns->SetCooldown(WaveCooldown, StartDelay, FSimpleDelegate::CreateUObject(this, &ACombatWaveDirector::BeginWave));
+		}
+	}
+	else
+	{
+		BeginWave();
+	}
+}
+
+void ACombatWaveDirector::BeginWave()
+{
+	// wait for the enemy classes if they're still loading
+	const TSharedPtr<FStreamableHandle> Handle = WaveLoadHandles.FindRef(CurrentWave);
+
+	if (Handle.IsValid() && Handle->IsLoadingInProgress())
+	{
+		UE_LOG(LogGamejam2026, Log, TEXT("Wave director %s: wave %d is waiting for its enemy classes to load"), *GetName(), CurrentWave);
+
+		bWaitingForLoad = true;
+		return;
+	}
+
+	bWaitingForLoad = false;
+
+	const FCombatWave& Wave = WaveData->Waves[CurrentWave];
+
+	// resolve the loaded classes
+	TArray<TSubclassOf<ACombatEnemy>> GroupClasses;
+	TArray<int32> GroupCounts;
+
+	for (const FCombatWaveGroup& Group : Wave.Groups)
+	{
+		TSubclassOf<ACombatEnemy> EnemyClass = Group.EnemyClass.Get();
+
+		if (!EnemyClass)
+		{
+			UE_LOG(LogGamejam2026, Warning, TEXT("Wave director %s: couldn't load enemy class %s for wave %d"), *GetName(), *Group.EnemyClass.ToString(), CurrentWave);
+			continue;
+		}
+
+		GroupClasses.Add(EnemyClass);
+		GroupCounts.Add(FMath::Max(Group.Count, 0));
+	}
+
+	// interleave the groups so the classes arrive mixed. The queue is built back to front so it can be popped
+	SpawnQueue.Reset(Wave.GetTotalCount());
+
+	for (bool bAdded = true; bAdded; )
+	{
+		bAdded = false;
+
+		for (int32 GroupIndex = 0; GroupIndex < GroupClasses.Num(); ++GroupIndex)
+		{
+			if (GroupCounts[GroupIndex] > 0)
+			{
+				--GroupCounts[GroupIndex];
+				SpawnQueue.Add(GroupClasses[GroupIndex]);
+				bAdded = true;
+			}
+		}
+	}
+
+	Algo::Reverse(SpawnQueue);
+
+	// skip empty waves
+	if (SpawnQueue.Num() == 0)
+	{
+		StartNextWave();
+		return;
+	}
+
+	// spawn the wave over the next frames
+	SetActorTickEnabled(true);
+}
+
+void ACombatWaveDirector::OnWaveLoaded(int32 WaveIndex)
+{
+	// start the current wave if it was waiting on this load
+	if (bWaitingForLoad && WaveIndex == CurrentWave)
+	{
+		BeginWave();
+	}
+}
+
+bool ACombatWaveDirector::SpawnQueuedEnemy(TSubclassOf<ACombatEnemy> EnemyClass)
+{
+	// pick the next spawn point
+	FTransform SpawnTransform = GetActorTransform();
+
+	if (SpawnPoints.Num() > 0)
+	{
+		const AActor* SpawnPoint = SpawnPoints[NextSpawnPoint % SpawnPoints.Num()];
+		NextSpawnPoint = (NextSpawnPoint + 1) % SpawnPoints.Num();
+
+		if (SpawnPoint)
+		{
+			SpawnTransform = SpawnPoint->GetActorTransform();
+		}
+	}
+
+	// scatter around the spawn point
+	const float Angle = SpawnRandomStream.FRandRange(0.0f, UE_TWO_PI);
+	const float Distance = SpawnRadius * FMath::Sqrt(SpawnRandomStream.FRand());
+	SpawnTransform.AddToTranslation(FVector(Distance * FMath::Cos(Angle), Distance * FMath::Sin(Angle), 0.0f));
+
+	ACombatEnemy* SpawnedEnemy = nullptr;
+
+	// get the enemy from the pool
+	if (UCombatEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UCombatEnemyPoolSubsystem>())
+	{
+		SpawnedEnemy = Pool->AcquireEnemy(EnemyClass, SpawnTransform);
+	}
+	else
+	{
+		// no pool in this world, so spawn the enemy directly
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnTransform, SpawnParams);
+	}
+
+	if (!SpawnedEnemy)
+	{
+		return false;
+	}
+
+	// subscribe to the death delegate
+	SpawnedEnemy->OnEnemyDied.AddUniqueDynamic(this, &ACombatWaveDirector::OnEnemyDied);
+	SpawnedEnemies.AddUnique(SpawnedEnemy);
+	++NumAlive;
+
+	return true;
+}
+
+void ACombatWaveDirector::ReleaseDeadEnemies()
+{
+	for (int32 i = SpawnedEnemies.Num() - 1; i >= 0; --i)
+	{
+		ACombatEnemy* Enemy = SpawnedEnemies[i].Get();
+
+		if (!Enemy || Enemy->IsDead() || Enemy->IsInPool())
+		{
+			// only remove our own binding, other subscribers keep theirs
+			if (Enemy)
+			{
+				Enemy->OnEnemyDied.RemoveDynamic(this, &ACombatWaveDirector::OnEnemyDied);
+			}
+
+			SpawnedEnemies.RemoveAtSwap(i, EAllowShrinking::No);
+		}
+	}
+}
+
+void ACombatWaveDirector::OnEnemyDied()
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(SpawnerEvents);
+
+	// stop listening to the enemy that just died
+	ReleaseDeadEnemies();
+
+	--NumAlive;
+
+	// is the wave cleared?
+	if (NumAlive <= 0 && SpawnQueue.Num() == 0 && !bWaitingForLoad)
+	{
+		NumAlive = 0;
+		StartNextWave();
+	}
+}
+
+void ACombatWaveDirector::WavesDepleted()
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(SpawnerEvents);
+
+	// process the actors to activate list
+	for (AActor* CurrentActor : ActorsToActivateWhenDepleted)
+	{
+		// check if the actor is activatable
+		if (ICombatActivatable* CombatActivatable = Cast<ICombatActivatable>(CurrentActor))
+		{
+			// activate the actor
+			CombatActivatable->ActivateInteraction(this);
+		}
+	}
+}
+
+void ACombatWaveDirector::ToggleInteraction(AActor* ActivationInstigator)
+{
+	// stub
+}
+
+void ACombatWaveDirector::ActivateInteraction(AActor* ActivationInstigator)
+{
+	// ensure we're only activated once, and only if we've deferred the first wave
+	if (bHasBeenActivated || bStartImmediately)
+	{
+		return;
+	}
+
+	// raise the activation flag
+	bHasBeenActivated = true;
+
+	// start the first wave
+	StartNextWave();
+}
+
+void ACombatWaveDirector::DeactivateInteraction(AActor* ActivationInstigator)
+{
+	// stub
+}
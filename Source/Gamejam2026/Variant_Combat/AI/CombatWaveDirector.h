@@ -0,0 +1,149 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CombatActivatable.h"
+#include "GameCooldownSubsystem.h"
+#include "Math/RandomStream.h"
+#include "CombatWaveDirector.generated.h"
+
+class UCombatWaveData;
+class ACombatEnemy;
+struct FStreamableHandle;
+
+/**
+ *  Plays back the waves defined in a wave data asset.
+ *  Enemy classes are loaded in the background through soft references a few waves ahead of time,
+ *  and each wave's enemies are queued and spawned over several frames under a per-frame spawn budget,
+ *  respecting the wave's cap on enemies alive at once. The next wave starts once the current one is cleared.
+ *  The director can be remotely activated through the ICombatActivatable interface,
+ *  and activates other ICombatActivatables after the last wave is cleared.
+ */
+UCLASS()
+class ACombatWaveDirector : public AActor, public ICombatActivatable
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Waves to play */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Waves")
+	TObjectPtr<UCombatWaveData> WaveData;
+
+	/** Actors whose transforms enemies are spawned at, in turn. If empty, enemies spawn at the director */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Waves")
+	TArray<TObjectPtr<AActor>> SpawnPoints;
+
+	/** Radius around each spawn point enemies are scattered in, so consecutive spawns don't overlap */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Waves", meta = (ClampMin = 0, ClampMax = 2000, Units = "cm"))
+	float SpawnRadius = 200.0f;
+
+	/** If true, the first wave will start as soon as the game starts */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Waves")
+	bool bStartImmediately = false;
+
+	/** Time to wait after the last wave is cleared before activating the actor list */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Activation", meta = (ClampMin = 0, ClampMax = 10))
+	float ActivationDelay = 1.0f;
+
+	/** List of actors to activate after the last wave is cleared */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Activation")
+	TArray<AActor*> ActorsToActivateWhenDepleted;
+
+	/** Index of the current wave, or INDEX_NONE before the first one */
+	int32 CurrentWave = INDEX_NONE;
+
+	/** Enemy classes left to spawn in the current wave, in spawn order */
+	TArray<TSubclassOf<ACombatEnemy>> SpawnQueue;
+
+	/** Number of enemies from the current wave that are alive */
+	int32 NumAlive = 0;
+
+	/** Enemies whose death we're subscribed to */
+	TArray<TWeakObjectPtr<ACombatEnemy>> SpawnedEnemies;
+
+	/** Next spawn point to use */
+	int32 NextSpawnPoint = 0;
+
+	/** Background loads for the enemy classes of each wave */
+	TMap<int32, TSharedPtr<FStreamableHandle>> WaveLoadHandles;
+
+	/** If true, the current wave is waiting for its enemy classes to finish loading */
+	bool bWaitingForLoad = false;
+
+	/** Flag to ensure this is only activated once */
+	bool bHasBeenActivated = false;
+
+	/** Random stream used to mix the wave's classes and scatter spawns. Seeded by the replay subsystem */
+	FRandomStream SpawnRandomStream;
+
+	/** Cooldown for wave starts and the final activation */
+	FGameCooldownHandle WaveCooldown;
+
+public:
+
+	/** Constructor */
+	ACombatWaveDirector();
+
+	/** Initialization */
+	virtual void BeginPlay() override;
+
+	/** Cleanup */
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
+	/** Spawns queued enemies within the frame's budget */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the index of the current wave */
+	int32 GetCurrentWave() const { return CurrentWave; }
+
+	/** Returns the number of enemies from the current wave that are alive */
+	int32 GetNumAlive() const { return NumAlive; }
+
+protected:
+
+	/** Starts loading the enemy classes for the wave, if they aren't already */
+	void PreloadWave(int32 WaveIndex);
+
+	/** Advances to the next wave, or finishes if there are none left */
+	void StartNextWave();
+
+	/** Queues the current wave's enemies once their classes are loaded */
+	void BeginWave();
+
+	/** Called when a wave's enemy classes finish loading */
+	void OnWaveLoaded(int32 WaveIndex);
+
+	/** Spawns a single enemy at the next spawn point. Returns false if it couldn't be spawned */
+	bool SpawnQueuedEnemy(TSubclassOf<ACombatEnemy> EnemyClass);
+
+	/** Unsubscribes from spawned enemies that have died, so pooled enemies don't report to us in their next life */
+	void ReleaseDeadEnemies();
+
+	/** Called when one of our enemies has died */
+	UFUNCTION()
+	void OnEnemyDied();
+
+	/** Called after the last wave has been cleared */
+	void WavesDepleted();
+
+public:
+
+	// ~begin ICombatActivatable interface
+
+	/** Toggles the director */
+	UFUNCTION(BlueprintCallable, Category="Activatable")
+	virtual void ToggleInteraction(AActor* ActivationInstigator) override;
+
+	/** Starts the first wave */
+	UFUNCTION(BlueprintCallable, Category="Activatable")
+	virtual void ActivateInteraction(AActor* ActivationInstigator) override;
+
+	/** Deactivates the director */
+	UFUNCTION(BlueprintCallable, Category="Activatable")
+	virtual void DeactivateInteraction(AActor* ActivationInstigator) override;
+
+	// ~end IActivatable interface
+};
@@ -2,16 +2,19 @@
 
 
 #include "Variant_Combat/AI/EnvQueryContext_Danger.h"
+#include "CombatStats.h"
 #include "Variant_Combat/AI/CombatEnemy.h"
 #include "EnvironmentQuery/EnvQueryTypes.h"
 #include "EnvironmentQuery/Items/EnvQueryItemType_Point.h"
 
 void UEnvQueryContext_Danger::ProvideContext(FEnvQueryInstance& QueryInstance, FEnvQueryContextData& ContextData) const
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(EQSContexts);
+
 	// get the querying enemy
 	if (ACombatEnemy* QuerierActor = Cast<ACombatEnemy>(QueryInstance.Owner.Get()))
 	{
-		// add the last recorded danger location to the context
+		// add the last recorded danger location from the spatial index to the context
 		UEnvQueryItemType_Point::SetContextHelper(ContextData, QuerierActor->GetLastDangerLocation());
 	}
 }
\ No newline at end of file
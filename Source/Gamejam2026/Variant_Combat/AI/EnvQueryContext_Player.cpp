@@ -2,16 +2,21 @@
 
 
 #include "EnvQueryContext_Player.h"
-#include "Kismet/GameplayStatics.h"
+#include "CombatStats.h"
+#include "PlayerSnapshotSubsystem.h"
 #include "EnvironmentQuery/EnvQueryTypes.h"
 #include "EnvironmentQuery/Items/EnvQueryItemType_Actor.h"
 #include "GameFramework/Pawn.h"
 
 void UEnvQueryContext_Player::ProvideContext(FEnvQueryInstance& QueryInstance, FEnvQueryContextData& ContextData) const
 {
-	// get the player pawn for the first local player
-	AActor* PlayerPawn = UGameplayStatics::GetPlayerPawn(QueryInstance.Owner.Get(), 0);
-	check(PlayerPawn);
+	COMBAT_SCOPE_CYCLE_COUNTER(EQSContexts);
+
+	// get the player pawn for the first local player from the shared snapshot
+	const FPlayerSnapshot* PlayerSnapshot = UPlayerSnapshotSubsystem::Get(QueryInstance.Owner.Get());
+	check(PlayerSnapshot && PlayerSnapshot->Pawn);
+
+	AActor* PlayerPawn = PlayerSnapshot->Pawn;
 
 	// add the actor data to the context
 	UEnvQueryItemType_Actor::SetContextHelper(ContextData, PlayerPawn);
@@ -0,0 +1,23 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatAssetManifest.h"
+
+void UCombatAssetManifest::GetAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	for (const TSoftObjectPtr<UObject>& Asset : Assets)
+	{
+		if (!Asset.IsNull())
+		{
+			OutPaths.AddUnique(Asset.ToSoftObjectPath());
+		}
+	}
+
+	for (const TSoftClassPtr<UObject>& Class : Classes)
+	{
+		if (!Class.IsNull())
+		{
+			OutPaths.AddUnique(Class.ToSoftObjectPath());
+		}
+	}
+}
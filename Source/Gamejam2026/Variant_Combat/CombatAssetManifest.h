@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CombatAssetManifest.generated.h"
+
+/**
+ *  List of combat assets streamed in by ACombatGameMode while the level loads,
+ *  so they don't have to be hard referenced by the character classes
+ */
+UCLASS(BlueprintType)
+class UCombatAssetManifest : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Assets to preload, such as attack montages, VFX and sounds */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Preload")
+	TArray<TSoftObjectPtr<UObject>> Assets;
+
+	/** Blueprint classes to preload, such as the hit camera shakes. Enemy classes also preload their attack montages */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Preload")
+	TArray<TSoftClassPtr<UObject>> Classes;
+
+	/** Adds the paths of every listed asset and class to the list */
+	void GetAssetPaths(TArray<FSoftObjectPath>& OutPaths) const;
+};
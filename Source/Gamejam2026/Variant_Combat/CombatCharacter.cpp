@@ -2,6 +2,7 @@
 
 
 #include "CombatCharacter.h"
+#include "CombatStats.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/WidgetComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -11,10 +12,16 @@
 #include "EnhancedInputSubsystems.h"
 #include "EnhancedInputComponent.h"
 #include "CombatLifeBar.h"
+#include "CombatLifeBarSubsystem.h"
 #include "Engine/DamageEvents.h"
-#include "TimerManager.h"
 #include "Engine/LocalPlayer.h"
 #include "CombatPlayerController.h"
+#include "CombatAttackTraceSubsystem.h"
+#include "CombatSpatialSubsystem.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatReplaySubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 
 ACombatCharacter::ACombatCharacter()
 {
@@ -94,6 +101,12 @@ void ACombatCharacter::ToggleCamera()
 
 void ACombatCharacter::DoMove(float Right, float Forward)
 {
+	// let the replay record the input, or swallow it during playback
+	if (!UCombatReplaySubsystem::ProcessInput(this, ECombatReplayInput::Move, FVector2D(Right, Forward)))
+	{
+		return;
+	}
+
 	if (GetController() != nullptr)
 	{
 		// find out which way is forward
@@ -114,6 +127,12 @@ void ACombatCharacter::DoMove(float Right, float Forward)
 
 void ACombatCharacter::DoLook(float Yaw, float Pitch)
 {
+	// let the replay record the input, or swallow it during playback
+	if (!UCombatReplaySubsystem::ProcessInput(this, ECombatReplayInput::Look, FVector2D(Yaw, Pitch)))
+	{
+		return;
+	}
+
 	if (GetController() != nullptr)
 	{
 		// add yaw and pitch input to controller
@@ -124,6 +143,12 @@ void ACombatCharacter::DoLook(float Yaw, float Pitch)
 
 void ACombatCharacter::DoComboAttackStart()
 {
+	// let the replay record the input, or swallow it during playback
+	if (!UCombatReplaySubsystem::ProcessInput(this, ECombatReplayInput::ComboAttackStart))
+	{
+		return;
+	}
+
 	// are we already playing an attack animation?
 	if (bIsAttacking)
 	{
@@ -139,11 +164,23 @@ void ACombatCharacter::DoComboAttackStart()
 
 void ACombatCharacter::DoComboAttackEnd()
 {
+	// let the replay record the input, or swallow it during playback
+	if (!UCombatReplaySubsystem::ProcessInput(this, ECombatReplayInput::ComboAttackEnd))
+	{
+		return;
+	}
+
 	// stub
 }
 
 void ACombatCharacter::DoChargedAttackStart()
 {
+	// let the replay record the input, or swallow it during playback
+	if (!UCombatReplaySubsystem::ProcessInput(this, ECombatReplayInput::ChargedAttackStart))
+	{
+		return;
+	}
+
 	// raise the charging attack flag
 	bIsChargingAttack = true;
 
@@ -160,6 +197,12 @@ void ACombatCharacter::DoChargedAttackStart()
 
 void ACombatCharacter::DoChargedAttackEnd()
 {
+	// let the replay record the input, or swallow it during playback
+	if (!UCombatReplaySubsystem::ProcessInput(this, ECombatReplayInput::ChargedAttackEnd))
+	{
+		return;
+	}
+
 	// lower the charging attack flag
 	bIsChargingAttack = false;
 
@@ -176,30 +219,42 @@ void ACombatCharacter::ResetHP()
 	CurrentHP = MaxHP;
 
 	// update the life bar
-	LifeBarWidget->SetLifePercentage(1.0f);
+	UCombatLifeBarSubsystem::UpdateLifeBar(LifeBar, LifeBarWidget, 1.0f);
 }
 
 void ACombatCharacter::ComboAttack()
 {
+	// the montage is streamed in the background, so skip the attack until it's resident
+	UAnimMontage* AttackMontage = ComboAttackMontage.Get();
+
+	if (!AttackMontage)
+	{
+		UE_LOG(LogCombatCharacter, Verbose, TEXT("%s: combo attack montage isn't loaded yet"), *GetName());
+		return;
+	}
+
 	// raise the attacking flag
 	bIsAttacking = true;
 
 	// reset the combo count
 	ComboCount = 0;
 
+	// start a new swing
+	BeginAttackSwing();
+
 	// notify enemies they are about to be attacked
 	NotifyEnemiesOfIncomingAttack();
 
 	// play the attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		const float MontageLength = AnimInstance->Montage_Play(ComboAttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
+		const float MontageLength = AnimInstance->Montage_Play(AttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
 
 		// subscribe to montage completed and interrupted events
 		if (MontageLength > 0.0f)
 		{
 			// set the end delegate for the montage
-			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ComboAttackMontage);
+			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, AttackMontage);
 		}
 	}
 
@@ -207,25 +262,37 @@ void ACombatCharacter::ComboAttack()
 
 void ACombatCharacter::ChargedAttack()
 {
+	// the montage is streamed in the background, so skip the attack until it's resident
+	UAnimMontage* AttackMontage = ChargedAttackMontage.Get();
+
+	if (!AttackMontage)
+	{
+		UE_LOG(LogCombatCharacter, Verbose, TEXT("%s: charged attack montage isn't loaded yet"), *GetName());
+		return;
+	}
+
 	// raise the attacking flag
 	bIsAttacking = true;
 
 	// reset the charge loop flag
 	bHasLoopedChargedAttack = false;
 
+	// start a new swing
+	BeginAttackSwing();
+
 	// notify enemies they are about to be attacked
 	NotifyEnemiesOfIncomingAttack();
 
 	// play the charged attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		const float MontageLength = AnimInstance->Montage_Play(ChargedAttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
+		const float MontageLength = AnimInstance->Montage_Play(AttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
 
 		// subscribe to montage completed and interrupted events
 		if (MontageLength > 0.0f)
 		{
 			// set the end delegate for the montage
-			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ChargedAttackMontage);
+			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, AttackMontage);
 		}
 	}
 }
@@ -252,11 +319,17 @@ void ACombatCharacter::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupt
 	}
 }
 
-void ACombatCharacter::DoAttackTrace(FName DamageSourceBone)
+void ACombatCharacter::BeginAttackSwing()
 {
-	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
+	// reset the per-swing hit list
+	if (UCombatAttackTraceSubsystem* AttackTraces = GetWorld()->GetSubsystem<UCombatAttackTraceSubsystem>())
+	{
+		AttackTraces->BeginSwing(this);
+	}
+}
 
+void ACombatCharacter::DoAttackTrace(FName DamageSourceBone)
+{
 	// start at the provided socket location, sweep forward
 	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
 	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
@@ -266,37 +339,34 @@ void ACombatCharacter::DoAttackTrace(FName DamageSourceBone)
 	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
 	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
 
-	// use a sphere shape for the sweep
-	FCollisionShape CollisionShape;
-	CollisionShape.SetSphere(MeleeTraceRadius);
-
-	// ignore self
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	// queue the sweep. Hits will be resolved in a batch through ApplyAttackHit
+	if (UCombatAttackTraceSubsystem* AttackTraces = GetWorld()->GetSubsystem<UCombatAttackTraceSubsystem>())
 	{
-		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
-		{
-			// check if we've hit a damageable actor
-			ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
+		AttackTraces->QueueAttackTrace(this, TraceStart, TraceEnd, MeleeTraceRadius, ObjectParams);
+	}
+}
 
-			if (Damageable)
-			{
-				// knock upwards and away from the impact normal
-				const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+void ACombatCharacter::ApplyAttackHit(const FHitResult& Hit)
+{
+	// check if we've hit a damageable actor
+	ICombatDamageable* Damageable = Cast<ICombatDamageable>(Hit.GetActor());
 
-				// pass the damage event to the actor
-				Damageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
+	if (Damageable)
+	{
+		// knock upwards and away from the impact normal
+		const FVector Impulse = (Hit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
 
-				// call the BP handler to play effects, etc.
-				DealtDamage(MeleeDamage, CurrentHit.ImpactPoint);
-			}
-		}
+		// queue the damage event. The damage pipeline applies it after physics and calls NotifyDamageDealt
+		UCombatDamageSubsystem::SendDamage(this, Hit.GetActor(), MeleeDamage, ECombatDamageType::Melee, Hit.ImpactPoint, Impulse);
 	}
 }
 
+void ACombatCharacter::NotifyDamageDealt(AActor* Target, float Damage, const FVector& ImpactPoint)
+{
+	// call the BP handler to play effects, etc.
+	DealtDamage(Damage, ImpactPoint);
+}
+
 void ACombatCharacter::CheckCombo()
 {
 	// are we playing a non-charge attack animation?
@@ -314,13 +384,16 @@ void ACombatCharacter::CheckCombo()
 			// do we still have a combo section to play?
 			if (ComboCount < ComboSectionNames.Num())
 			{
+				// start a new swing
+				BeginAttackSwing();
+
 				// notify enemies they are about to be attacked
 				NotifyEnemiesOfIncomingAttack();
 
 				// jump to the next combo section
 				if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 				{
-					AnimInstance->Montage_JumpToSection(ComboSectionNames[ComboCount], ComboAttackMontage);
+					AnimInstance->Montage_JumpToSection(ComboSectionNames[ComboCount], ComboAttackMontage.Get());
 				}
 			}
 		}
@@ -332,48 +405,28 @@ void ACombatCharacter::CheckChargedAttack()
 	// raise the looped charged attack flag
 	bHasLoopedChargedAttack = true;
 
+	// releasing the charge starts the actual swing
+	if (!bIsChargingAttack)
+	{
+		BeginAttackSwing();
+	}
+
 	// jump to either the loop or the attack section depending on whether we're still holding the charge button
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		AnimInstance->Montage_JumpToSection(bIsChargingAttack ? ChargeLoopSection : ChargeAttackSection, ChargedAttackMontage);
+		AnimInstance->Montage_JumpToSection(bIsChargingAttack ? ChargeLoopSection : ChargeAttackSection, ChargedAttackMontage.Get());
 	}
 }
 
 void ACombatCharacter::NotifyEnemiesOfIncomingAttack()
 {
-	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
-
-	// start at the actor location, sweep forward
-	const FVector TraceStart = GetActorLocation();
-	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * DangerTraceDistance);
+	COMBAT_SCOPE_CYCLE_COUNTER(NotifyIncomingAttack);
 
-	// check for pawn object types only
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
-
-	// use a sphere shape for the sweep
-	FCollisionShape CollisionShape;
-	CollisionShape.SetSphere(DangerTraceRadius);
-
-	// ignore self
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	// query the spatial index for enemies in a cone ahead of the character.
+	// The range covers the full length of the old danger sweep, including its radius
+	if (UCombatSpatialSubsystem* Spatial = GetWorld()->GetSubsystem<UCombatSpatialSubsystem>())
 	{
-		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
-		{
-			// check if we've hit a damageable actor
-			ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
-
-			if (Damageable)
-			{
-				// notify the enemy
-				Damageable->NotifyDanger(GetActorLocation(), this);
-			}
-		}
+		Spatial->BroadcastDanger(this, GetActorLocation(), GetActorForwardVector(), DangerTraceDistance + DangerTraceRadius, DangerConeHalfAngle, DangerTraceRadius);
 	}
 }
 
@@ -417,7 +470,10 @@ void ACombatCharacter::HandleDeath()
 	GetCameraBoom()->TargetArmLength = DeathCameraDistance;
 
 	// schedule respawning
-	GetWorld()->GetTimerManager().SetTimer(RespawnTimer, this, &ACombatCharacter::RespawnCharacter, RespawnTime, false);
+	if (UGameCooldownSubsystem* Cooldowns = GetWorld()->GetSubsystem<UGameCooldownSubsystem>())
+	{
+		Cooldowns->SetCooldown(RespawnCooldown, RespawnTime, FSimpleDelegate::CreateUObject(this, &ACombatCharacter::RespawnCharacter));
+	}
 }
 
 void ACombatCharacter::ApplyHealing(float Healing, AActor* Healer)
@@ -438,6 +494,8 @@ void ACombatCharacter::RespawnCharacter()
 
 float ACombatCharacter::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(TakeDamage);
+
 	// only process damage if the character is still alive
 	if (CurrentHP <= 0.0f)
 	{
@@ -456,7 +514,7 @@ float ACombatCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dama
 	else
 	{
 		// update the life bar
-		LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
+		UCombatLifeBarSubsystem::UpdateLifeBar(LifeBar, LifeBarWidget, CurrentHP / MaxHP);
 
 		// enable partial ragdoll physics, but keep the pelvis vertical
 		GetMesh()->SetPhysicsBlendWeight(0.5f);
@@ -496,16 +554,59 @@ void ACombatCharacter::BeginPlay()
 	// set the life bar color
 	LifeBarWidget->SetBarColor(LifeBarColor);
 
+	// let the life bar subsystem coalesce updates. The player's bar keeps its own widget
+	if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+	{
+		LifeBars->RegisterLifeBar(LifeBar, LifeBarWidget, false);
+	}
+
+	// register our modifiers and resistances with the damage pipeline
+	if (UCombatDamageSubsystem* Damage = GetWorld()->GetSubsystem<UCombatDamageSubsystem>())
+	{
+		Damage->RegisterDamageProfile(this, DamageProfile);
+	}
+
+	// stream in the attack montages. They're usually resident already from the game mode's preload
+	TArray<FSoftObjectPath> PreloadPaths;
+	GetPreloadAssets(PreloadPaths);
+
+	if (PreloadPaths.Num() > 0)
+	{
+		MontageLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(PreloadPaths);
+	}
+
 	// reset HP to maximum
 	ResetHP();
 }
 
+void ACombatCharacter::GetPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const
+{
+	if (!ComboAttackMontage.IsNull())
+	{
+		OutPaths.AddUnique(ComboAttackMontage.ToSoftObjectPath());
+	}
+
+	if (!ChargedAttackMontage.IsNull())
+	{
+		OutPaths.AddUnique(ChargedAttackMontage.ToSoftObjectPath());
+	}
+}
+
 void ACombatCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the respawn timer
-	GetWorld()->GetTimerManager().ClearTimer(RespawnTimer);
+	// stop tracking the life bar
+	if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+	{
+		LifeBars->UnregisterLifeBar(LifeBar);
+	}
+
+	// remove our damage profile
+	if (UCombatDamageSubsystem* Damage = GetWorld()->GetSubsystem<UCombatDamageSubsystem>())
+	{
+		Damage->UnregisterDamageProfile(this);
+	}
 }
 
 void ACombatCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
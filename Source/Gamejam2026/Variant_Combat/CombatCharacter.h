@@ -6,7 +6,9 @@
 #include "GameFramework/Character.h"
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
+#include "CombatDamageTypes.h"
 #include "Animation/AnimInstance.h"
+#include "GameCooldownSubsystem.h"
 #include "CombatCharacter.generated.h"
 
 class USpringArmComponent;
@@ -15,6 +17,7 @@ class UInputAction;
 struct FInputActionValue;
 class UCombatLifeBar;
 class UWidgetComponent;
+struct FStreamableHandle;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogCombatCharacter, Log, All);
 
@@ -89,6 +92,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	FName PelvisBoneName;
 
+	/** Damage modifiers, resistances and invulnerability applied by the damage pipeline */
+	UPROPERTY(EditAnywhere, Category="Damage")
+	FCombatDamageProfile DamageProfile;
+
 	/** Pointer to the life bar widget */
 	UPROPERTY(EditAnywhere, Category="Damage")
 	TObjectPtr<UCombatLifeBar> LifeBarWidget;
@@ -115,10 +122,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 500, Units="cm"))
 	float DangerTraceDistance = 300.0f;
 
-	/** Radius of the sphere trace to notify enemies of incoming attacks */
+	/** Radius around the character inside which enemies will always be notified of incoming attacks */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 200, Units = "cm"))
 	float DangerTraceRadius = 100.0f;
 
+	/** Half angle of the cone ahead of the character that enemies will be notified of incoming attacks in */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 180, Units = "degrees"))
+	float DangerConeHalfAngle = 35.0f;
+
 	/** Amount of damage a melee attack will deal */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Damage", meta = (ClampMin = 0, ClampMax = 100))
 	float MeleeDamage = 1.0f;
@@ -131,9 +142,9 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Damage", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm/s"))
 	float MeleeLaunchImpulse = 300.0f;
 
-	/** AnimMontage that will play for combo attacks */
+	/** AnimMontage that will play for combo attacks. Streamed in the background */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Combo")
-	UAnimMontage* ComboAttackMontage;
+	TSoftObjectPtr<UAnimMontage> ComboAttackMontage;
 
 	/** Names of the AnimMontage sections that correspond to each stage of the combo attack */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Combo")
@@ -146,9 +157,9 @@ protected:
 	/** Index of the current stage of the melee attack combo */
 	int32 ComboCount = 0;
 
-	/** AnimMontage that will play for charged attacks */
+	/** AnimMontage that will play for charged attacks. Streamed in the background */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Charged")
-	UAnimMontage* ChargedAttackMontage;
+	TSoftObjectPtr<UAnimMontage> ChargedAttackMontage;
 
 	/** Name of the AnimMontage section that corresponds to the charge loop */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Charged")
@@ -179,8 +190,11 @@ protected:
 	/** Attack montage ended delegate */
 	FOnMontageEnded OnAttackMontageEnded;
 
-	/** Character respawn timer */
-	FTimerHandle RespawnTimer;
+	/** Keeps the attack montages loaded while the character is alive */
+	TSharedPtr<FStreamableHandle> MontageLoadHandle;
+
+	/** Cooldown before the character respawns */
+	FGameCooldownHandle RespawnCooldown;
 
 	/** Copy of the mesh's transform so we can reset it after ragdoll animations */
 	FTransform MeshStartingTransform;
@@ -190,6 +204,9 @@ public:
 	/** Constructor */
 	ACombatCharacter();
 
+	/** Adds the assets this character streams in, such as its attack montages, to the list */
+	void GetPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const;
+
 protected:
 
 	/** Called for movement input */
@@ -254,6 +271,9 @@ protected:
 	/** Called from a delegate when the attack montage ends */
 	void AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted);
 
+	/** Starts a new attack swing so its traces can hit each target once */
+	void BeginAttackSwing();
+
 	
 public:
 
@@ -262,12 +282,18 @@ public:
 	/** Performs the collision check for an attack */
 	virtual void DoAttackTrace(FName DamageSourceBone) override;
 
+	/** Applies damage and effects to an actor hit by an attack */
+	virtual void ApplyAttackHit(const FHitResult& Hit) override;
+
 	/** Performs the combo string check */
 	virtual void CheckCombo() override;
 
 	/** Performs the charged attack hold check */
 	virtual void CheckChargedAttack() override;
 
+	/** Plays damage dealt effects once the damage pipeline has applied a hit */
+	virtual void NotifyDamageDealt(AActor* Target, float Damage, const FVector& ImpactPoint) override;
+
 	// ~end CombatAttacker interface
 
 	// ~begin CombatDamageable interface
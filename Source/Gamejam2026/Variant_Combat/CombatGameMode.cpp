@@ -2,8 +2,134 @@
 
 
 #include "Variant_Combat/CombatGameMode.h"
+#include "CombatAssetManifest.h"
+#include "CombatCharacter.h"
+#include "CombatEnemy.h"
+#include "Engine/World.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Gamejam2026.h"
+
+static FAutoConsoleCommandWithWorld CombatPreloadStatsCommand(
+	TEXT("Combat.Preload.Stats"),
+	TEXT("Logs the load time of every combat asset streamed in by the game mode"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const ACombatGameMode* GameMode = World ? World->GetAuthGameMode<ACombatGameMode>() : nullptr)
+		{
+			GameMode->DumpPreloadStats();
+		}
+	})
+);
 
 ACombatGameMode::ACombatGameMode()
 {
 
-}
\ No newline at end of file
+}
+
+void ACombatGameMode::DumpPreloadStats() const
+{
+	float SlowestTimeMs = 0.0f;
+
+	for (const FCombatPreloadEntry& Entry : PreloadEntries)
+	{
+		if (Entry.LoadTimeMs < 0.0f)
+		{
+			UE_LOG(LogGamejam2026, Log, TEXT("Combat preload: %s still loading"), *Entry.Path.ToString());
+			continue;
+		}
+
+		UE_LOG(LogGamejam2026, Log, TEXT("Combat preload: %s %s in %.2f ms"), *Entry.Path.ToString(), Entry.bFailed ? TEXT("failed") : TEXT("loaded"), Entry.LoadTimeMs);
+		SlowestTimeMs = FMath::Max(SlowestTimeMs, Entry.LoadTimeMs);
+	}
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat preload: %d assets, %d pending, slowest %.2f ms"), PreloadEntries.Num(), NumPendingPreloads, SlowestTimeMs);
+}
+
+void ACombatGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	PreloadStartTime = FPlatformTime::Seconds();
+
+	TArray<FSoftObjectPath> Paths;
+
+	// add the manifest
+	if (AssetManifest)
+	{
+		AssetManifest->GetAssetPaths(Paths);
+	}
+
+	// add the player's montages, so they're resident by the time the pawn spawns
+	if (const ACombatCharacter* DefaultCharacter = Cast<ACombatCharacter>(DefaultPawnClass ? DefaultPawnClass->GetDefaultObject() : nullptr))
+	{
+		DefaultCharacter->GetPreloadAssets(Paths);
+	}
+
+	for (const FSoftObjectPath& Path : Paths)
+	{
+		PreloadAsset(Path);
+	}
+}
+
+void ACombatGameMode::PreloadAsset(const FSoftObjectPath& Path)
+{
+	// skip assets we've already requested
+	if (Path.IsNull() || PreloadEntries.ContainsByPredicate([&Path](const FCombatPreloadEntry& Entry) { return Entry.Path == Path; }))
+	{
+		return;
+	}
+
+	const int32 EntryIndex = PreloadEntries.AddDefaulted();
+	PreloadEntries[EntryIndex].Path = Path;
+	PreloadEntries[EntryIndex].StartTime = FPlatformTime::Seconds();
+
+	++NumPendingPreloads;
+
+	// the delegate can run right away if the asset is already loaded, and may add more entries
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Path,
+		FStreamableDelegate::CreateUObject(this, &ACombatGameMode::OnAssetPreloaded, EntryIndex), FStreamableManager::AsyncLoadHighPriority);
+
+	PreloadEntries[EntryIndex].Handle = Handle;
+}
+
+void ACombatGameMode::OnAssetPreloaded(int32 EntryIndex)
+{
+	FCombatPreloadEntry& Entry = PreloadEntries[EntryIndex];
+	Entry.LoadTimeMs = (FPlatformTime::Seconds() - Entry.StartTime) * 1000.0;
+
+	--NumPendingPreloads;
+
+	UObject* Asset = Entry.Path.ResolveObject();
+	Entry.bFailed = Asset == nullptr;
+
+	if (Entry.bFailed)
+	{
+		UE_LOG(LogGamejam2026, Warning, TEXT("Combat preload: couldn't load %s"), *Entry.Path.ToString());
+	}
+	else
+	{
+		UE_LOG(LogGamejam2026, Log, TEXT("Combat preload: %s loaded in %.2f ms"), *Entry.Path.ToString(), Entry.LoadTimeMs);
+	}
+
+	// enemy classes bring their montages along
+	const UClass* Class = Cast<UClass>(Asset);
+
+	if (Class && Class->IsChildOf(ACombatEnemy::StaticClass()))
+	{
+		TArray<FSoftObjectPath> EnemyPaths;
+		Class->GetDefaultObject<ACombatEnemy>()->GetPreloadAssets(EnemyPaths);
+
+		for (const FSoftObjectPath& Path : EnemyPaths)
+		{
+			PreloadAsset(Path);
+		}
+	}
+
+	if (NumPendingPreloads == 0)
+	{
+		UE_LOG(LogGamejam2026, Log, TEXT("Combat preload: %d assets ready after %.2f ms"), PreloadEntries.Num(), (FPlatformTime::Seconds() - PreloadStartTime) * 1000.0);
+	}
+}
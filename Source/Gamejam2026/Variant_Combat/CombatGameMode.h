@@ -6,15 +6,69 @@
 #include "GameFramework/GameModeBase.h"
 #include "CombatGameMode.generated.h"
 
+class UCombatAssetManifest;
+struct FStreamableHandle;
+
 /**
- *  Simple GameMode for a third person combat game
+ *  A combat asset being streamed in by the game mode
+ */
+struct FCombatPreloadEntry
+{
+	/** Asset path */
+	FSoftObjectPath Path;
+
+	/** Keeps the asset loaded for the rest of the session */
+	TSharedPtr<FStreamableHandle> Handle;
+
+	/** Time the load was requested */
+	double StartTime = 0.0;
+
+	/** Time the load took, or a negative value while it's in flight */
+	float LoadTimeMs = -1.0f;
+
+	/** If true, the load finished but the asset couldn't be found */
+	bool bFailed = false;
+};
+
+/**
+ *  Simple GameMode for a third person combat game.
+ *  Streams in the combat asset manifest and the default pawn's montages while the level loads.
  */
 UCLASS(abstract)
 class ACombatGameMode : public AGameModeBase
 {
 	GENERATED_BODY()
-	
+
+protected:
+
+	/** Combat assets to stream in while the level loads */
+	UPROPERTY(EditAnywhere, Category="Preload")
+	TObjectPtr<UCombatAssetManifest> AssetManifest;
+
+	/** Assets requested so far */
+	TArray<FCombatPreloadEntry> PreloadEntries;
+
+	/** Time the preload started */
+	double PreloadStartTime = 0.0;
+
+	/** Number of loads still in flight */
+	int32 NumPendingPreloads = 0;
+
 public:
 
 	ACombatGameMode();
+
+	/** Writes the load time of every preloaded asset to the log */
+	void DumpPreloadStats() const;
+
+protected:
+
+	/** Starts streaming the combat assets */
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+
+	/** Requests an async load for the asset, unless it's already been requested */
+	void PreloadAsset(const FSoftObjectPath& Path);
+
+	/** Called when a preloaded asset finishes loading */
+	void OnAssetPreloaded(int32 EntryIndex);
 };
@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatStats.h"
+
+CSV_DEFINE_CATEGORY(Combat, true);
+
+DEFINE_STAT(STAT_Combat_AttackTraces);
+DEFINE_STAT(STAT_Combat_NotifyIncomingAttack);
+DEFINE_STAT(STAT_Combat_TakeDamage);
+DEFINE_STAT(STAT_Combat_DamageResolve);
+DEFINE_STAT(STAT_Combat_StateTreeTasks);
+DEFINE_STAT(STAT_Combat_StateTreeConditions);
+DEFINE_STAT(STAT_Combat_SpawnerEvents);
+DEFINE_STAT(STAT_Combat_EQSContexts);
+DEFINE_STAT(STAT_Combat_Queries);
+DEFINE_STAT(STAT_Combat_LineOfSight);
+DEFINE_STAT(STAT_Combat_SpatialGrid);
+DEFINE_STAT(STAT_Combat_Crowd);
+DEFINE_STAT(STAT_Combat_LifeBars);
+DEFINE_STAT(STAT_Combat_Boxes);
+
+DEFINE_STAT(STAT_Combat_EnemiesAlive);
+DEFINE_STAT(STAT_Combat_TracesPerFrame);
+DEFINE_STAT(STAT_Combat_DamageEventsPerFrame);
@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/**
+ *  Stats and CSV profiler categories for the combat variant.
+ *  Use "stat Combat" to view them in game, or -csvCaptureFrames to capture them to a CSV.
+ *  Both compile out of Shipping builds.
+ */
+
+DECLARE_STATS_GROUP(TEXT("Combat"), STATGROUP_Combat, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_EXTERN(Combat);
+
+// cycle counters
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Attack Traces"), STAT_Combat_AttackTraces, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Notify Incoming Attack"), STAT_Combat_NotifyIncomingAttack, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Take Damage"), STAT_Combat_TakeDamage, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Damage Resolve"), STAT_Combat_DamageResolve, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("StateTree Tasks"), STAT_Combat_StateTreeTasks, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("StateTree Conditions"), STAT_Combat_StateTreeConditions, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawner Events"), STAT_Combat_SpawnerEvents, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("EQS Contexts"), STAT_Combat_EQSContexts, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Shared Queries"), STAT_Combat_Queries, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Line of Sight"), STAT_Combat_LineOfSight, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spatial Grid"), STAT_Combat_SpatialGrid, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Crowd"), STAT_Combat_Crowd, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Life Bars"), STAT_Combat_LifeBars, STATGROUP_Combat, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Boxes"), STAT_Combat_Boxes, STATGROUP_Combat, );
+
+// counters
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Enemies Alive"), STAT_Combat_EnemiesAlive, STATGROUP_Combat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces Per Frame"), STAT_Combat_TracesPerFrame, STATGROUP_Combat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Events Per Frame"), STAT_Combat_DamageEventsPerFrame, STATGROUP_Combat, );
+
+/** Times the enclosing scope in both the Combat stat group and the Combat CSV category */
+#define COMBAT_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_Combat_##Name); \
+	CSV_SCOPED_TIMING_STAT(Combat, Name)
+
+/** Adds to a per-frame Combat counter */
+#define COMBAT_INC_COUNTER(Name, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(STAT_Combat_##Name, Amount); \
+		CSV_CUSTOM_STAT(Combat, Name, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate); \
+	} while (0)
+
+/** Sets the value of a Combat counter */
+#define COMBAT_SET_COUNTER(Name, Value) \
+	do \
+	{ \
+		SET_DWORD_STAT(STAT_Combat_##Name, Value); \
+		CSV_CUSTOM_STAT(Combat, Name, static_cast<int32>(Value), ECsvCustomStatOp::Set); \
+	} while (0)
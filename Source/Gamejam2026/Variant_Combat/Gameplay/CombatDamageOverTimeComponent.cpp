@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatDamageOverTimeComponent.h"
+#include "CombatDamageable.h"
+#include "CombatDamageSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+UCombatDamageOverTimeComponent::UCombatDamageOverTimeComponent()
+{
+	// damage is applied from a timer
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UCombatDamageOverTimeComponent::SetZone(UPrimitiveComponent* InZone)
+{
+	Zone = InZone;
+}
+
+void UCombatDamageOverTimeComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// default to the owner's root component
+	if (!Zone)
+	{
+		Zone = Cast<UPrimitiveComponent>(GetOwner()->GetRootComponent());
+	}
+
+	if (!Zone)
+	{
+		return;
+	}
+
+	Zone->SetGenerateOverlapEvents(true);
+	Zone->OnComponentBeginOverlap.AddUniqueDynamic(this, &UCombatDamageOverTimeComponent::OnZoneBeginOverlap);
+	Zone->OnComponentEndOverlap.AddUniqueDynamic(this, &UCombatDamageOverTimeComponent::OnZoneEndOverlap);
+
+	// pick up anything that was already inside the zone before we started listening
+	TArray<UPrimitiveComponent*> OverlappingComponents;
+	Zone->GetOverlappingComponents(OverlappingComponents);
+
+	for (const UPrimitiveComponent* Component : OverlappingComponents)
+	{
+		AddOccupant(Component->GetOwner());
+	}
+}
+
+void UCombatDamageOverTimeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	GetWorld()->GetTimerManager().ClearTimer(DamageTimer);
+
+	if (Zone)
+	{
+		Zone->OnComponentBeginOverlap.RemoveDynamic(this, &UCombatDamageOverTimeComponent::OnZoneBeginOverlap);
+		Zone->OnComponentEndOverlap.RemoveDynamic(this, &UCombatDamageOverTimeComponent::OnZoneEndOverlap);
+	}
+
+	Occupants.Empty();
+}
+
+void UCombatDamageOverTimeComponent::OnZoneBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	AddOccupant(OtherActor);
+}
+
+void UCombatDamageOverTimeComponent::OnZoneEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	const int32 Index = Occupants.IndexOfByPredicate([OtherActor](const FCombatDamageZoneOccupant& Occupant) { return Occupant.Actor == OtherActor; });
+
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	// only stop tracking the actor once all of its components have left
+	if (--Occupants[Index].OverlapCount <= 0)
+	{
+		Occupants.RemoveAtSwap(Index, EAllowShrinking::No);
+	}
+
+	// stop the timer while the zone is empty
+	if (Occupants.IsEmpty())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(DamageTimer);
+	}
+}
+
+void UCombatDamageOverTimeComponent::AddOccupant(AActor* Actor)
+{
+	// only track actors we can damage
+	if (!Actor || Actor == GetOwner() || !Cast<ICombatDamageable>(Actor))
+	{
+		return;
+	}
+
+	if (FCombatDamageZoneOccupant* Existing = Occupants.FindByPredicate([Actor](const FCombatDamageZoneOccupant& Occupant) { return Occupant.Actor == Actor; }))
+	{
+		++Existing->OverlapCount;
+		return;
+	}
+
+	FCombatDamageZoneOccupant& Occupant = Occupants.AddDefaulted_GetRef();
+	Occupant.Actor = Actor;
+	Occupant.OverlapCount = 1;
+
+	// start ticking damage when the first occupant arrives
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+
+	if (!TimerManager.IsTimerActive(DamageTimer))
+	{
+		TimerManager.SetTimer(DamageTimer, this, &UCombatDamageOverTimeComponent::ApplyDamageTick, TickInterval, true);
+	}
+
+	if (bDamageOnEnter)
+	{
+		DamageActor(Actor);
+	}
+}
+
+void UCombatDamageOverTimeComponent::ApplyDamageTick()
+{
+	// copy the occupants first. Damage applied right away may kill or move them out of the zone
+	TickTargets.Reset();
+
+	for (int32 i = Occupants.Num() - 1; i >= 0; --i)
+	{
+		if (Occupants[i].Actor.IsValid())
+		{
+			TickTargets.Add(Occupants[i].Actor);
+		}
+		else
+		{
+			// drop occupants that were destroyed without an end overlap
+			Occupants.RemoveAtSwap(i, EAllowShrinking::No);
+		}
+	}
+
+	for (const TWeakObjectPtr<AActor>& Target : TickTargets)
+	{
+		if (AActor* Actor = Target.Get())
+		{
+			DamageActor(Actor);
+		}
+	}
+
+	if (Occupants.IsEmpty())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(DamageTimer);
+	}
+}
+
+void UCombatDamageOverTimeComponent::DamageActor(AActor* Actor)
+{
+	UCombatDamageSubsystem::SendDamage(GetOwner(), Actor, DamagePerTick, DamageType, Actor->GetActorLocation(), FVector::ZeroVector);
+}
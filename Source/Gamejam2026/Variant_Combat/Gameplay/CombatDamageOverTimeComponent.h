@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/TimerHandle.h"
+#include "CombatDamageTypes.h"
+#include "CombatDamageOverTimeComponent.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ *  An actor currently inside a damage over time zone
+ */
+struct FCombatDamageZoneOccupant
+{
+	/** Actor inside the zone */
+	TWeakObjectPtr<AActor> Actor;
+
+	/** Number of the actor's components overlapping the zone */
+	int32 OverlapCount = 0;
+};
+
+/**
+ *  Turns a primitive component into a hazard zone that damages whatever is inside it at a fixed rate.
+ *  Occupants are tracked through begin and end overlap events, and damaged together on a timer,
+ *  so the damage rate doesn't depend on frame rate or on how many collision events the occupants generate.
+ */
+UCLASS(ClassGroup=(Combat), meta=(BlueprintSpawnableComponent))
+class UCombatDamageOverTimeComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Amount of damage to deal to each occupant every damage tick */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0))
+	float DamagePerTick = 1.0f;
+
+	/** Time between damage ticks */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0.05, ClampMax = 10, Units = "s"))
+	float TickInterval = 0.5f;
+
+	/** Kind of damage dealt, used to pick the occupant's resistance */
+	UPROPERTY(EditAnywhere, Category="Damage")
+	ECombatDamageType DamageType = ECombatDamageType::Environment;
+
+	/** If true, actors are damaged as soon as they enter the zone instead of waiting for the next damage tick */
+	UPROPERTY(EditAnywhere, Category="Damage")
+	bool bDamageOnEnter = true;
+
+	/** Zone volume. Defaults to the owner's root component if it isn't set before BeginPlay */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (UseComponentPicker))
+	TObjectPtr<UPrimitiveComponent> Zone;
+
+	/** Actors currently inside the zone */
+	TArray<FCombatDamageZoneOccupant> Occupants;
+
+	/** Scratch list of actors to damage, so occupants leaving mid-tick don't invalidate the iteration */
+	TArray<TWeakObjectPtr<AActor>> TickTargets;
+
+	/** Repeating damage tick timer. Only runs while the zone is occupied */
+	FTimerHandle DamageTimer;
+
+public:
+
+	/** Constructor */
+	UCombatDamageOverTimeComponent();
+
+	/** Sets the primitive component used as the zone volume. Usually called from the owner's constructor */
+	void SetZone(UPrimitiveComponent* InZone);
+
+	/** Sets the amount of damage dealt every damage tick */
+	void SetDamagePerTick(float InDamage) { DamagePerTick = InDamage; }
+
+	/** Returns the number of actors inside the zone */
+	int32 GetNumOccupants() const { return Occupants.Num(); }
+
+protected:
+
+	/** Binds the zone's overlap events and picks up actors already inside it */
+	virtual void BeginPlay() override;
+
+	/** Unbinds the zone and stops the damage timer */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Zone begin overlap handler */
+	UFUNCTION()
+	void OnZoneBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/** Zone end overlap handler */
+	UFUNCTION()
+	void OnZoneEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	/** Adds an overlap for the actor, starting to track it if it's new */
+	void AddOccupant(AActor* Actor);
+
+	/** Damages every occupant */
+	void ApplyDamageTick();
+
+	/** Sends one damage tick to an actor */
+	void DamageActor(AActor* Actor);
+};
@@ -2,8 +2,8 @@
 
 
 #include "CombatDamageableBox.h"
+#include "CombatBoxSubsystem.h"
 #include "Components/StaticMeshComponent.h"
-#include "TimerManager.h"
 #include "Engine/World.h"
 
 ACombatDamageableBox::ACombatDamageableBox()
@@ -16,6 +16,9 @@ ACombatDamageableBox::ACombatDamageableBox()
 	// set the collision properties
 	Mesh->SetCollisionProfileName(FName("BlockAllDynamic"));
 
+	// report overlaps, so damage zones such as lava can find us
+	Mesh->SetGenerateOverlapEvents(true);
+
 	// enable physics
 	Mesh->SetSimulatePhysics(true);
 
@@ -25,16 +28,82 @@ ACombatDamageableBox::ACombatDamageableBox()
 
 void ACombatDamageableBox::RemoveFromLevel()
 {
+	// return to the debris pool so the actor can be reused by another box
+	if (UCombatBoxSubsystem* Boxes = GetWorld()->GetSubsystem<UCombatBoxSubsystem>())
+	{
+		if (Boxes->ReleaseBox(this))
+		{
+			return;
+		}
+	}
+
 	// destroy this actor
 	Destroy();
 }
 
+void ACombatDamageableBox::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// save the collision object type so we can restore it after death
+	DefaultObjectType = Mesh->GetCollisionObjectType();
+
+	// hand the box over to the box subsystem. Boxes at rest are drawn as instances
+	if (UCombatBoxSubsystem* Boxes = GetWorld()->GetSubsystem<UCombatBoxSubsystem>())
+	{
+		Boxes->RegisterBox(this);
+	}
+}
+
 void ACombatDamageableBox::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the death timer
-	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+	// stop tracking the box
+	if (UCombatBoxSubsystem* Boxes = GetWorld()->GetSubsystem<UCombatBoxSubsystem>())
+	{
+		Boxes->UnregisterBox(this);
+	}
+}
+
+void ACombatDamageableBox::DeactivateForPool()
+{
+	// raise the pooled flag
+	bIsInPool = true;
+
+	// clear the death cooldown in case we're parked early
+	if (UGameCooldownSubsystem* Cooldowns = GetWorld()->GetSubsystem<UGameCooldownSubsystem>())
+	{
+		Cooldowns->ClearCooldown(DeathCooldown);
+	}
+
+	// hide the box and take it out of the simulation
+	Mesh->SetSimulatePhysics(false);
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+}
+
+void ACombatDamageableBox::ActivateFromPool(const FTransform& SpawnTransform, float HP)
+{
+	// lower the pooled flag
+	bIsInPool = false;
+
+	// reset the combat state
+	CurrentHP = HP;
+
+	// move to the spawn transform
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	// restore collision, including the object type changed on death
+	Mesh->SetCollisionObjectType(DefaultObjectType);
+	SetActorEnableCollision(true);
+
+	// show the box and start simulating it
+	SetActorHiddenInGame(false);
+
+	Mesh->SetSimulatePhysics(true);
+	Mesh->WakeRigidBody();
 }
 
 void ACombatDamageableBox::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
@@ -67,8 +136,16 @@ void ACombatDamageableBox::HandleDeath()
 	// call the BP handler to play effects, etc.
 	OnBoxDestroyed();
 
-	// set up the death cleanup timer
-	GetWorld()->GetTimerManager().SetTimer(DeathTimer, this, &ACombatDamageableBox::RemoveFromLevel, DeathDelayTime);
+	// schedule the death cleanup
+	if (UGameCooldownSubsystem* Cooldowns = GetWorld()->GetSubsystem<UGameCooldownSubsystem>())
+	{
+		Cooldowns->SetCooldown(DeathCooldown, DeathDelayTime, FSimpleDelegate::CreateUObject(this, &ACombatDamageableBox::RemoveFromLevel));
+
+	} else {
+
+		// nothing to schedule the cleanup with, so clean up right away
+		RemoveFromLevel();
+	}
 }
 
 void ACombatDamageableBox::ApplyHealing(float Healing, AActor* Healer)
@@ -5,10 +5,12 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatDamageable.h"
+#include "GameCooldownSubsystem.h"
 #include "CombatDamageableBox.generated.h"
 
 /**
- *  A simple physics box that reacts to damage through the ICombatDamageable interface
+ *  A simple physics box that reacts to damage through the ICombatDamageable interface.
+ *  While at rest, boxes are drawn as instances by UCombatBoxSubsystem and only exist as actors while they're moving.
  */
 UCLASS(abstract)
 class ACombatDamageableBox : public AActor, public ICombatDamageable
@@ -34,8 +36,17 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
 	float DeathDelayTime = 6.0f;
 
-	/** Timer to defer destruction of this box after its HP are depleted */
-	FTimerHandle DeathTimer;
+	/** Cooldown to defer destruction of this box after its HP are depleted */
+	FGameCooldownHandle DeathCooldown;
+
+	/** Collision object type restored when the box is reused from the pool */
+	TEnumAsByte<ECollisionChannel> DefaultObjectType = ECC_WorldDynamic;
+
+	/** Index of the box's record in UCombatBoxSubsystem, or INDEX_NONE if it isn't managed */
+	int32 BoxRecord = INDEX_NONE;
+
+	/** If true, this box is parked in the box subsystem's pool */
+	bool bIsInPool = false;
 
 	/** Blueprint damage handler for effect playback */
 	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
@@ -50,8 +61,35 @@ protected:
 
 public:
 
+	/** Initialization */
+	virtual void BeginPlay() override;
+
 	/** EndPlay cleanup */
-	void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
+	/** Parks the box: stops its simulation, hides it and disables its collision */
+	void DeactivateForPool();
+
+	/** Reactivates a parked box at the given transform with the given HP, and starts simulating it */
+	void ActivateFromPool(const FTransform& SpawnTransform, float HP);
+
+	/** Returns true if the box is parked in the pool */
+	bool IsInPool() const { return bIsInPool; }
+
+	/** Returns true if the box has run out of HP */
+	bool IsDead() const { return CurrentHP <= 0.0f; }
+
+	/** Returns the current HP */
+	float GetCurrentHP() const { return CurrentHP; }
+
+	/** Returns the box mesh */
+	UStaticMeshComponent* GetMesh() const { return Mesh; }
+
+	/** Returns the box's record index in the box subsystem */
+	int32 GetBoxRecord() const { return BoxRecord; }
+
+	/** Sets the box's record index in the box subsystem */
+	void SetBoxRecord(int32 InBoxRecord) { BoxRecord = InBoxRecord; }
 
 	// ~Begin CombatDamageable interface
 
@@ -2,8 +2,10 @@
 
 
 #include "CombatLavaFloor.h"
-#include "CombatDamageable.h"
+#include "CombatDamageOverTimeComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/BoxComponent.h"
+#include "Engine/StaticMesh.h"
 
 ACombatLavaFloor::ACombatLavaFloor()
 {
@@ -12,16 +14,51 @@ ACombatLavaFloor::ACombatLavaFloor()
 	// create the mesh
 	RootComponent = Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 
-	// bind the hit handler
-	Mesh->OnComponentHit.AddDynamic(this, &ACombatLavaFloor::OnFloorHit);
+	// create the damage zone. It overlaps pawns and the physics objects damageable props use, such as boxes.
+	// The damage over time component only keeps actors that implement ICombatDamageable
+	DamageZone = CreateDefaultSubobject<UBoxComponent>(TEXT("Damage Zone"));
+	DamageZone->SetupAttachment(Mesh);
+	DamageZone->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	DamageZone->SetCollisionObjectType(ECC_WorldDynamic);
+	DamageZone->SetCollisionResponseToAllChannels(ECR_Ignore);
+	DamageZone->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+	DamageZone->SetCollisionResponseToChannel(ECC_WorldDynamic, ECR_Overlap);
+	DamageZone->SetCollisionResponseToChannel(ECC_PhysicsBody, ECR_Overlap);
+	DamageZone->SetGenerateOverlapEvents(true);
+
+	// create the damage over time component. Lava kills on contact, so damage on enter
+	DamageOverTime = CreateDefaultSubobject<UCombatDamageOverTimeComponent>(TEXT("Damage Over Time"));
+	DamageOverTime->SetZone(DamageZone);
 }
 
-void ACombatLavaFloor::OnFloorHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+void ACombatLavaFloor::OnConstruction(const FTransform& Transform)
 {
-	// check if the hit actor is damageable by casting to the interface
-	if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(OtherActor))
+	Super::OnConstruction(Transform);
+
+	if (!Mesh->GetStaticMesh())
 	{
-		// damage the actor
-		Damageable->ApplyDamage(Damage, this, Hit.ImpactPoint, FVector::ZeroVector);
+		return;
 	}
+
+	// the zone inherits the mesh scale, so convert the zone height to mesh space
+	const FBox Bounds = Mesh->GetStaticMesh()->GetBoundingBox();
+	const float LocalHeight = ZoneHeight / FMath::Max(FMath::Abs(Mesh->GetComponentScale().Z), UE_KINDA_SMALL_NUMBER);
+
+	// cover the mesh and extend the zone above its top surface
+	FVector Extent = Bounds.GetExtent();
+	Extent.Z += LocalHeight * 0.5f;
+
+	FVector Center = Bounds.GetCenter();
+	Center.Z += LocalHeight * 0.5f;
+
+	DamageZone->SetBoxExtent(Extent);
+	DamageZone->SetRelativeLocation(Center);
+}
+
+void ACombatLavaFloor::BeginPlay()
+{
+	// set the damage before the components begin play, so actors already on the floor take the right amount
+	DamageOverTime->SetDamagePerTick(Damage);
+
+	Super::BeginPlay();
 }
@@ -7,10 +7,12 @@
 #include "CombatLavaFloor.generated.h"
 
 class UStaticMeshComponent;
-class UPrimitiveComponent;
+class UBoxComponent;
+class UCombatDamageOverTimeComponent;
 
 /**
- *  A basic actor that applies damage on contact through the ICombatDamageable interface. 
+ *  A basic actor that damages anything standing on it through the ICombatDamageable interface.
+ *  Occupants are tracked with an overlap zone fitted to the top of the floor mesh and damaged at a fixed rate.
  */
 UCLASS(abstract)
 class ACombatLavaFloor : public AActor
@@ -21,20 +23,34 @@ class ACombatLavaFloor : public AActor
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* Mesh;
 
+	/** Overlap zone that tracks actors touching the floor */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UBoxComponent* DamageZone;
+
+	/** Applies damage to the actors inside the zone */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UCombatDamageOverTimeComponent* DamageOverTime;
+
 protected:
 
-	/** Amount of damage to deal on contact */
+	/** Amount of damage to deal on contact, and on every damage tick while standing on the floor */
 	UPROPERTY(EditAnywhere, Category="Damage")
 	float Damage = 10000.0f;
 
+	/** Height of the damage zone above the top of the floor mesh */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 1, ClampMax = 500, Units = "cm"))
+	float ZoneHeight = 20.0f;
+
 public:	
 
 	/** Constructor */
 	ACombatLavaFloor();
 
+	/** Fits the damage zone to the floor mesh */
+	virtual void OnConstruction(const FTransform& Transform) override;
+
 protected:
 
-	/** Blocking hit handler */
-	UFUNCTION()
-	void OnFloorHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+	/** Passes the damage to the damage over time component */
+	virtual void BeginPlay() override;
 };
@@ -26,6 +26,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Attacker")
 	virtual void DoAttackTrace(FName DamageSourceBone) = 0;
 
+	/** Applies the effects of an attack to a single actor hit by its collision check. Called once per actor per swing */
+	UFUNCTION(BlueprintCallable, Category="Attacker")
+	virtual void ApplyAttackHit(const FHitResult& Hit) = 0;
+
 	/** Performs a combo attack's check to continue the string. Usually called from a montage's AnimNotify */
 	UFUNCTION(BlueprintCallable, Category="Attacker")
 	virtual void CheckCombo() = 0;
@@ -33,4 +37,8 @@ public:
 	/** Performs a charged attack's check to loop the charge animation. Usually called from a montage's AnimNotify */
 	UFUNCTION(BlueprintCallable, Category="Attacker")
 	virtual void CheckChargedAttack() = 0;
+
+	/** Notifies the attacker that damage it sent was applied to a target. Called by the damage pipeline */
+	UFUNCTION(BlueprintCallable, Category="Attacker")
+	virtual void NotifyDamageDealt(AActor* Target, float Damage, const FVector& ImpactPoint) {}
 };
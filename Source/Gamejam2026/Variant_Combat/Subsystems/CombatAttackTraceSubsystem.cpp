@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatAttackTraceSubsystem.h"
+#include "CombatStats.h"
+#include "CombatAttacker.h"
+#include "CombatBoxSubsystem.h"
+#include "Engine/World.h"
+#include "CollisionQueryParams.h"
+
+void UCombatAttackTraceSubsystem::BeginSwing(AActor* Attacker)
+{
+	// reset the hit list for this attacker, keeping its allocation
+	if (TSet<TObjectKey<AActor>>* HitActors = SwingHits.Find(Attacker))
+	{
+		HitActors->Reset();
+	}
+}
+
+void UCombatAttackTraceSubsystem::QueueAttackTrace(AActor* Attacker, const FVector& Start, const FVector& End, float Radius, const FCollisionObjectQueryParams& ObjectParams)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(AttackTraces);
+	COMBAT_INC_COUNTER(TracesPerFrame, 1);
+
+	// ensure the attacker is valid
+	if (!IsValid(Attacker))
+	{
+		return;
+	}
+
+	// ignore the attacker
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatAttackTrace), false, Attacker);
+
+	// issue the sweep. It will run along with the rest of the frame's async traces
+	FCombatAttackTraceRequest& Request = PendingTraces.AddDefaulted_GetRef();
+	Request.Attacker = Attacker;
+	Request.TraceHandle = GetWorld()->AsyncSweepByObjectType(EAsyncTraceType::Multi, Start, End, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Radius), QueryParams);
+}
+
+bool UCombatAttackTraceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatAttackTraceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// resolve hits early in the frame, before characters and AI tick
+	ResolveTickFunction.OnTick.BindUObject(this, &UCombatAttackTraceSubsystem::ResolvePendingTraces);
+	ResolveTickFunction.Register(&InWorld, TG_PrePhysics, true, TEXT("CombatAttackTraces"));
+}
+
+void UCombatAttackTraceSubsystem::Deinitialize()
+{
+	ResolveTickFunction.Unregister();
+
+	PendingTraces.Empty();
+	SwingHits.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatAttackTraceSubsystem::ResolvePendingTraces(float DeltaTime)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(AttackTraces);
+
+	// drop the hit lists for attackers that no longer exist
+	if (PendingTraces.Num() == 0)
+	{
+		for (auto It = SwingHits.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	UCombatBoxSubsystem* Boxes = World->GetSubsystem<UCombatBoxSubsystem>();
+
+	FTraceDatum TraceDatum;
+
+	for (int32 Index = 0; Index < PendingTraces.Num(); ++Index)
+	{
+		const FCombatAttackTraceRequest& Request = PendingTraces[Index];
+
+		// are the results ready?
+		if (!World->QueryTraceData(Request.TraceHandle, TraceDatum))
+		{
+			// traces issued this frame will be ready on the next one
+			if (World->IsTraceHandleValid(Request.TraceHandle, false))
+			{
+				continue;
+			}
+
+			// the results have expired, so drop the request
+			PendingTraces.RemoveAtSwap(Index--, EAllowShrinking::No);
+			continue;
+		}
+
+		// ensure the attacker is still around and able to receive hits
+		AActor* AttackerActor = Request.Attacker.Get();
+		ICombatAttacker* Attacker = Cast<ICombatAttacker>(AttackerActor);
+
+		if (Attacker)
+		{
+			TSet<TObjectKey<AActor>>& HitActors = SwingHits.FindOrAdd(AttackerActor);
+
+			for (const FHitResult& TraceHit : TraceDatum.OutHits)
+			{
+				// hits on instanced boxes are redirected to the box's promoted actor
+				FHitResult PromotedHit;
+				const FHitResult& CurrentHit = Boxes && Boxes->PromoteHitInstance(TraceHit, PromotedHit) ? PromotedHit : TraceHit;
+
+				AActor* HitActor = CurrentHit.GetActor();
+
+				// only hit each actor once per swing
+				if (!HitActor || HitActors.Contains(HitActor))
+				{
+					continue;
+				}
+
+				HitActors.Add(HitActor);
+
+				// let the attacker apply damage and effects
+				Attacker->ApplyAttackHit(CurrentHit);
+			}
+		}
+
+		PendingTraces.RemoveAtSwap(Index--, EAllowShrinking::No);
+	}
+}
@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "UObject/ObjectKey.h"
+#include "GameWorldTickFunction.h"
+#include "CombatAttackTraceSubsystem.generated.h"
+
+/**
+ *  A melee attack sweep queued for deferred resolution
+ */
+struct FCombatAttackTraceRequest
+{
+	/** Actor performing the attack. Receives the resolved hits */
+	TWeakObjectPtr<AActor> Attacker;
+
+	/** Handle to the async sweep issued for this request */
+	FTraceHandle TraceHandle;
+};
+
+/**
+ *  Collects melee attack traces requested by attack AnimNotifies during the frame,
+ *  issues them as async sweeps and resolves all their hits in one pass at the start of the next frame.
+ *  Each attacker hits an actor at most once per swing.
+ */
+UCLASS()
+class UCombatAttackTraceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Tick function that resolves the queued traces */
+	FGameWorldTickFunction ResolveTickFunction;
+
+	/** Traces waiting for their async results */
+	TArray<FCombatAttackTraceRequest> PendingTraces;
+
+	/** Actors already hit during each attacker's current swing */
+	TMap<TObjectKey<AActor>, TSet<TObjectKey<AActor>>> SwingHits;
+
+public:
+
+	/** Starts a new swing for the attacker, allowing previously hit actors to be hit again */
+	void BeginSwing(AActor* Attacker);
+
+	/** Issues an async sphere sweep for the attacker. Hits are routed back through ICombatAttacker::ApplyAttackHit */
+	void QueueAttackTrace(AActor* Attacker, const FVector& Start, const FVector& End, float Radius, const FCollisionObjectQueryParams& ObjectParams);
+
+	/** Returns the number of traces waiting to be resolved */
+	int32 GetNumPendingTraces() const { return PendingTraces.Num(); }
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the resolve tick function */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Resolves all traces with results available, deduplicating hits per swing */
+	void ResolvePendingTraces(float DeltaTime);
+};
@@ -0,0 +1,516 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatBoxSubsystem.h"
+#include "CombatStats.h"
+#include "CombatDamageableBox.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Gamejam2026.h"
+
+static bool GCombatBoxesInstanced = true;
+static FAutoConsoleVariableRef CVarCombatBoxesInstanced(
+	TEXT("Combat.Boxes.Instanced"),
+	GCombatBoxesInstanced,
+	TEXT("If true, damageable boxes registered from now on are drawn as instances while at rest and pooled when destroyed"),
+	ECVF_Default
+);
+
+static float GCombatBoxesDemoteDelay = 1.0f;
+static FAutoConsoleVariableRef CVarCombatBoxesDemoteDelay(
+	TEXT("Combat.Boxes.DemoteDelay"),
+	GCombatBoxesDemoteDelay,
+	TEXT("Time a promoted box's body must stay asleep before it's turned back into an instance, in seconds"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithWorld CombatBoxesStatsCommand(
+	TEXT("Combat.Boxes.Stats"),
+	TEXT("Logs the number of instanced, simulated and pooled boxes, awake bodies and the physics step time"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UCombatBoxSubsystem* Boxes = World ? World->GetSubsystem<UCombatBoxSubsystem>() : nullptr)
+		{
+			Boxes->DumpStats();
+		}
+	})
+);
+
+void UCombatBoxSubsystem::RegisterBox(ACombatDamageableBox* Box)
+{
+	// pooled boxes are already tracked by their records
+	if (bSpawningPooledBox || !GCombatBoxesInstanced || !Box || Box->GetBoxRecord() != INDEX_NONE || !Box->GetMesh()->GetStaticMesh())
+	{
+		return;
+	}
+
+	// start as a promoted box, so boxes placed in the air still fall.
+	// It's demoted to an instance once its body goes to sleep
+	const int32 RecordIndex = Records.Add(FCombatBoxRecord());
+
+	FCombatBoxRecord& Record = Records[RecordIndex];
+	Record.Actor = Box;
+	Record.Batch = FindOrAddBatch(Box);
+	Record.HP = Box->GetCurrentHP();
+	Record.Serial = NextRecordSerial++;
+
+	Box->SetBoxRecord(RecordIndex);
+	PromotedRecords.Add(RecordIndex);
+}
+
+void UCombatBoxSubsystem::UnregisterBox(ACombatDamageableBox* Box)
+{
+	// drop the box from the pool
+	for (FCombatBoxBatch& Batch : Batches)
+	{
+		Batch.FreeBoxes.RemoveSingleSwap(Box, EAllowShrinking::No);
+	}
+
+	// drop the record for the box, unless it's already been handed over to an instance
+	const int32 RecordIndex = Box->GetBoxRecord();
+
+	if (Records.IsValidIndex(RecordIndex) && Records[RecordIndex].Actor == Box)
+	{
+		PromotedRecords.RemoveSingleSwap(RecordIndex, EAllowShrinking::No);
+		Records.RemoveAt(RecordIndex);
+	}
+
+	Box->SetBoxRecord(INDEX_NONE);
+}
+
+bool UCombatBoxSubsystem::ReleaseBox(ACombatDamageableBox* Box)
+{
+	const int32 RecordIndex = Box->GetBoxRecord();
+
+	if (!Records.IsValidIndex(RecordIndex) || Records[RecordIndex].Actor != Box)
+	{
+		return false;
+	}
+
+	const int32 BatchIndex = Records[RecordIndex].Batch;
+
+	// retire the record
+	PromotedRecords.RemoveSingleSwap(RecordIndex, EAllowShrinking::No);
+	Records.RemoveAt(RecordIndex);
+
+	// park the actor so it can be reused for the next promotion
+	Box->SetBoxRecord(INDEX_NONE);
+	Box->DeactivateForPool();
+
+	Batches[BatchIndex].FreeBoxes.Add(Box);
+
+	return true;
+}
+
+bool UCombatBoxSubsystem::PromoteHitInstance(const FHitResult& Hit, FHitResult& OutPromotedHit)
+{
+	const int32 BatchIndex = FindBatch(Hit.GetComponent());
+
+	if (BatchIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const int32 InstanceIndex = FindHitInstance(Batches[BatchIndex], Hit, false);
+
+	if (InstanceIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	ACombatDamageableBox* Box = Promote(Batches[BatchIndex].InstanceRecords[InstanceIndex]);
+
+	if (!Box)
+	{
+		return false;
+	}
+
+	// point the hit at the promoted actor
+	OutPromotedHit = Hit;
+	OutPromotedHit.HitObjectHandle = FActorInstanceHandle(Box);
+	OutPromotedHit.Component = Box->GetMesh();
+	OutPromotedHit.Item = INDEX_NONE;
+
+	return true;
+}
+
+void UCombatBoxSubsystem::DumpStats() const
+{
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat boxes: %d boxes, %d instanced, %d simulated (%d awake bodies), %d pooled actors"),
+		Stats.Boxes, Stats.Instanced, Stats.Promoted, Stats.AwakeBodies, Stats.Pooled);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat boxes: %d promotions, %d demotions, %d actors spawned, %d batches"),
+		Stats.Promotions, Stats.Demotions, Stats.Spawned, Batches.Num());
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat boxes: physics step %.3f ms last frame, %.3f ms peak"),
+		Stats.PhysicsStepMs, Stats.PeakPhysicsStepMs);
+}
+
+bool UCombatBoxSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatBoxSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// promote bumped boxes before physics runs, so they simulate this frame
+	PromoteTickFunction.OnTick.BindUObject(this, &UCombatBoxSubsystem::ProcessPromotions);
+	PromoteTickFunction.Register(&InWorld, TG_PrePhysics, false, TEXT("CombatBoxPromote"));
+
+	// bracket the physics step to time it. Order within a tick group is undefined,
+	// so the world's start physics waits for our start marker, and our end marker waits for the world's end physics
+	PhysicsStartTickFunction.OnTick.BindUObject(this, &UCombatBoxSubsystem::BeginPhysicsStep);
+	PhysicsStartTickFunction.Register(&InWorld, TG_StartPhysics, false, TEXT("CombatBoxPhysicsStart"));
+	InWorld.StartPhysicsTickFunction.AddPrerequisite(this, PhysicsStartTickFunction);
+
+	PhysicsEndTickFunction.OnTick.BindUObject(this, &UCombatBoxSubsystem::EndPhysicsStep);
+	PhysicsEndTickFunction.Register(&InWorld, TG_EndPhysics, true, TEXT("CombatBoxPhysicsEnd"));
+	PhysicsEndTickFunction.AddPrerequisite(&InWorld, InWorld.EndPhysicsTickFunction);
+}
+
+void UCombatBoxSubsystem::Deinitialize()
+{
+	// don't leave the world's start physics waiting on a tick function that's going away
+	GetWorld()->StartPhysicsTickFunction.RemovePrerequisite(this, PhysicsStartTickFunction);
+
+	PromoteTickFunction.Unregister();
+	PhysicsStartTickFunction.Unregister();
+	PhysicsEndTickFunction.Unregister();
+
+	Batches.Empty();
+	Records.Empty();
+	PromotedRecords.Empty();
+	PendingPromotions.Empty();
+	InstanceOwner = nullptr;
+
+	Super::Deinitialize();
+}
+
+int32 UCombatBoxSubsystem::FindOrAddBatch(ACombatDamageableBox* Box)
+{
+	UStaticMeshComponent* BoxMesh = Box->GetMesh();
+
+	const int32 Existing = Batches.IndexOfByPredicate([Box, BoxMesh](const FCombatBoxBatch& Batch)
+	{
+		return Batch.BoxClass == Box->GetClass() && Batch.Mesh == BoxMesh->GetStaticMesh();
+	});
+
+	if (Existing != INDEX_NONE)
+	{
+		return Existing;
+	}
+
+	// create the owner for the instance components
+	if (!InstanceOwner)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+
+		InstanceOwner = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		InstanceOwner->SetRootComponent(NewObject<USceneComponent>(InstanceOwner, TEXT("Root")));
+		InstanceOwner->GetRootComponent()->RegisterComponent();
+	}
+
+	// match the box's look and collision, minus the rigid body
+	UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(InstanceOwner);
+	Instances->SetStaticMesh(BoxMesh->GetStaticMesh());
+
+	for (int32 i = 0; i < BoxMesh->GetNumMaterials(); ++i)
+	{
+		Instances->SetMaterial(i, BoxMesh->GetMaterial(i));
+	}
+
+	Instances->SetMobility(EComponentMobility::Movable);
+	Instances->SetCollisionProfileName(BoxMesh->GetCollisionProfileName());
+	Instances->SetNotifyRigidBodyCollision(true);
+	Instances->SetCanEverAffectNavigation(false);
+	Instances->SetupAttachment(InstanceOwner->GetRootComponent());
+	Instances->RegisterComponent();
+
+	// promote boxes that get bumped
+	Instances->OnComponentHit.AddDynamic(this, &UCombatBoxSubsystem::OnInstanceHit);
+
+	FCombatBoxBatch& Batch = Batches.AddDefaulted_GetRef();
+	Batch.BoxClass = Box->GetClass();
+	Batch.Mesh = BoxMesh->GetStaticMesh();
+	Batch.Instances = Instances;
+
+	return Batches.Num() - 1;
+}
+
+int32 UCombatBoxSubsystem::FindBatch(const UPrimitiveComponent* Component) const
+{
+	if (!Component || Component->GetOwner() != InstanceOwner)
+	{
+		return INDEX_NONE;
+	}
+
+	return Batches.IndexOfByPredicate([Component](const FCombatBoxBatch& Batch) { return Batch.Instances == Component; });
+}
+
+void UCombatBoxSubsystem::AddInstance(int32 RecordIndex)
+{
+	FCombatBoxRecord& Record = Records[RecordIndex];
+	FCombatBoxBatch& Batch = Batches[Record.Batch];
+
+	Record.Instance = Batch.Instances->AddInstance(Record.Transform, true);
+	check(Record.Instance == Batch.InstanceRecords.Num());
+
+	Batch.InstanceRecords.Add(RecordIndex);
+}
+
+void UCombatBoxSubsystem::RemoveInstance(int32 RecordIndex)
+{
+	FCombatBoxRecord& Record = Records[RecordIndex];
+	FCombatBoxBatch& Batch = Batches[Record.Batch];
+
+	const int32 InstanceIndex = Record.Instance;
+	Record.Instance = INDEX_NONE;
+
+	// removing an instance shifts the ones after it down, so fix up their records
+	Batch.Instances->RemoveInstance(InstanceIndex);
+	Batch.InstanceRecords.RemoveAt(InstanceIndex, EAllowShrinking::No);
+
+	for (int32 i = InstanceIndex; i < Batch.InstanceRecords.Num(); ++i)
+	{
+		Records[Batch.InstanceRecords[i]].Instance = i;
+	}
+}
+
+void UCombatBoxSubsystem::QueuePromotion(int32 RecordIndex)
+{
+	PendingPromotions.AddUnique(TPair<int32, uint32>(RecordIndex, Records[RecordIndex].Serial));
+}
+
+ACombatDamageableBox* UCombatBoxSubsystem::Promote(int32 RecordIndex)
+{
+	if (!Records.IsValidIndex(RecordIndex))
+	{
+		return nullptr;
+	}
+
+	// already promoted?
+	if (Records[RecordIndex].Instance == INDEX_NONE)
+	{
+		return Records[RecordIndex].Actor.Get();
+	}
+
+	RemoveInstance(RecordIndex);
+
+	FCombatBoxRecord& Record = Records[RecordIndex];
+	FCombatBoxBatch& Batch = Batches[Record.Batch];
+
+	// reuse a parked box actor if we have one
+	ACombatDamageableBox* Box = nullptr;
+
+	while (!Box && Batch.FreeBoxes.Num() > 0)
+	{
+		Box = Batch.FreeBoxes.Pop(EAllowShrinking::No);
+	}
+
+	if (!Box)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags |= RF_Transient;
+
+		// keep the new box from registering itself as a placed box
+		TGuardValue<bool> SpawnGuard(bSpawningPooledBox, true);
+
+		Box = GetWorld()->SpawnActor<ACombatDamageableBox>(Batch.BoxClass, Record.Transform, SpawnParams);
+		++Stats.Spawned;
+
+		if (!Box)
+		{
+			// couldn't spawn, so put the instance back
+			AddInstance(RecordIndex);
+			return nullptr;
+		}
+	}
+
+	Box->ActivateFromPool(Record.Transform, Record.HP);
+	Box->SetBoxRecord(RecordIndex);
+
+	Record.Actor = Box;
+	Record.SleepingSince = -1.0;
+
+	PromotedRecords.Add(RecordIndex);
+	++Stats.Promotions;
+
+	// whatever is stacked on this box may start moving too
+	PromoteSupported(Record.Transform, Batch.Mesh);
+
+	return Box;
+}
+
+void UCombatBoxSubsystem::Demote(int32 RecordIndex)
+{
+	FCombatBoxRecord& Record = Records[RecordIndex];
+	ACombatDamageableBox* Box = Record.Actor.Get();
+
+	// save the resting state
+	Record.Transform = Box->GetMesh()->GetComponentTransform();
+	Record.HP = Box->GetCurrentHP();
+	Record.Actor = nullptr;
+
+	// park the actor
+	Box->SetBoxRecord(INDEX_NONE);
+	Box->DeactivateForPool();
+
+	Batches[Record.Batch].FreeBoxes.Add(Box);
+
+	AddInstance(RecordIndex);
+	++Stats.Demotions;
+}
+
+void UCombatBoxSubsystem::PromoteSupported(const FTransform& Transform, const UStaticMesh* Mesh)
+{
+	if (!Mesh)
+	{
+		return;
+	}
+
+	// look for instances touching the top face of the box
+	const FBox Bounds = Mesh->GetBoundingBox().TransformBy(Transform);
+	const FVector Extent = Bounds.GetExtent();
+
+	const FVector ProbeLocation = Bounds.GetCenter() + FVector::UpVector * (Extent.Z + 5.0f);
+	const float ProbeRadius = FMath::Min(Extent.X, Extent.Y) * 0.5f;
+
+	for (FCombatBoxBatch& Batch : Batches)
+	{
+		for (const int32 InstanceIndex : Batch.Instances->GetInstancesOverlappingSphere(ProbeLocation, ProbeRadius))
+		{
+			QueuePromotion(Batch.InstanceRecords[InstanceIndex]);
+		}
+	}
+}
+
+void UCombatBoxSubsystem::OnInstanceHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+	const int32 BatchIndex = FindBatch(HitComponent);
+
+	if (BatchIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// defer the promotion, we may be in the middle of a move or a physics callback
+	const int32 InstanceIndex = FindHitInstance(Batches[BatchIndex], Hit, true);
+
+	if (InstanceIndex != INDEX_NONE)
+	{
+		QueuePromotion(Batches[BatchIndex].InstanceRecords[InstanceIndex]);
+	}
+}
+
+int32 UCombatBoxSubsystem::FindHitInstance(const FCombatBoxBatch& Batch, const FHitResult& Hit, bool bReversed) const
+{
+	// hits dispatched to the component that was run into have their items reversed
+	const int32 HitItem = bReversed ? Hit.MyItem : Hit.Item;
+
+	// the hit item may be stale if instances were removed since the hit was generated, so check it's still the same box
+	if (Batch.InstanceRecords.IsValidIndex(HitItem))
+	{
+		FTransform InstanceTransform;
+		Batch.Instances->GetInstanceTransform(HitItem, InstanceTransform, true);
+
+		if (Batch.Mesh->GetBoundingBox().TransformBy(InstanceTransform).ExpandBy(10.0f).IsInside(Hit.ImpactPoint))
+		{
+			return HitItem;
+		}
+	}
+
+	// fall back to the instance closest to the impact point
+	const TArray<int32> Overlapping = Batch.Instances->GetInstancesOverlappingSphere(Hit.ImpactPoint, 10.0f);
+
+	return Overlapping.Num() > 0 ? Overlapping[0] : INDEX_NONE;
+}
+
+void UCombatBoxSubsystem::ProcessPromotions(float DeltaTime)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(Boxes);
+
+	// promoting may queue the boxes stacked on top, which get promoted on the next frame
+	TArray<TPair<int32, uint32>, TInlineAllocator<16>> ToPromote(PendingPromotions);
+	PendingPromotions.Reset();
+
+	for (const TPair<int32, uint32>& Pending : ToPromote)
+	{
+		// the record may have been retired, and its slot reused by another box, since it was queued
+		if (Records.IsValidIndex(Pending.Key) && Records[Pending.Key].Serial == Pending.Value)
+		{
+			Promote(Pending.Key);
+		}
+	}
+}
+
+void UCombatBoxSubsystem::BeginPhysicsStep(float DeltaTime)
+{
+	PhysicsStartTime = FPlatformTime::Seconds();
+}
+
+void UCombatBoxSubsystem::EndPhysicsStep(float DeltaTime)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(Boxes);
+
+	// time the physics step, including any wait on the physics thread
+	Stats.PhysicsStepMs = (FPlatformTime::Seconds() - PhysicsStartTime) * 1000.0;
+	Stats.PeakPhysicsStepMs = FMath::Max(Stats.PeakPhysicsStepMs, Stats.PhysicsStepMs);
+
+	// demote the boxes that have settled
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	Stats.AwakeBodies = 0;
+
+	for (int32 i = PromotedRecords.Num() - 1; i >= 0; --i)
+	{
+		const int32 RecordIndex = PromotedRecords[i];
+		FCombatBoxRecord& Record = Records[RecordIndex];
+		ACombatDamageableBox* Box = Record.Actor.Get();
+
+		if (!Box)
+		{
+			continue;
+		}
+
+		if (Box->GetMesh()->RigidBodyIsAwake())
+		{
+			Record.SleepingSince = -1.0;
+			++Stats.AwakeBodies;
+			continue;
+		}
+
+		// destroyed boxes stay around as debris until they're released
+		if (Box->IsDead())
+		{
+			continue;
+		}
+
+		if (Record.SleepingSince < 0.0)
+		{
+			Record.SleepingSince = Now;
+		}
+		else if (Now - Record.SleepingSince >= GCombatBoxesDemoteDelay)
+		{
+			PromotedRecords.RemoveAtSwap(i, EAllowShrinking::No);
+			Demote(RecordIndex);
+		}
+	}
+
+	Stats.Boxes = Records.Num();
+	Stats.Promoted = PromotedRecords.Num();
+	Stats.Instanced = Stats.Boxes - Stats.Promoted;
+	Stats.Pooled = 0;
+
+	for (const FCombatBoxBatch& Batch : Batches)
+	{
+		Stats.Pooled += Batch.FreeBoxes.Num();
+	}
+}
@@ -0,0 +1,242 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/SparseArray.h"
+#include "GameWorldTickFunction.h"
+#include "CombatBoxSubsystem.generated.h"
+
+class ACombatDamageableBox;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+class UPrimitiveComponent;
+
+/**
+ *  Running statistics for the damageable box manager
+ */
+USTRUCT(BlueprintType)
+struct FCombatBoxStats
+{
+	GENERATED_BODY()
+
+	/** Number of live boxes, both instanced and simulated */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Boxes")
+	int32 Boxes = 0;
+
+	/** Number of boxes at rest, drawn as instances */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Boxes")
+	int32 Instanced = 0;
+
+	/** Number of boxes promoted to simulated actors */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Boxes")
+	int32 Promoted = 0;
+
+	/** Number of promoted boxes with an awake rigid body last frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Boxes")
+	int32 AwakeBodies = 0;
+
+	/** Number of box actors parked in the debris pool */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Boxes")
+	int32 Pooled = 0;
+
+	/** Total promotions from instance to actor */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Boxes")
+	int32 Promotions = 0;
+
+	/** Total demotions from actor back to instance */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Boxes")
+	int32 Demotions = 0;
+
+	/** Total box actors spawned because the pool was empty */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Boxes")
+	int32 Spawned = 0;
+
+	/** Time from just before the world started physics to just after it finished, last frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Boxes", meta = (Units = "ms"))
+	float PhysicsStepMs = 0.0f;
+
+	/** Worst physics step time seen so far */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Boxes", meta = (Units = "ms"))
+	float PeakPhysicsStepMs = 0.0f;
+};
+
+/**
+ *  A damageable box tracked by the box manager
+ */
+struct FCombatBoxRecord
+{
+	/** Simulated actor for the box, while it's promoted */
+	TWeakObjectPtr<ACombatDamageableBox> Actor;
+
+	/** Batch the box is drawn with */
+	int32 Batch = INDEX_NONE;
+
+	/** Index of the box's instance in its batch, or INDEX_NONE while promoted */
+	int32 Instance = INDEX_NONE;
+
+	/** Transform of the box while it's instanced */
+	FTransform Transform;
+
+	/** HP of the box while it's instanced */
+	float HP = 0.0f;
+
+	/** Game time the promoted body fell asleep, or a negative value while it's awake */
+	double SleepingSince = -1.0;
+
+	/** Unique id of the record, so references to a reused sparse array slot can be told apart */
+	uint32 Serial = 0;
+};
+
+/**
+ *  Instances and pooled actors for one box class and mesh
+ */
+USTRUCT()
+struct FCombatBoxBatch
+{
+	GENERATED_BODY()
+
+	/** Box class promoted boxes are spawned from */
+	UPROPERTY()
+	TSubclassOf<ACombatDamageableBox> BoxClass;
+
+	/** Box mesh */
+	UPROPERTY()
+	TObjectPtr<UStaticMesh> Mesh;
+
+	/** Instances for the boxes at rest */
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> Instances;
+
+	/** Box actors parked in the pool, ready to be promoted into */
+	UPROPERTY()
+	TArray<TObjectPtr<ACombatDamageableBox>> FreeBoxes;
+
+	/** Record index for each instance */
+	TArray<int32> InstanceRecords;
+};
+
+/**
+ *  Manages damageable boxes so only the moving ones are simulated.
+ *  Boxes at rest are drawn as static mesh instances with query and physics collision, but no rigid body.
+ *  A box is promoted to a simulated actor when it's hit by an attack or bumped, and demoted back
+ *  to an instance once its body has been asleep for a while. Destroyed boxes are parked in a pool
+ *  and reused for later promotions instead of being spawned and destroyed.
+ */
+UCLASS()
+class UCombatBoxSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Box batches, one per box class and mesh */
+	UPROPERTY()
+	TArray<FCombatBoxBatch> Batches;
+
+	/** Actor that owns the instance components */
+	UPROPERTY()
+	TObjectPtr<AActor> InstanceOwner;
+
+	/** Live boxes */
+	TSparseArray<FCombatBoxRecord> Records;
+
+	/** Records for the boxes currently promoted to actors */
+	TArray<int32> PromotedRecords;
+
+	/** Records waiting to be promoted on the next pre-physics tick, along with the serial they were queued for */
+	TArray<TPair<int32, uint32>> PendingPromotions;
+
+	/** Serial handed out to the next record */
+	uint32 NextRecordSerial = 1;
+
+	/** Tick function that processes pending promotions */
+	FGameWorldTickFunction PromoteTickFunction;
+
+	/** Tick function that marks the start of the physics step. The world's start physics tick waits for it */
+	FGameWorldTickFunction PhysicsStartTickFunction;
+
+	/** Tick function that measures the physics step and demotes sleeping boxes. Waits for the world's end physics tick */
+	FGameWorldTickFunction PhysicsEndTickFunction;
+
+	/** Time the physics step started this frame */
+	double PhysicsStartTime = 0.0;
+
+	/** If true, we're spawning a box for the pool, so it shouldn't register itself */
+	bool bSpawningPooledBox = false;
+
+	/** Statistics */
+	FCombatBoxStats Stats;
+
+public:
+
+	/** Starts managing a box placed in the level. Boxes at rest are converted to instances right away */
+	void RegisterBox(ACombatDamageableBox* Box);
+
+	/** Stops managing a box actor that's leaving the world */
+	void UnregisterBox(ACombatDamageableBox* Box);
+
+	/** Retires a destroyed box and parks its actor in the pool. Returns false if the box isn't managed */
+	bool ReleaseBox(ACombatDamageableBox* Box);
+
+	/** If the hit is on a box instance, promotes the box and fills out a copy of the hit pointing to its actor */
+	bool PromoteHitInstance(const FHitResult& Hit, FHitResult& OutPromotedHit);
+
+	/** Returns the statistics */
+	const FCombatBoxStats& GetStats() const { return Stats; }
+
+	/** Writes the statistics to the log */
+	void DumpStats() const;
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the tick functions */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Returns the batch for the box's class and mesh, creating it if needed */
+	int32 FindOrAddBatch(ACombatDamageableBox* Box);
+
+	/** Returns the batch drawn by the given component */
+	int32 FindBatch(const UPrimitiveComponent* Component) const;
+
+	/** Adds an instance for the record */
+	void AddInstance(int32 RecordIndex);
+
+	/** Removes the record's instance */
+	void RemoveInstance(int32 RecordIndex);
+
+	/** Queues the record to be promoted on the next pre-physics tick */
+	void QueuePromotion(int32 RecordIndex);
+
+	/** Swaps the instanced box for a simulated actor, returning the actor */
+	ACombatDamageableBox* Promote(int32 RecordIndex);
+
+	/** Swaps the resting box actor for an instance */
+	void Demote(int32 RecordIndex);
+
+	/** Queues promotions for the instances resting on top of a box that just started moving */
+	void PromoteSupported(const FTransform& Transform, const UStaticMesh* Mesh);
+
+	/** Instance hit handler, used to promote boxes bumped by moving actors or bodies */
+	UFUNCTION()
+	void OnInstanceHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
+	/** Finds the instance index for a hit on a batch */
+	int32 FindHitInstance(const FCombatBoxBatch& Batch, const FHitResult& Hit, bool bReversed) const;
+
+	/** Processes the pending promotions */
+	void ProcessPromotions(float DeltaTime);
+
+	/** Marks the start of the physics step */
+	void BeginPhysicsStep(float DeltaTime);
+
+	/** Measures the physics step and demotes boxes that have been asleep long enough */
+	void EndPhysicsStep(float DeltaTime);
+};
@@ -0,0 +1,423 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatCrowdSubsystem.h"
+#include "CombatStats.h"
+#include "CombatEnemy.h"
+#include "CombatEnemySpawner.h"
+#include "CombatEnemyPoolSubsystem.h"
+#include "PlayerSnapshotSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Gamejam2026.h"
+
+static int32 GCombatCrowdMaxPromoted = 30;
+static FAutoConsoleVariableRef CVarCombatCrowdMaxPromoted(
+	TEXT("Combat.Crowd.MaxPromoted"),
+	GCombatCrowdMaxPromoted,
+	TEXT("Maximum number of crowd enemies promoted to full actors at the same time"),
+	ECVF_Default
+);
+
+static int32 GCombatCrowdMaxPromotionsPerFrame = 2;
+static FAutoConsoleVariableRef CVarCombatCrowdMaxPromotionsPerFrame(
+	TEXT("Combat.Crowd.MaxPromotionsPerFrame"),
+	GCombatCrowdMaxPromotionsPerFrame,
+	TEXT("Maximum number of crowd enemies promoted to full actors in a single frame"),
+	ECVF_Default
+);
+
+static float GCombatCrowdPromoteDistance = 2000.0f;
+static FAutoConsoleVariableRef CVarCombatCrowdPromoteDistance(
+	TEXT("Combat.Crowd.PromoteDistance"),
+	GCombatCrowdPromoteDistance,
+	TEXT("Distance to the player at which crowd enemies are promoted to full actors, in cm"),
+	ECVF_Default
+);
+
+static float GCombatCrowdDemoteDistance = 2600.0f;
+static FAutoConsoleVariableRef CVarCombatCrowdDemoteDistance(
+	TEXT("Combat.Crowd.DemoteDistance"),
+	GCombatCrowdDemoteDistance,
+	TEXT("Distance to the player at which promoted enemies are demoted back to crowd entities, in cm. Should be larger than the promote distance"),
+	ECVF_Default
+);
+
+namespace
+{
+	/** Number of distinct gathering slots around the player. Slots are reused past this count */
+	constexpr int32 MaxCrowdSlots = 64;
+}
+
+static FAutoConsoleCommandWithWorld CombatCrowdStatsCommand(
+	TEXT("Combat.Crowd.Stats"),
+	TEXT("Logs the number of crowd entities and promoted enemies"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UCombatCrowdSubsystem* Crowd = World ? World->GetSubsystem<UCombatCrowdSubsystem>() : nullptr)
+		{
+			Crowd->DumpStats();
+		}
+	})
+);
+
+bool UCombatCrowdSubsystem::AddEntity(ACombatEnemySpawner* Spawner, TSubclassOf<ACombatEnemy> EnemyClass, const FVector& Location, float Yaw)
+{
+	const int32 Archetype = FindOrAddArchetype(Spawner, EnemyClass);
+
+	if (Archetype == INDEX_NONE)
+	{
+		return false;
+	}
+
+	EntityArchetypes.Add(Archetype);
+	EntityLocations.Add(Location);
+	EntityYaws.Add(Yaw);
+	EntityHP.Add(Archetypes[Archetype].MaxHP);
+	EntitySlotOffsets.Add(MakeSlotOffset(Archetypes[Archetype]));
+
+	return true;
+}
+
+void UCombatCrowdSubsystem::DumpStats() const
+{
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat crowd: %d entities, %d promoted (%d promotions, %d demotions, %d blocked promotions), %.3f ms simulation"),
+		Stats.Entities, Stats.Promoted, Stats.TotalPromotions, Stats.TotalDemotions, Stats.BlockedPromotions, Stats.SimulationTimeMs);
+}
+
+bool UCombatCrowdSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatCrowdSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// simulate the crowd early in the frame, so promoted actors tick normally on the same frame
+	SimulateTickFunction.OnTick.BindUObject(this, &UCombatCrowdSubsystem::Simulate);
+	SimulateTickFunction.Register(&InWorld, TG_PrePhysics, false, TEXT("CombatCrowd"));
+}
+
+void UCombatCrowdSubsystem::Deinitialize()
+{
+	SimulateTickFunction.Unregister();
+
+	Archetypes.Empty();
+	EntityArchetypes.Empty();
+	EntityLocations.Empty();
+	EntityYaws.Empty();
+	EntityHP.Empty();
+	EntitySlotOffsets.Empty();
+	PromotedEnemies.Empty();
+	ProxyTransforms.Empty();
+	NewProxyTransforms.Empty();
+	ProxyOwner = nullptr;
+
+	Super::Deinitialize();
+}
+
+int32 UCombatCrowdSubsystem::FindOrAddArchetype(ACombatEnemySpawner* Spawner, TSubclassOf<ACombatEnemy> EnemyClass)
+{
+	// ensure the spawner and class are valid
+	if (!IsValid(Spawner) || !IsValid(EnemyClass))
+	{
+		return INDEX_NONE;
+	}
+
+	// reuse the archetype for this spawner if we have one
+	for (int32 i = 0; i < Archetypes.Num(); ++i)
+	{
+		if (Archetypes[i].Spawner == Spawner && Archetypes[i].EnemyClass == EnemyClass)
+		{
+			return i;
+		}
+	}
+
+	const ACombatEnemy* EnemyCDO = EnemyClass->GetDefaultObject<ACombatEnemy>();
+	const FCombatEnemyCrowdSettings& Settings = Spawner->GetCrowdSettings();
+
+	FCombatCrowdArchetype& Archetype = Archetypes.AddDefaulted_GetRef();
+	Archetype.EnemyClass = EnemyClass;
+	Archetype.Spawner = Spawner;
+	Archetype.ProxyMesh = Settings.ProxyMesh;
+	Archetype.MaxHP = EnemyCDO->GetMaxHP();
+	Archetype.CapsuleHalfHeight = EnemyCDO->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	Archetype.CapsuleRadius = EnemyCDO->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	Archetype.MoveSpeed = Settings.MoveSpeed;
+	Archetype.AttackRange = Settings.AttackRange;
+
+	// set up the proxy renderer
+	if (Archetype.ProxyMesh)
+	{
+		if (!ProxyOwner)
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.ObjectFlags |= RF_Transient;
+
+			ProxyOwner = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+			ProxyOwner->SetRootComponent(NewObject<USceneComponent>(ProxyOwner, TEXT("Root")));
+			ProxyOwner->GetRootComponent()->RegisterComponent();
+		}
+
+		UInstancedStaticMeshComponent* ProxyComponent = NewObject<UInstancedStaticMeshComponent>(ProxyOwner);
+		ProxyComponent->SetStaticMesh(Archetype.ProxyMesh);
+		ProxyComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		ProxyComponent->SetMobility(EComponentMobility::Movable);
+		ProxyComponent->SetupAttachment(ProxyOwner->GetRootComponent());
+		ProxyComponent->RegisterComponent();
+
+		Archetype.ProxyComponent = ProxyComponent;
+	}
+
+	return Archetypes.Num() - 1;
+}
+
+void UCombatCrowdSubsystem::Simulate(float DeltaTime)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(Crowd);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	const FPlayerSnapshot* PlayerSnapshot = UPlayerSnapshotSubsystem::Get(this);
+
+	if (!PlayerSnapshot || !PlayerSnapshot->IsValid())
+	{
+		return;
+	}
+
+	const FVector PlayerLocation = PlayerSnapshot->Location;
+	const float PromoteDistanceSquared = FMath::Square(GCombatCrowdPromoteDistance);
+	const float DemoteDistanceSquared = FMath::Square(FMath::Max(GCombatCrowdDemoteDistance, GCombatCrowdPromoteDistance));
+
+	// drop promoted enemies that died. Their spawner was notified through the death delegate
+	for (int32 i = PromotedEnemies.Num() - 1; i >= 0; --i)
+	{
+		const ACombatEnemy* Enemy = PromotedEnemies[i].Enemy;
+
+		if (!IsValid(Enemy) || Enemy->IsInPool() || Enemy->CurrentHP <= 0.0f)
+		{
+			PromotedEnemies.RemoveAtSwap(i, EAllowShrinking::No);
+		}
+	}
+
+	// demote living enemies that left engagement range
+	for (int32 i = PromotedEnemies.Num() - 1; i >= 0; --i)
+	{
+		if (FVector::DistSquared2D(PromotedEnemies[i].Enemy->GetActorLocation(), PlayerLocation) > DemoteDistanceSquared)
+		{
+			DemoteEnemy(i);
+		}
+	}
+
+	int32 PromotionBudget = GCombatCrowdMaxPromotionsPerFrame;
+
+	// move the entities towards their slots around the player
+	for (int32 i = EntityLocations.Num() - 1; i >= 0; --i)
+	{
+		const FCombatCrowdArchetype& Archetype = Archetypes[EntityArchetypes[i]];
+
+		FVector& Location = EntityLocations[i];
+		const FVector ToPlayer = FVector(PlayerLocation.X - Location.X, PlayerLocation.Y - Location.Y, 0.0f);
+
+		// promote entities that entered engagement range, if we have room
+		if (ToPlayer.SizeSquared() < PromoteDistanceSquared && PromotionBudget > 0 && PromotedEnemies.Num() < GCombatCrowdMaxPromoted)
+		{
+			if (PromoteEntity(i))
+			{
+				--PromotionBudget;
+				continue;
+			}
+		}
+
+		// face the player
+		if (!ToPlayer.IsNearlyZero())
+		{
+			EntityYaws[i] = FMath::RadiansToDegrees(FMath::Atan2(ToPlayer.Y, ToPlayer.X));
+		}
+
+		// approach our own slot instead of the player, so entities waiting on the promotion cap don't pile up
+		const FVector ToSlot = ToPlayer + FVector(EntitySlotOffsets[i], 0.0f);
+		const float SlotDistance = ToSlot.Size();
+
+		if (SlotDistance > UE_KINDA_SMALL_NUMBER)
+		{
+			Location += (ToSlot / SlotDistance) * FMath::Min(Archetype.MoveSpeed * DeltaTime, SlotDistance);
+		}
+	}
+
+	UpdateProxies();
+
+	Stats.Entities = EntityLocations.Num();
+	Stats.Promoted = PromotedEnemies.Num();
+	Stats.SimulationTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool UCombatCrowdSubsystem::PromoteEntity(int32 EntityIndex)
+{
+	UCombatEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UCombatEnemyPoolSubsystem>();
+
+	if (!Pool)
+	{
+		return false;
+	}
+
+	const int32 ArchetypeIndex = EntityArchetypes[EntityIndex];
+	const FCombatCrowdArchetype& Archetype = Archetypes[ArchetypeIndex];
+
+	// nudge the spawn point out of anything the actor would overlap, such as the player or enemies promoted before us
+	const FRotator SpawnRotation(0.0f, EntityYaws[EntityIndex], 0.0f);
+	FVector SpawnLocation = EntityLocations[EntityIndex];
+
+	if (!GetWorld()->FindTeleportSpot(Archetype.EnemyClass->GetDefaultObject<ACombatEnemy>(), SpawnLocation, SpawnRotation))
+	{
+		// stay in the crowd and try again next frame
+		++Stats.BlockedPromotions;
+		return false;
+	}
+
+	// bring in a pooled enemy at the adjusted transform
+	ACombatEnemy* Enemy = Pool->AcquireEnemy(Archetype.EnemyClass, FTransform(SpawnRotation, SpawnLocation));
+
+	if (!Enemy)
+	{
+		return false;
+	}
+
+	// carry over the entity state
+	Enemy->SetHP(EntityHP[EntityIndex]);
+
+	// let the spawner track the enemy's death
+	if (ACombatEnemySpawner* Spawner = Archetype.Spawner.Get())
+	{
+		Spawner->AdoptEnemy(Enemy);
+	}
+
+	FCombatCrowdPromotedEnemy& Promoted = PromotedEnemies.AddDefaulted_GetRef();
+	Promoted.Enemy = Enemy;
+	Promoted.Archetype = ArchetypeIndex;
+
+	RemoveEntity(EntityIndex);
+
+	++Stats.TotalPromotions;
+
+	return true;
+}
+
+void UCombatCrowdSubsystem::DemoteEnemy(int32 PromotedIndex)
+{
+	const FCombatCrowdPromotedEnemy Promoted = PromotedEnemies[PromotedIndex];
+	PromotedEnemies.RemoveAtSwap(PromotedIndex, EAllowShrinking::No);
+
+	ACombatEnemy* Enemy = Promoted.Enemy;
+
+	// carry over the enemy state
+	EntityArchetypes.Add(Promoted.Archetype);
+	EntityLocations.Add(Enemy->GetActorLocation());
+	EntityYaws.Add(Enemy->GetActorRotation().Yaw);
+	EntityHP.Add(Enemy->CurrentHP);
+	EntitySlotOffsets.Add(MakeSlotOffset(Archetypes[Promoted.Archetype]));
+
+	// the entity will be promoted again as a new actor, so the spawner stops listening to this one.
+	// Otherwise its death in a later life, under another spawner or the wave director, would count against this spawner
+	if (ACombatEnemySpawner* Spawner = Archetypes[Promoted.Archetype].Spawner.Get())
+	{
+		Spawner->ReleaseEnemy(Enemy);
+	}
+
+	// park the actor
+	if (UCombatEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UCombatEnemyPoolSubsystem>())
+	{
+		Pool->ReleaseEnemy(Enemy);
+	}
+
+	++Stats.TotalDemotions;
+}
+
+FVector2D UCombatCrowdSubsystem::MakeSlotOffset(const FCombatCrowdArchetype& Archetype)
+{
+	// lay the slots out on a sunflower spiral outside the attack range, about a capsule apart
+	const int32 Slot = NextSlot;
+	NextSlot = (NextSlot + 1) % MaxCrowdSlots;
+
+	const float GoldenAngle = UE_PI * (3.0f - FMath::Sqrt(5.0f));
+	const float Angle = Slot * GoldenAngle;
+	const float Radius = Archetype.AttackRange + 2.0f * Archetype.CapsuleRadius * FMath::Sqrt(static_cast<float>(Slot));
+
+	return FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Radius;
+}
+
+void UCombatCrowdSubsystem::RemoveEntity(int32 EntityIndex)
+{
+	EntityArchetypes.RemoveAtSwap(EntityIndex, EAllowShrinking::No);
+	EntityLocations.RemoveAtSwap(EntityIndex, EAllowShrinking::No);
+	EntityYaws.RemoveAtSwap(EntityIndex, EAllowShrinking::No);
+	EntityHP.RemoveAtSwap(EntityIndex, EAllowShrinking::No);
+	EntitySlotOffsets.RemoveAtSwap(EntityIndex, EAllowShrinking::No);
+}
+
+void UCombatCrowdSubsystem::UpdateProxies()
+{
+	if (!ProxyOwner)
+	{
+		return;
+	}
+
+	// gather the proxy transforms for each archetype, keeping last frame's allocations
+	ProxyTransforms.SetNum(Archetypes.Num());
+
+	for (TArray<FTransform>& Transforms : ProxyTransforms)
+	{
+		Transforms.Reset();
+	}
+
+	for (int32 i = 0; i < EntityLocations.Num(); ++i)
+	{
+		const FCombatCrowdArchetype& Archetype = Archetypes[EntityArchetypes[i]];
+
+		if (Archetype.ProxyComponent)
+		{
+			// place the mesh on the ground under the capsule center
+			const FVector MeshLocation = EntityLocations[i] - FVector(0.0f, 0.0f, Archetype.CapsuleHalfHeight);
+			ProxyTransforms[EntityArchetypes[i]].Emplace(FRotator(0.0f, EntityYaws[i], 0.0f), MeshLocation);
+		}
+	}
+
+	// push them to the instanced meshes in one batch per archetype
+	for (int32 i = 0; i < Archetypes.Num(); ++i)
+	{
+		UInstancedStaticMeshComponent* ProxyComponent = Archetypes[i].ProxyComponent;
+
+		if (!ProxyComponent)
+		{
+			continue;
+		}
+
+		const TArray<FTransform>& Transforms = ProxyTransforms[i];
+
+		// all instances are identical, so we only need to match the instance count
+		while (ProxyComponent->GetInstanceCount() > Transforms.Num())
+		{
+			ProxyComponent->RemoveInstance(ProxyComponent->GetInstanceCount() - 1);
+		}
+
+		const int32 NumExisting = ProxyComponent->GetInstanceCount();
+
+		if (NumExisting > 0)
+		{
+			ProxyComponent->BatchUpdateInstancesTransforms(0, MakeArrayView(Transforms.GetData(), NumExisting), true, true);
+		}
+
+		if (Transforms.Num() > NumExisting)
+		{
+			NewProxyTransforms.Reset();
+			NewProxyTransforms.Append(Transforms.GetData() + NumExisting, Transforms.Num() - NumExisting);
+
+			ProxyComponent->AddInstances(NewProxyTransforms, false, true);
+		}
+	}
+}
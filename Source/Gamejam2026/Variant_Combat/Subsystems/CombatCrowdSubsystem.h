@@ -0,0 +1,202 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameWorldTickFunction.h"
+#include "CombatCrowdSubsystem.generated.h"
+
+class ACombatEnemy;
+class ACombatEnemySpawner;
+class UStaticMesh;
+class UInstancedStaticMeshComponent;
+
+/**
+ *  Shared settings for crowd entities created by the same spawner
+ */
+USTRUCT()
+struct FCombatCrowdArchetype
+{
+	GENERATED_BODY()
+
+	/** Enemy class to promote entities to */
+	UPROPERTY()
+	TSubclassOf<ACombatEnemy> EnemyClass;
+
+	/** Spawner that owns the entities. Notified when promoted enemies die */
+	UPROPERTY()
+	TWeakObjectPtr<ACombatEnemySpawner> Spawner;
+
+	/** Optional mesh used to render entities while they're in crowd mode */
+	UPROPERTY()
+	TObjectPtr<UStaticMesh> ProxyMesh;
+
+	/** Instanced mesh component rendering the proxies for this archetype */
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> ProxyComponent;
+
+	/** Starting HP for new entities */
+	float MaxHP = 1.0f;
+
+	/** Half height of the enemy's capsule, used to place proxies on the ground */
+	float CapsuleHalfHeight = 90.0f;
+
+	/** Radius of the enemy's capsule, used to space out the entities around the player */
+	float CapsuleRadius = 35.0f;
+
+	/** Movement speed while in crowd mode */
+	float MoveSpeed = 300.0f;
+
+	/** Distance to the player of the innermost ring entities gather on while they wait to be promoted */
+	float AttackRange = 150.0f;
+};
+
+/**
+ *  Running statistics for the crowd
+ */
+USTRUCT(BlueprintType)
+struct FCombatCrowdStats
+{
+	GENERATED_BODY()
+
+	/** Number of enemies living as crowd entities */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Crowd")
+	int32 Entities = 0;
+
+	/** Number of enemies promoted to full actors */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Crowd")
+	int32 Promoted = 0;
+
+	/** Total number of promotions */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Crowd")
+	int32 TotalPromotions = 0;
+
+	/** Total number of demotions */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Crowd")
+	int32 TotalDemotions = 0;
+
+	/** Number of promotions put off because there was no free spot to place the actor */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Crowd")
+	int32 BlockedPromotions = 0;
+
+	/** Time spent simulating crowd entities last frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Crowd", meta = (Units = "ms"))
+	float SimulationTimeMs = 0.0f;
+};
+
+/**
+ *  A crowd enemy that has been promoted to a full actor
+ */
+USTRUCT()
+struct FCombatCrowdPromotedEnemy
+{
+	GENERATED_BODY()
+
+	/** Promoted actor */
+	UPROPERTY()
+	TObjectPtr<ACombatEnemy> Enemy;
+
+	/** Archetype to demote back into */
+	int32 Archetype = INDEX_NONE;
+};
+
+/**
+ *  Lightweight crowd representation for large enemy counts.
+ *  Distant enemies live as structure-of-arrays entities with simple movement, and are promoted to pooled
+ *  ACombatEnemy actors when they enter engagement range of the player. Entities can't attack or be hit,
+ *  so the ones left over by the promotion cap gather in spaced out slots around the player and wait their turn.
+ *  Promoted enemies that leave engagement range are demoted back, keeping their HP.
+ */
+UCLASS()
+class UCombatCrowdSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Shared settings for each spawner feeding the crowd */
+	UPROPERTY()
+	TArray<FCombatCrowdArchetype> Archetypes;
+
+	/** Entity archetype indices */
+	TArray<int32> EntityArchetypes;
+
+	/** Entity locations */
+	TArray<FVector> EntityLocations;
+
+	/** Entity facing yaw */
+	TArray<float> EntityYaws;
+
+	/** Entity HP */
+	TArray<float> EntityHP;
+
+	/** Offset from the player each entity gathers at, so they spread out instead of stacking on one point */
+	TArray<FVector2D> EntitySlotOffsets;
+
+	/** Slot handed out to the next entity */
+	int32 NextSlot = 0;
+
+	/** Enemies currently promoted to full actors */
+	UPROPERTY()
+	TArray<FCombatCrowdPromotedEnemy> PromotedEnemies;
+
+	/** Transient actor that owns the proxy instanced mesh components */
+	UPROPERTY()
+	TObjectPtr<AActor> ProxyOwner;
+
+	/** Tick function that simulates the crowd */
+	FGameWorldTickFunction SimulateTickFunction;
+
+	/** Crowd statistics */
+	FCombatCrowdStats Stats;
+
+	/** Proxy transforms for each archetype, reused every frame */
+	TArray<TArray<FTransform>> ProxyTransforms;
+
+	/** Proxy transforms for instances being added, reused every frame */
+	TArray<FTransform> NewProxyTransforms;
+
+public:
+
+	/** Adds a crowd entity owned by the given spawner. Returns false if the spawner can't feed the crowd */
+	bool AddEntity(ACombatEnemySpawner* Spawner, TSubclassOf<ACombatEnemy> EnemyClass, const FVector& Location, float Yaw);
+
+	/** Returns the current crowd statistics */
+	const FCombatCrowdStats& GetStats() const { return Stats; }
+
+	/** Writes the crowd statistics to the log */
+	void DumpStats() const;
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the simulation tick function */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Finds or creates the archetype for a spawner */
+	int32 FindOrAddArchetype(ACombatEnemySpawner* Spawner, TSubclassOf<ACombatEnemy> EnemyClass);
+
+	/** Moves entities toward their slots around the player and handles promotion and demotion */
+	void Simulate(float DeltaTime);
+
+	/** Replaces an entity with a pooled enemy actor, carrying over its HP and transform */
+	bool PromoteEntity(int32 EntityIndex);
+
+	/** Replaces a promoted enemy with a crowd entity, carrying over its HP and transform */
+	void DemoteEnemy(int32 PromotedIndex);
+
+	/** Returns the offset from the player for the next entity's slot */
+	FVector2D MakeSlotOffset(const FCombatCrowdArchetype& Archetype);
+
+	/** Removes an entity, keeping the arrays packed */
+	void RemoveEntity(int32 EntityIndex);
+
+	/** Pushes the entity transforms to the proxy instanced meshes */
+	void UpdateProxies();
+};
@@ -0,0 +1,280 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatDamageSubsystem.h"
+#include "CombatStats.h"
+#include "CombatAttacker.h"
+#include "CombatDamageable.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Gamejam2026.h"
+
+static bool GCombatDamageBatched = true;
+static FAutoConsoleVariableRef CVarCombatDamageBatched(
+	TEXT("Combat.Damage.Batched"),
+	GCombatDamageBatched,
+	TEXT("If true, damage is queued and resolved in one batch after physics. If false, it's applied as soon as it's sent"),
+	ECVF_Default
+);
+
+static int32 GCombatDamageCapacity = 512;
+static FAutoConsoleVariableRef CVarCombatDamageCapacity(
+	TEXT("Combat.Damage.Capacity"),
+	GCombatDamageCapacity,
+	TEXT("Number of damage records the queue can hold before it has to resolve early. Read when the world starts"),
+	ECVF_Default
+);
+
+static float GCombatDamageRateWindow = 1.0f;
+static FAutoConsoleVariableRef CVarCombatDamageRateWindow(
+	TEXT("Combat.Damage.RateWindow"),
+	GCombatDamageRateWindow,
+	TEXT("Time window used to compute damage per second, in seconds"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithWorld CombatDamageStatsCommand(
+	TEXT("Combat.Damage.Stats"),
+	TEXT("Logs damage per second, hits per frame and damage totals for the damage pipeline"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UCombatDamageSubsystem* Damage = World ? World->GetSubsystem<UCombatDamageSubsystem>() : nullptr)
+		{
+			Damage->DumpStats();
+		}
+	})
+);
+
+void UCombatDamageSubsystem::QueueDamage(AActor* Source, AActor* Target, float Amount, ECombatDamageType Type, const FVector& Point, const FVector& Impulse)
+{
+	if (!Target || Records.IsEmpty())
+	{
+		return;
+	}
+
+	// resolve what we have to make room
+	if (NumQueued == Records.Num())
+	{
+		++Stats.Overflows;
+		ResolveQueued();
+	}
+
+	FCombatDamageRecord& Record = Records[(Head + NumQueued) % Records.Num()];
+	Record.Source = Source;
+	Record.Target = Target;
+	Record.Amount = Amount;
+	Record.Type = Type;
+	Record.Point = FVector3f(Point);
+	Record.Impulse = FVector3f(Impulse);
+
+	++NumQueued;
+}
+
+void UCombatDamageSubsystem::SendDamage(AActor* Source, AActor* Target, float Amount, ECombatDamageType Type, const FVector& Point, const FVector& Impulse)
+{
+	ICombatDamageable* Damageable = Cast<ICombatDamageable>(Target);
+
+	if (!Damageable)
+	{
+		return;
+	}
+
+	COMBAT_INC_COUNTER(DamageEventsPerFrame, 1);
+
+	UCombatDamageSubsystem* Damage = GCombatDamageBatched && Target->GetWorld() ? Target->GetWorld()->GetSubsystem<UCombatDamageSubsystem>() : nullptr;
+
+	if (Damage)
+	{
+		Damage->QueueDamage(Source, Target, Amount, Type, Point, Impulse);
+		return;
+	}
+
+	// no pipeline, so apply the damage right away
+	Damageable->ApplyDamage(Amount, Source, Point, Impulse);
+
+	if (ICombatAttacker* Attacker = Cast<ICombatAttacker>(Source))
+	{
+		Attacker->NotifyDamageDealt(Target, Amount, Point);
+	}
+}
+
+void UCombatDamageSubsystem::RegisterDamageProfile(const AActor* Actor, const FCombatDamageProfile& Profile)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	FCombatDamageActorState& State = ActorStates.FindOrAdd(Actor);
+	State.OutgoingScale = Profile.OutgoingDamageScale;
+	State.Resistances[static_cast<int32>(ECombatDamageType::Melee)] = FMath::Clamp(Profile.MeleeResistance, 0.0f, 1.0f);
+	State.Resistances[static_cast<int32>(ECombatDamageType::Environment)] = FMath::Clamp(Profile.EnvironmentResistance, 0.0f, 1.0f);
+	State.InvulnerabilityTime = Profile.InvulnerabilityTime;
+}
+
+void UCombatDamageSubsystem::UnregisterDamageProfile(const AActor* Actor)
+{
+	ActorStates.Remove(Actor);
+}
+
+void UCombatDamageSubsystem::DumpStats() const
+{
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat damage: %.1f damage per second, %d hits last frame, %d peak hits per frame"),
+		Stats.DamagePerSecond, Stats.HitsLastFrame, Stats.PeakHitsPerFrame);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat damage: %d hits, %.1f damage (melee %.1f, environment %.1f)"),
+		Stats.TotalHits, Stats.TotalDamage,
+		Stats.DamageByType[static_cast<int32>(ECombatDamageType::Melee)],
+		Stats.DamageByType[static_cast<int32>(ECombatDamageType::Environment)]);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat damage: %d blocked by invulnerability, %d overflows, %d profiles, %.3f ms last resolve"),
+		Stats.BlockedByInvulnerability, Stats.Overflows, ActorStates.Num(), Stats.ResolveTimeMs);
+}
+
+void UCombatDamageSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// allocate the queue once, up front
+	Records.SetNum(FMath::Max(GCombatDamageCapacity, 1));
+}
+
+bool UCombatDamageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatDamageSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// resolve after physics, once this frame's attack traces and hits have been processed
+	ResolveTickFunction.OnTick.BindUObject(this, &UCombatDamageSubsystem::ResolveFrame);
+	ResolveTickFunction.Register(&InWorld, TG_PostPhysics, false, TEXT("CombatDamage"));
+}
+
+void UCombatDamageSubsystem::Deinitialize()
+{
+	ResolveTickFunction.Unregister();
+
+	Records.Empty();
+	ActorStates.Empty();
+	Head = NumQueued = 0;
+
+	Super::Deinitialize();
+}
+
+void UCombatDamageSubsystem::ResolveFrame(float DeltaTime)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// start a new history frame. Hits from early resolves this frame were counted into the previous one
+	HistoryHead = (HistoryHead + 1) % CombatDamageHistoryFrames;
+
+	FCombatDamageFrame& Frame = History[HistoryHead];
+	Frame.Time = GetWorld()->GetTimeSeconds();
+	Frame.Damage = 0.0f;
+	Frame.Hits = 0;
+
+	ResolveQueued();
+
+	// sum the damage inside the rate window
+	const double WindowStart = Frame.Time - GCombatDamageRateWindow;
+	double OldestTime = Frame.Time;
+	float WindowDamage = 0.0f;
+
+	for (int32 i = 0; i < CombatDamageHistoryFrames; ++i)
+	{
+		const FCombatDamageFrame& Sample = History[(HistoryHead - i + CombatDamageHistoryFrames) % CombatDamageHistoryFrames];
+
+		if (Sample.Time <= WindowStart || Sample.Time > Frame.Time)
+		{
+			break;
+		}
+
+		WindowDamage += Sample.Damage;
+		OldestTime = Sample.Time;
+	}
+
+	// use the window length, unless the history doesn't cover it
+	const double WindowLength = FMath::Max(FMath::Min<double>(GCombatDamageRateWindow, Frame.Time - OldestTime + DeltaTime), UE_KINDA_SMALL_NUMBER);
+
+	Stats.DamagePerSecond = WindowDamage / WindowLength;
+	Stats.HitsLastFrame = Frame.Hits;
+	Stats.PeakHitsPerFrame = FMath::Max(Stats.PeakHitsPerFrame, Frame.Hits);
+	Stats.ResolveTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+}
+
+void UCombatDamageSubsystem::ResolveQueued()
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(DamageResolve);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	FCombatDamageFrame& Frame = History[HistoryHead];
+
+	while (NumQueued > 0)
+	{
+		// copy the record out, so new damage queued by the handlers doesn't overwrite it
+		const FCombatDamageRecord Record = Records[Head];
+		Records[Head] = FCombatDamageRecord();
+
+		Head = (Head + 1) % Records.Num();
+		--NumQueued;
+
+		AActor* Target = Record.Target.Get();
+		ICombatDamageable* Damageable = Cast<ICombatDamageable>(Target);
+
+		if (!Damageable)
+		{
+			continue;
+		}
+
+		AActor* Source = Record.Source.Get();
+		const int32 TypeIndex = static_cast<int32>(Record.Type);
+
+		float Amount = Record.Amount;
+
+		// apply the source's outgoing modifier
+		if (const FCombatDamageActorState* SourceState = Source ? ActorStates.Find(Source) : nullptr)
+		{
+			Amount *= SourceState->OutgoingScale;
+		}
+
+		// apply the target's resistance and invulnerability window
+		if (FCombatDamageActorState* TargetState = ActorStates.Find(Target))
+		{
+			if (Now < TargetState->InvulnerableUntil)
+			{
+				++Stats.BlockedByInvulnerability;
+				continue;
+			}
+
+			Amount *= 1.0f - TargetState->Resistances[TypeIndex];
+
+			if (TargetState->InvulnerabilityTime > 0.0f)
+			{
+				TargetState->InvulnerableUntil = Now + TargetState->InvulnerabilityTime;
+			}
+		}
+
+		const FVector Point(Record.Point);
+
+		Damageable->ApplyDamage(Amount, Source, Point, FVector(Record.Impulse));
+
+		if (ICombatAttacker* Attacker = Cast<ICombatAttacker>(Source))
+		{
+			Attacker->NotifyDamageDealt(Target, Amount, Point);
+		}
+
+		++Frame.Hits;
+		Frame.Damage += Amount;
+
+		++Stats.TotalHits;
+		Stats.TotalDamage += Amount;
+		Stats.DamageByType[TypeIndex] += Amount;
+	}
+
+	Head = 0;
+}
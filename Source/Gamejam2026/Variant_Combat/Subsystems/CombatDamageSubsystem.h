@@ -0,0 +1,193 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CombatDamageTypes.h"
+#include "GameWorldTickFunction.h"
+#include "CombatDamageSubsystem.generated.h"
+
+/** Number of frames of damage history kept for telemetry */
+static constexpr int32 CombatDamageHistoryFrames = 128;
+
+/**
+ *  A queued damage event
+ */
+struct FCombatDamageRecord
+{
+	/** Actor dealing the damage */
+	TWeakObjectPtr<AActor> Source;
+
+	/** Actor receiving the damage */
+	TWeakObjectPtr<AActor> Target;
+
+	/** Damage before modifiers and resistances */
+	float Amount = 0.0f;
+
+	/** Kind of damage */
+	ECombatDamageType Type = ECombatDamageType::Melee;
+
+	/** World location of the hit */
+	FVector3f Point = FVector3f::ZeroVector;
+
+	/** Knockback impulse */
+	FVector3f Impulse = FVector3f::ZeroVector;
+};
+
+/**
+ *  Damage profile data resolved for the pipeline
+ */
+struct FCombatDamageActorState
+{
+	/** Multiplier applied to damage dealt */
+	float OutgoingScale = 1.0f;
+
+	/** Fraction of damage ignored, per damage type */
+	float Resistances[static_cast<int32>(ECombatDamageType::Count)] = {};
+
+	/** Time after taking damage during which further damage is ignored */
+	float InvulnerabilityTime = 0.0f;
+
+	/** Game time invulnerability ends */
+	double InvulnerableUntil = 0.0;
+};
+
+/**
+ *  Damage totals for a single frame
+ */
+struct FCombatDamageFrame
+{
+	/** Game time of the frame */
+	double Time = 0.0;
+
+	/** Damage dealt during the frame */
+	float Damage = 0.0f;
+
+	/** Hits landed during the frame */
+	int32 Hits = 0;
+};
+
+/**
+ *  Running telemetry for the damage pipeline
+ */
+USTRUCT(BlueprintType)
+struct FCombatDamageStats
+{
+	GENERATED_BODY()
+
+	/** Damage dealt over the last second */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Damage")
+	float DamagePerSecond = 0.0f;
+
+	/** Hits landed during the last resolve */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Damage")
+	int32 HitsLastFrame = 0;
+
+	/** Most hits landed in a single frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Damage")
+	int32 PeakHitsPerFrame = 0;
+
+	/** Total hits landed */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Damage")
+	int32 TotalHits = 0;
+
+	/** Total damage dealt */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Damage")
+	float TotalDamage = 0.0f;
+
+	/** Total records dropped because the target was invulnerable */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Damage")
+	int32 BlockedByInvulnerability = 0;
+
+	/** Total number of times the queue filled up and had to resolve early */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Damage")
+	int32 Overflows = 0;
+
+	/** Time spent in the last resolve */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Damage", meta = (Units = "ms"))
+	float ResolveTimeMs = 0.0f;
+
+	/** Total damage dealt, per damage type */
+	float DamageByType[static_cast<int32>(ECombatDamageType::Count)] = {};
+};
+
+/**
+ *  Batches combat damage.
+ *  Damage sources queue compact damage records into a fixed size ring buffer. Once per frame, after physics,
+ *  the records are resolved in one batch: the source's outgoing modifier and the target's resistances are applied,
+ *  targets still inside their invulnerability window are skipped, and the final damage is passed to the
+ *  target's ICombatDamageable::ApplyDamage. Telemetry is kept in fixed size buffers, so hits never allocate.
+ */
+UCLASS()
+class UCombatDamageSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Queued damage records. Fixed size, used as a ring buffer */
+	TArray<FCombatDamageRecord> Records;
+
+	/** Index of the oldest queued record */
+	int32 Head = 0;
+
+	/** Number of queued records */
+	int32 NumQueued = 0;
+
+	/** Damage profiles for registered actors */
+	TMap<TObjectKey<AActor>, FCombatDamageActorState> ActorStates;
+
+	/** Per-frame damage history, used as a ring buffer */
+	FCombatDamageFrame History[CombatDamageHistoryFrames];
+
+	/** Index of the most recent history frame */
+	int32 HistoryHead = 0;
+
+	/** Tick function that resolves the queue */
+	FGameWorldTickFunction ResolveTickFunction;
+
+	/** Telemetry */
+	FCombatDamageStats Stats;
+
+public:
+
+	/** Queues damage from a source to a target */
+	void QueueDamage(AActor* Source, AActor* Target, float Amount, ECombatDamageType Type, const FVector& Point, const FVector& Impulse);
+
+	/** Queues damage through the target world's pipeline, or applies it right away if there's no pipeline */
+	static void SendDamage(AActor* Source, AActor* Target, float Amount, ECombatDamageType Type, const FVector& Point, const FVector& Impulse);
+
+	/** Sets the modifiers, resistances and invulnerability used for an actor */
+	void RegisterDamageProfile(const AActor* Actor, const FCombatDamageProfile& Profile);
+
+	/** Removes an actor's damage profile */
+	void UnregisterDamageProfile(const AActor* Actor);
+
+	/** Returns the telemetry */
+	const FCombatDamageStats& GetStats() const { return Stats; }
+
+	/** Writes the telemetry to the log */
+	void DumpStats() const;
+
+protected:
+
+	/** Sizes the ring buffer */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the resolve tick function */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Resolves every queued record, then updates the telemetry */
+	void ResolveFrame(float DeltaTime);
+
+	/** Resolves every queued record */
+	void ResolveQueued();
+};
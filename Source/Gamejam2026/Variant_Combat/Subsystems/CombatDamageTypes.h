@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatDamageTypes.generated.h"
+
+/**
+ *  Kind of damage carried by a damage record. Resistances are set per type
+ */
+UENUM(BlueprintType)
+enum class ECombatDamageType : uint8
+{
+	Melee,
+	Environment,
+	Count UMETA(Hidden)
+};
+
+/**
+ *  How an actor deals and receives damage through the damage pipeline
+ */
+USTRUCT(BlueprintType)
+struct FCombatDamageProfile
+{
+	GENERATED_BODY()
+
+	/** Multiplier applied to all damage this actor deals */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Damage", meta = (ClampMin = 0))
+	float OutgoingDamageScale = 1.0f;
+
+	/** Fraction of melee damage ignored */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Damage", meta = (ClampMin = 0, ClampMax = 1))
+	float MeleeResistance = 0.0f;
+
+	/** Fraction of environment damage ignored */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Damage", meta = (ClampMin = 0, ClampMax = 1))
+	float EnvironmentResistance = 0.0f;
+
+	/** Time after taking damage during which further damage is ignored */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Damage", meta = (ClampMin = 0, Units = "s"))
+	float InvulnerabilityTime = 0.0f;
+};
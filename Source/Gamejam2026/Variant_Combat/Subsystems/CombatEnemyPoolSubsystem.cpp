@@ -0,0 +1,165 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatEnemyPoolSubsystem.h"
+#include "CombatEnemy.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Gamejam2026.h"
+
+static FAutoConsoleCommandWithWorld CombatPoolStatsCommand(
+	TEXT("Combat.Pool.Stats"),
+	TEXT("Logs the combat enemy pool hit rate and worst-case spawn costs"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UCombatEnemyPoolSubsystem* Pool = World ? World->GetSubsystem<UCombatEnemyPoolSubsystem>() : nullptr)
+		{
+			Pool->DumpStats();
+		}
+	})
+);
+
+void UCombatEnemyPoolSubsystem::Prewarm(TSubclassOf<ACombatEnemy> EnemyClass, int32 Count, const FTransform& ParkingTransform)
+{
+	// ensure the enemy class is valid
+	if (!IsValid(EnemyClass))
+	{
+		return;
+	}
+
+	FCombatEnemyPoolBucket& Bucket = Buckets.FindOrAdd(EnemyClass);
+
+	// spawn and park the requested amount of enemies
+	for (int32 i = 0; i < Count; ++i)
+	{
+		ACombatEnemy* Enemy = SpawnPooledEnemy(EnemyClass, ParkingTransform);
+
+		if (!Enemy)
+		{
+			break;
+		}
+
+		// park the enemy right away
+		Enemy->DeactivateForPool();
+		Bucket.FreeEnemies.Add(Enemy);
+
+		++Stats.Prewarmed;
+		++Stats.Free;
+	}
+}
+
+ACombatEnemy* UCombatEnemyPoolSubsystem::AcquireEnemy(TSubclassOf<ACombatEnemy> EnemyClass, const FTransform& SpawnTransform)
+{
+	// ensure the enemy class is valid
+	if (!IsValid(EnemyClass))
+	{
+		return nullptr;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// try to reuse a parked enemy first
+	if (FCombatEnemyPoolBucket* Bucket = Buckets.Find(EnemyClass))
+	{
+		while (Bucket->FreeEnemies.Num() > 0)
+		{
+			ACombatEnemy* Enemy = Bucket->FreeEnemies.Pop(EAllowShrinking::No);
+			--Stats.Free;
+
+			// skip any enemies that were destroyed while parked
+			if (!IsValid(Enemy))
+			{
+				continue;
+			}
+
+			// bring the enemy back at the requested transform
+			Enemy->ActivateFromPool(SpawnTransform);
+
+			++Stats.Hits;
+			++Stats.Active;
+
+			const float ElapsedMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+			Stats.WorstReuseTimeMs = FMath::Max(Stats.WorstReuseTimeMs, ElapsedMs);
+
+			return Enemy;
+		}
+	}
+
+	// nothing to reuse, so spawn a new enemy
+	ACombatEnemy* Enemy = SpawnPooledEnemy(EnemyClass, SpawnTransform);
+
+	if (Enemy)
+	{
+		++Stats.Misses;
+		++Stats.Active;
+
+		const float ElapsedMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		Stats.WorstSpawnTimeMs = FMath::Max(Stats.WorstSpawnTimeMs, ElapsedMs);
+	}
+
+	return Enemy;
+}
+
+void UCombatEnemyPoolSubsystem::ReleaseEnemy(ACombatEnemy* Enemy)
+{
+	// ensure the enemy is valid and not already parked
+	if (!IsValid(Enemy) || Enemy->IsInPool())
+	{
+		return;
+	}
+
+	// deactivate the enemy
+	Enemy->DeactivateForPool();
+
+	// add it to the free list for its class
+	Buckets.FindOrAdd(Enemy->GetClass()).FreeEnemies.Add(Enemy);
+
+	--Stats.Active;
+	++Stats.Free;
+}
+
+int32 UCombatEnemyPoolSubsystem::GetNumFree(TSubclassOf<ACombatEnemy> EnemyClass) const
+{
+	const FCombatEnemyPoolBucket* Bucket = Buckets.Find(EnemyClass);
+	return Bucket ? Bucket->FreeEnemies.Num() : 0;
+}
+
+void UCombatEnemyPoolSubsystem::DumpStats() const
+{
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat enemy pool: %d hits, %d misses (%.1f%% hit rate), %d prewarmed, %d active, %d free"),
+		Stats.Hits, Stats.Misses, Stats.GetHitRate() * 100.0f, Stats.Prewarmed, Stats.Active, Stats.Free);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat enemy pool: worst reuse %.3f ms, worst spawn %.3f ms"),
+		Stats.WorstReuseTimeMs, Stats.WorstSpawnTimeMs);
+}
+
+bool UCombatEnemyPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatEnemyPoolSubsystem::Deinitialize()
+{
+	// the world is tearing down and will destroy the parked actors itself
+	Buckets.Empty();
+
+	Super::Deinitialize();
+}
+
+ACombatEnemy* UCombatEnemyPoolSubsystem::SpawnPooledEnemy(TSubclassOf<ACombatEnemy> EnemyClass, const FTransform& SpawnTransform)
+{
+	// always spawn, adjusting the location if the spawn point is blocked
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	ACombatEnemy* Enemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnTransform, SpawnParams);
+
+	if (Enemy)
+	{
+		// flag the enemy so it returns here instead of being destroyed
+		Enemy->SetPooled(true);
+	}
+
+	return Enemy;
+}
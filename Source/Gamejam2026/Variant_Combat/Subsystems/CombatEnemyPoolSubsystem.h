@@ -0,0 +1,117 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatEnemyPoolSubsystem.generated.h"
+
+class ACombatEnemy;
+
+/**
+ *  Running statistics for the combat enemy pool
+ */
+USTRUCT(BlueprintType)
+struct FCombatEnemyPoolStats
+{
+	GENERATED_BODY()
+
+	/** Number of acquire requests served from a free list */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pool")
+	int32 Hits = 0;
+
+	/** Number of acquire requests that had to spawn a new enemy */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pool")
+	int32 Misses = 0;
+
+	/** Number of enemies spawned ahead of time to pre-warm the pool */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pool")
+	int32 Prewarmed = 0;
+
+	/** Number of enemies currently checked out of the pool */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pool")
+	int32 Active = 0;
+
+	/** Number of deactivated enemies waiting in the pool */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pool")
+	int32 Free = 0;
+
+	/** Worst-case time spent reactivating a pooled enemy */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pool", meta = (Units = "ms"))
+	float WorstReuseTimeMs = 0.0f;
+
+	/** Worst-case time spent spawning a brand new enemy */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pool", meta = (Units = "ms"))
+	float WorstSpawnTimeMs = 0.0f;
+
+	/** Returns the ratio of acquire requests that were served without spawning */
+	float GetHitRate() const
+	{
+		const int32 Requests = Hits + Misses;
+		return Requests > 0 ? static_cast<float>(Hits) / static_cast<float>(Requests) : 0.0f;
+	}
+};
+
+/**
+ *  Free list of deactivated enemies of a single class
+ */
+USTRUCT()
+struct FCombatEnemyPoolBucket
+{
+	GENERATED_BODY()
+
+	/** Enemies ready to be reused */
+	UPROPERTY()
+	TArray<TObjectPtr<ACombatEnemy>> FreeEnemies;
+};
+
+/**
+ *  Per-world pool of combat enemies.
+ *  Dead enemies are deactivated and parked instead of destroyed,
+ *  and reused by spawners to avoid actor construction hitches at wave boundaries.
+ */
+UCLASS()
+class UCombatEnemyPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Free lists, one per enemy class */
+	UPROPERTY()
+	TMap<TSubclassOf<ACombatEnemy>, FCombatEnemyPoolBucket> Buckets;
+
+	/** Pool statistics */
+	FCombatEnemyPoolStats Stats;
+
+public:
+
+	/** Spawns the given amount of enemies and parks them in the free list for their class */
+	void Prewarm(TSubclassOf<ACombatEnemy> EnemyClass, int32 Count, const FTransform& ParkingTransform);
+
+	/** Returns an active enemy at the given transform, reusing a pooled one if possible */
+	ACombatEnemy* AcquireEnemy(TSubclassOf<ACombatEnemy> EnemyClass, const FTransform& SpawnTransform);
+
+	/** Deactivates the enemy and returns it to the free list for its class */
+	void ReleaseEnemy(ACombatEnemy* Enemy);
+
+	/** Returns the current pool statistics */
+	const FCombatEnemyPoolStats& GetStats() const { return Stats; }
+
+	/** Returns the number of free enemies of the given class */
+	int32 GetNumFree(TSubclassOf<ACombatEnemy> EnemyClass) const;
+
+	/** Writes the pool statistics to the log */
+	void DumpStats() const;
+
+protected:
+
+	/** Only create the pool for game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Spawns a new pool-owned enemy */
+	ACombatEnemy* SpawnPooledEnemy(TSubclassOf<ACombatEnemy> EnemyClass, const FTransform& SpawnTransform);
+};
@@ -0,0 +1,315 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatLifeBarSubsystem.h"
+#include "CombatStats.h"
+#include "CombatLifeBar.h"
+#include "CombatLifeBarLayer.h"
+#include "Components/WidgetComponent.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Gamejam2026.h"
+
+static bool GCombatLifeBarsBatched = true;
+static FAutoConsoleVariableRef CVarCombatLifeBarsBatched(
+	TEXT("Combat.LifeBars.Batched"),
+	GCombatLifeBarsBatched,
+	TEXT("If true, enemy life bars registered from now on are drawn by one shared HUD layer instead of their own widget components"),
+	ECVF_Default
+);
+
+static bool GCombatLifeBarsManualRedraw = true;
+static FAutoConsoleVariableRef CVarCombatLifeBarsManualRedraw(
+	TEXT("Combat.LifeBars.ManualRedraw"),
+	GCombatLifeBarsManualRedraw,
+	TEXT("If true, life bar widget components that aren't batched only redraw when their percentage changes"),
+	ECVF_Default
+);
+
+static float GCombatLifeBarsCullDistance = 5000.0f;
+static FAutoConsoleVariableRef CVarCombatLifeBarsCullDistance(
+	TEXT("Combat.LifeBars.CullDistance"),
+	GCombatLifeBarsCullDistance,
+	TEXT("Batched life bars further than this from the camera are not drawn, in cm"),
+	ECVF_Default
+);
+
+static float GCombatLifeBarsFullScaleDistance = 1000.0f;
+static FAutoConsoleVariableRef CVarCombatLifeBarsFullScaleDistance(
+	TEXT("Combat.LifeBars.FullScaleDistance"),
+	GCombatLifeBarsFullScaleDistance,
+	TEXT("Batched life bars closer than this to the camera are drawn at full size, and shrink further away, in cm"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithWorld CombatLifeBarsStatsCommand(
+	TEXT("Combat.LifeBars.Stats"),
+	TEXT("Logs the number of tracked, drawn and culled life bars and how many updates were coalesced"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UCombatLifeBarSubsystem* LifeBars = World ? World->GetSubsystem<UCombatLifeBarSubsystem>() : nullptr)
+		{
+			LifeBars->DumpStats();
+		}
+	})
+);
+
+void UCombatLifeBarSubsystem::RegisterLifeBar(UWidgetComponent* Anchor, UCombatLifeBar* Widget, bool bAllowBatching)
+{
+	if (!Anchor || !Widget || EntryLookup.Contains(Anchor))
+	{
+		return;
+	}
+
+	const int32 EntryIndex = Entries.AddDefaulted();
+	EntryLookup.Add(Anchor, EntryIndex);
+
+	FCombatLifeBarEntry& Entry = Entries[EntryIndex];
+	Entry.Anchor = Anchor;
+	Entry.Widget = Widget;
+	Entry.bBatched = bAllowBatching && GCombatLifeBarsBatched;
+
+	if (Entry.bBatched)
+	{
+		// the shared layer draws this bar, so stop the component from rendering or ticking its widget.
+		// Its hidden in game flag still controls whether the bar is shown
+		Anchor->SetVisibility(false);
+		Anchor->SetComponentTickEnabled(false);
+	}
+	else
+	{
+		// start in sync with the tracked percentage
+		Widget->SetLifePercentage(Entry.Percent);
+
+		// only redraw the widget when the percentage changes
+		if (GCombatLifeBarsManualRedraw)
+		{
+			Anchor->SetManuallyRedraw(true);
+			Anchor->RequestRedraw();
+		}
+	}
+}
+
+void UCombatLifeBarSubsystem::UnregisterLifeBar(UWidgetComponent* Anchor)
+{
+	int32 EntryIndex = INDEX_NONE;
+
+	if (!EntryLookup.RemoveAndCopyValue(Anchor, EntryIndex))
+	{
+		return;
+	}
+
+	// swap the last entry into the hole
+	Entries.RemoveAtSwap(EntryIndex, EAllowShrinking::No);
+
+	if (Entries.IsValidIndex(EntryIndex))
+	{
+		EntryLookup.Add(Entries[EntryIndex].Anchor, EntryIndex);
+	}
+}
+
+bool UCombatLifeBarSubsystem::SetLifePercentage(UWidgetComponent* Anchor, float Percent)
+{
+	const int32* EntryIndex = EntryLookup.Find(Anchor);
+
+	if (!EntryIndex)
+	{
+		return false;
+	}
+
+	// only remember the latest value. It gets pushed to the bar once, at the end of the frame
+	FCombatLifeBarEntry& Entry = Entries[*EntryIndex];
+	Entry.PendingPercent = FMath::Clamp(Percent, 0.0f, 1.0f);
+	Entry.bDirty = true;
+
+	++Stats.UpdatesRequested;
+
+	return true;
+}
+
+void UCombatLifeBarSubsystem::UpdateLifeBar(UWidgetComponent* Anchor, UCombatLifeBar* Widget, float Percent)
+{
+	UCombatLifeBarSubsystem* LifeBars = Anchor && Anchor->GetWorld() ? Anchor->GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>() : nullptr;
+
+	if (!LifeBars || !LifeBars->SetLifePercentage(Anchor, Percent))
+	{
+		Widget->SetLifePercentage(Percent);
+	}
+}
+
+void UCombatLifeBarSubsystem::DumpStats() const
+{
+	int32 NumBatched = 0;
+
+	for (const FCombatLifeBarEntry& Entry : Entries)
+	{
+		NumBatched += Entry.bBatched ? 1 : 0;
+	}
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat life bars: %d tracked (%d batched), %d drawn, %d culled last frame"),
+		Stats.LifeBars, NumBatched, Stats.Drawn, Stats.Culled);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat life bars: %d updates requested, %d applied"),
+		Stats.UpdatesRequested, Stats.UpdatesApplied);
+}
+
+bool UCombatLifeBarSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatLifeBarSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// flush after the camera has updated, so the draw list matches the rendered view
+	FlushTickFunction.OnTick.BindUObject(this, &UCombatLifeBarSubsystem::Flush);
+	FlushTickFunction.Register(&InWorld, TG_PostUpdateWork, false, TEXT("CombatLifeBars"));
+}
+
+void UCombatLifeBarSubsystem::Deinitialize()
+{
+	FlushTickFunction.Unregister();
+
+	if (Layer)
+	{
+		Layer->RemoveFromParent();
+		Layer = nullptr;
+	}
+
+	Entries.Empty();
+	EntryLookup.Empty();
+	DrawItems.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatLifeBarSubsystem::Flush(float DeltaTime)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(LifeBars);
+
+	DrawItems.Reset();
+
+	Stats.LifeBars = Entries.Num();
+	Stats.Drawn = 0;
+	Stats.Culled = 0;
+
+	bool bHasBatchedBars = false;
+
+	// push the coalesced percentages
+	for (FCombatLifeBarEntry& Entry : Entries)
+	{
+		bHasBatchedBars |= Entry.bBatched;
+
+		if (!Entry.bDirty)
+		{
+			continue;
+		}
+
+		Entry.bDirty = false;
+
+		if (Entry.PendingPercent == Entry.Percent)
+		{
+			continue;
+		}
+
+		Entry.Percent = Entry.PendingPercent;
+		++Stats.UpdatesApplied;
+
+		// batched bars just read the new value when they're drawn
+		if (!Entry.bBatched && Entry.Widget)
+		{
+			Entry.Widget->SetLifePercentage(Entry.Percent);
+
+			if (Entry.Anchor && Entry.Anchor->GetManuallyRedraw())
+			{
+				Entry.Anchor->RequestRedraw();
+			}
+		}
+	}
+
+	if (!bHasBatchedBars)
+	{
+		return;
+	}
+
+	EnsureLayer();
+
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+
+	if (!PlayerController || !PlayerController->PlayerCameraManager)
+	{
+		return;
+	}
+
+	const FVector CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	const float CullDistanceSquared = FMath::Square(GCombatLifeBarsCullDistance);
+
+	const float ViewportScale = FMath::Max(UWidgetLayoutLibrary::GetViewportScale(PlayerController), UE_KINDA_SMALL_NUMBER);
+	const FVector2D ViewportSize = UWidgetLayoutLibrary::GetViewportSize(PlayerController) / ViewportScale;
+
+	// build the draw list for the batched bars
+	for (const FCombatLifeBarEntry& Entry : Entries)
+	{
+		if (!Entry.bBatched || !Entry.Anchor)
+		{
+			continue;
+		}
+
+		// skip bars that are hidden
+		const AActor* Owner = Entry.Anchor->GetOwner();
+
+		if (Entry.Anchor->bHiddenInGame || (Owner && Owner->IsHidden()))
+		{
+			continue;
+		}
+
+		// cull distant bars
+		const FVector WorldLocation = Entry.Anchor->GetComponentLocation();
+		const float DistanceSquared = FVector::DistSquared(WorldLocation, CameraLocation);
+
+		if (DistanceSquared > CullDistanceSquared)
+		{
+			++Stats.Culled;
+			continue;
+		}
+
+		// cull bars behind the camera or off-screen
+		FVector2D ScreenPosition;
+
+		if (!UWidgetLayoutLibrary::ProjectWorldLocationToWidgetPosition(PlayerController, WorldLocation, ScreenPosition, false)
+			|| ScreenPosition.X < 0.0f || ScreenPosition.Y < 0.0f || ScreenPosition.X > ViewportSize.X || ScreenPosition.Y > ViewportSize.Y)
+		{
+			++Stats.Culled;
+			continue;
+		}
+
+		FCombatLifeBarDrawItem& Item = DrawItems.AddDefaulted_GetRef();
+		Item.Position = ScreenPosition;
+		Item.Percent = Entry.Percent;
+		Item.Scale = FMath::Clamp(GCombatLifeBarsFullScaleDistance / FMath::Max(FMath::Sqrt(DistanceSquared), 1.0f), 0.5f, 1.0f);
+	}
+
+	Stats.Drawn = DrawItems.Num();
+}
+
+void UCombatLifeBarSubsystem::EnsureLayer()
+{
+	if (Layer)
+	{
+		return;
+	}
+
+	if (APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+	{
+		if (PlayerController->IsLocalController())
+		{
+			// draw below the rest of the HUD
+			Layer = CreateWidget<UCombatLifeBarLayer>(PlayerController, UCombatLifeBarLayer::StaticClass());
+			Layer->AddToPlayerScreen(-10);
+		}
+	}
+}
@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GameWorldTickFunction.h"
+#include "CombatLifeBarSubsystem.generated.h"
+
+class UWidgetComponent;
+class UCombatLifeBar;
+class UCombatLifeBarLayer;
+
+/**
+ *  A life bar tracked by the life bar subsystem
+ */
+USTRUCT()
+struct FCombatLifeBarEntry
+{
+	GENERATED_BODY()
+
+	/** Widget component the bar is attached to. Its location and hidden flag drive the bar */
+	UPROPERTY()
+	TObjectPtr<UWidgetComponent> Anchor;
+
+	/** Life bar widget, used when the bar isn't batched */
+	UPROPERTY()
+	TObjectPtr<UCombatLifeBar> Widget;
+
+	/** Last percentage pushed to the bar */
+	float Percent = 1.0f;
+
+	/** Percentage waiting for the next flush */
+	float PendingPercent = 1.0f;
+
+	/** If true, PendingPercent changed since the last flush */
+	bool bDirty = false;
+
+	/** If true, the bar is drawn by the shared layer instead of its own widget component */
+	bool bBatched = false;
+};
+
+/**
+ *  A life bar to be drawn by the shared layer this frame, in viewport widget space
+ */
+struct FCombatLifeBarDrawItem
+{
+	/** Center of the bar */
+	FVector2D Position = FVector2D::ZeroVector;
+
+	/** Fill percentage */
+	float Percent = 1.0f;
+
+	/** Size multiplier, shrinks with distance */
+	float Scale = 1.0f;
+};
+
+/**
+ *  Running statistics for the life bars
+ */
+USTRUCT(BlueprintType)
+struct FCombatLifeBarStats
+{
+	GENERATED_BODY()
+
+	/** Number of tracked life bars */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Life Bars")
+	int32 LifeBars = 0;
+
+	/** Number of batched bars drawn last frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Life Bars")
+	int32 Drawn = 0;
+
+	/** Number of batched bars culled last frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Life Bars")
+	int32 Culled = 0;
+
+	/** Total number of percentage changes requested */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Life Bars")
+	int32 UpdatesRequested = 0;
+
+	/** Total number of percentage changes applied after coalescing */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Life Bars")
+	int32 UpdatesApplied = 0;
+};
+
+/**
+ *  Coalesces life bar updates and draws enemy life bars through one shared HUD layer.
+ *  Percentage changes are applied at most once per bar per frame.
+ *  Batched bars hide their widget components and are drawn by a single UCombatLifeBarLayer,
+ *  skipping bars that are hidden, off-screen or too far away.
+ *  Bars that aren't batched only redraw their widget components when their percentage changes.
+ */
+UCLASS()
+class UCombatLifeBarSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Tracked life bars */
+	UPROPERTY()
+	TArray<FCombatLifeBarEntry> Entries;
+
+	/** Anchor component to entry index */
+	TMap<TObjectKey<UWidgetComponent>, int32> EntryLookup;
+
+	/** Batched bars to draw this frame */
+	TArray<FCombatLifeBarDrawItem> DrawItems;
+
+	/** Shared layer drawing the batched bars */
+	UPROPERTY()
+	TObjectPtr<UCombatLifeBarLayer> Layer;
+
+	/** Tick function that flushes updates and builds the draw list */
+	FGameWorldTickFunction FlushTickFunction;
+
+	/** Statistics */
+	FCombatLifeBarStats Stats;
+
+public:
+
+	/** Starts tracking a life bar. Batching is only used if allowed here and enabled with Combat.LifeBars.Batched */
+	void RegisterLifeBar(UWidgetComponent* Anchor, UCombatLifeBar* Widget, bool bAllowBatching);
+
+	/** Stops tracking a life bar */
+	void UnregisterLifeBar(UWidgetComponent* Anchor);
+
+	/** Queues a percentage change for a tracked bar. Returns false if the bar isn't tracked */
+	bool SetLifePercentage(UWidgetComponent* Anchor, float Percent);
+
+	/** Sets a life bar's percentage through the subsystem if it's tracked, or directly on the widget if not */
+	static void UpdateLifeBar(UWidgetComponent* Anchor, UCombatLifeBar* Widget, float Percent);
+
+	/** Returns the batched bars to draw this frame */
+	const TArray<FCombatLifeBarDrawItem>& GetDrawItems() const { return DrawItems; }
+
+	/** Returns the statistics */
+	const FCombatLifeBarStats& GetStats() const { return Stats; }
+
+	/** Writes the statistics to the log */
+	void DumpStats() const;
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the flush tick function */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Applies pending percentages and builds the draw list for the batched bars */
+	void Flush(float DeltaTime);
+
+	/** Creates the shared layer for the first local player, if needed */
+	void EnsureLayer();
+};
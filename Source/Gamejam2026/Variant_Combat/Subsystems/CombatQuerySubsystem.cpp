@@ -0,0 +1,493 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatQuerySubsystem.h"
+#include "CombatStats.h"
+#include "CombatEnemy.h"
+#include "PlayerSnapshotSubsystem.h"
+#include "EnvironmentQuery/EnvQuery.h"
+#include "EnvironmentQuery/EnvQueryManager.h"
+#include "EnvironmentQuery/EnvQueryTypes.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Gamejam2026.h"
+
+static float GCombatQueryBudgetMs = 1.0f;
+static FAutoConsoleVariableRef CVarCombatQueryBudgetMs(
+	TEXT("Combat.Query.BudgetMs"),
+	GCombatQueryBudgetMs,
+	TEXT("Time that can be spent resolving enemy query requests and starting EQS runs each frame, in milliseconds. At least one run starts per frame"),
+	ECVF_Default
+);
+
+static int32 GCombatQueryMaxInFlight = 8;
+static FAutoConsoleVariableRef CVarCombatQueryMaxInFlight(
+	TEXT("Combat.Query.MaxInFlight"),
+	GCombatQueryMaxInFlight,
+	TEXT("Number of enemy EQS runs that can be in flight at once. Requests that need a new run wait until one finishes"),
+	ECVF_Default
+);
+
+static float GCombatQueryCacheTime = 0.5f;
+static FAutoConsoleVariableRef CVarCombatQueryCacheTime(
+	TEXT("Combat.Query.CacheTime"),
+	GCombatQueryCacheTime,
+	TEXT("Time a query result can be shared with other requests, in seconds. Expired results are still served while their refresh runs. Zero disables sharing"),
+	ECVF_Default
+);
+
+static float GCombatQueryQuantizeSize = 200.0f;
+static FAutoConsoleVariableRef CVarCombatQueryQuantizeSize(
+	TEXT("Combat.Query.QuantizeSize"),
+	GCombatQueryQuantizeSize,
+	TEXT("Grid size context locations are snapped to when matching requests, in cm"),
+	ECVF_Default
+);
+
+static float GCombatQueryReservationRadius = 150.0f;
+static FAutoConsoleVariableRef CVarCombatQueryReservationRadius(
+	TEXT("Combat.Query.ReservationRadius"),
+	GCombatQueryReservationRadius,
+	TEXT("Result points closer than this to a point reserved by another enemy are skipped, in cm"),
+	ECVF_Default
+);
+
+static float GCombatQueryReservationTime = 3.0f;
+static FAutoConsoleVariableRef CVarCombatQueryReservationTime(
+	TEXT("Combat.Query.ReservationTime"),
+	GCombatQueryReservationTime,
+	TEXT("Time a reserved result point is held, in seconds"),
+	ECVF_Default
+);
+
+static int32 GCombatQueryMaxPoints = 16;
+static FAutoConsoleVariableRef CVarCombatQueryMaxPoints(
+	TEXT("Combat.Query.MaxPoints"),
+	GCombatQueryMaxPoints,
+	TEXT("Number of best scoring result points kept from each query run"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithWorld CombatQueryStatsCommand(
+	TEXT("Combat.Query.Stats"),
+	TEXT("Logs the shared enemy query cache hit rate, the EQS runs in flight and budget use"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UCombatQuerySubsystem* Query = World ? World->GetSubsystem<UCombatQuerySubsystem>() : nullptr)
+		{
+			Query->DumpStats();
+		}
+	})
+);
+
+namespace
+{
+	/** Snaps a location to the query sharing grid */
+	FIntVector QuantizeLocation(const FVector& Location, float GridSize)
+	{
+		return FIntVector(
+			FMath::FloorToInt32(Location.X / GridSize),
+			FMath::FloorToInt32(Location.Y / GridSize),
+			FMath::FloorToInt32(Location.Z / GridSize));
+	}
+}
+
+int32 UCombatQuerySubsystem::RequestQuery(ACombatEnemy* Querier, UEnvQuery* Template, FOnCombatQueryFinished OnFinished, EEnvQueryRunMode::Type RunMode, const TArray<FAIDynamicParam>& QueryConfig)
+{
+	if (!Querier || !Template)
+	{
+		return INDEX_NONE;
+	}
+
+	FCombatQueryRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.RequestId = ++LastRequestId;
+	Request.Querier = Querier;
+	Request.Template = Template;
+	Request.QueryConfig = QueryConfig;
+	Request.RunMode = RunMode;
+	Request.OnFinished = MoveTemp(OnFinished);
+
+	++Stats.Requests;
+
+	return Request.RequestId;
+}
+
+void UCombatQuerySubsystem::CancelQuery(int32 RequestId)
+{
+	if (RequestId != INDEX_NONE)
+	{
+		PendingRequests.RemoveAll([RequestId](const FCombatQueryRequest& Request) { return Request.RequestId == RequestId; });
+	}
+}
+
+void UCombatQuerySubsystem::ReleaseReservation(const ACombatEnemy* Querier)
+{
+	Reservations.Remove(Querier);
+}
+
+void UCombatQuerySubsystem::DumpStats() const
+{
+	const float HitRate = Stats.Requests > 0 ? 100.0f * Stats.CacheHits / Stats.Requests : 0.0f;
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat query: %d requests, %d EQS runs, %d cache hits (%.1f%%), %d stale hits, %d reserved points avoided"),
+		Stats.Requests, Stats.QueriesRun, Stats.CacheHits, HitRate, Stats.StaleHits, Stats.ReservationsAvoided);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat query: %d pending, %d in flight (max %d), %d cached results, %d reservations, %.3f ms last frame (budget %.2f ms)"),
+		Stats.Pending, Stats.InFlight, GCombatQueryMaxInFlight, Cache.Num(), Reservations.Num(), Stats.QueryTimeMs, GCombatQueryBudgetMs);
+}
+
+bool UCombatQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatQuerySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// process requests before the StateTrees tick, so results queued last frame are available this frame
+	ProcessTickFunction.OnTick.BindUObject(this, &UCombatQuerySubsystem::ProcessRequests);
+	ProcessTickFunction.Register(&InWorld, TG_PrePhysics, false, TEXT("CombatQuery"));
+}
+
+void UCombatQuerySubsystem::Deinitialize()
+{
+	ProcessTickFunction.Unregister();
+
+	// don't leave EQS running queries nobody will collect
+	for (TPair<FCombatQueryKey, FCombatQueryCacheEntry>& Pair : Cache)
+	{
+		AbortQuery(Pair.Value);
+	}
+
+	PendingRequests.Empty();
+	Cache.Empty();
+	RunningQueries.Empty();
+	Reservations.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatQuerySubsystem::ProcessRequests(float DeltaTime)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(Queries);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bShareResults = GCombatQueryCacheTime > 0.0f;
+
+	// EQS can't finish a run once its owner is gone, so drop it. Its waiting requests will start another
+	for (TPair<FCombatQueryKey, FCombatQueryCacheEntry>& Pair : Cache)
+	{
+		if (Pair.Value.QueryId != INDEX_NONE && !Pair.Value.QueryOwner.IsValid())
+		{
+			AbortQuery(Pair.Value);
+		}
+	}
+
+	const double BudgetSeconds = GCombatQueryBudgetMs * 0.001;
+
+	// the EQS runs themselves are time sliced by the EQS manager. The budget covers our side: cache lookups,
+	// reservations and starting runs. At least one run starts per frame so requests can't starve
+	bool bStartedRun = false;
+	auto CanStartRun = [&]()
+	{
+		return RunningQueries.Num() < GCombatQueryMaxInFlight && (!bStartedRun || FPlatformTime::Seconds() - StartTime < BudgetSeconds);
+	};
+
+	int32 KeepCount = 0;
+
+	// delegates fire after the queue is compacted, so callers can safely queue or cancel requests from them
+	TArray<TTuple<FOnCombatQueryFinished, bool, FVector>> Finished;
+
+	// resolve requests in order
+	for (int32 i = 0; i < PendingRequests.Num(); ++i)
+	{
+		FCombatQueryRequest& Request = PendingRequests[i];
+
+		ACombatEnemy* Querier = Request.Querier.Get();
+		const UEnvQuery* Template = Request.Template.Get();
+
+		// drop requests from dead or recycled enemies
+		if (!IsValid(Querier) || !Template || Querier->IsInPool())
+		{
+			continue;
+		}
+
+		// keep waiting on the entry we started on, even if we've moved since
+		const FCombatQueryKey Key = Request.WaitingKey.IsSet() ? Request.WaitingKey.GetValue() : MakeKey(Querier, Request, bShareResults ? INDEX_NONE : Request.RequestId);
+		FCombatQueryCacheEntry* Entry = Cache.Find(Key);
+
+		if (Entry && Entry->bHasResult)
+		{
+			if (Request.WaitingKey.IsSet())
+			{
+				// the run we were waiting on has finished
+			}
+			else if (Now - Entry->Time <= GCombatQueryCacheTime)
+			{
+				++Stats.CacheHits;
+			}
+			else
+			{
+				// the result has expired. Refresh it in the background and answer from the old result in the meantime
+				if (Entry->QueryId == INDEX_NONE && CanStartRun())
+				{
+					bStartedRun |= StartQuery(Request, Key, *Entry);
+				}
+
+				++Stats.StaleHits;
+			}
+
+			FVector Location = FVector::ZeroVector;
+			const bool bSuccess = ReservePoint(Querier, Request.RunMode, *Entry, Location);
+
+			Finished.Emplace(MoveTemp(Request.OnFinished), bSuccess, Location);
+			continue;
+		}
+
+		// nothing to serve yet, so wait on the run in flight, or start one if there's room
+		if (!Entry || Entry->QueryId == INDEX_NONE)
+		{
+			if (CanStartRun())
+			{
+				if (!StartQuery(Request, Key, Entry ? *Entry : Cache.Add(Key)))
+				{
+					// EQS couldn't take the query, so it will never resolve
+					Finished.Emplace(MoveTemp(Request.OnFinished), false, FVector::ZeroVector);
+					continue;
+				}
+
+				bStartedRun = true;
+				Request.WaitingKey = Key;
+			}
+		}
+		else if (!Request.WaitingKey.IsSet())
+		{
+			// share the run another request started
+			Request.WaitingKey = Key;
+			++Stats.CacheHits;
+		}
+
+		if (KeepCount != i)
+		{
+			PendingRequests[KeepCount] = MoveTemp(Request);
+		}
+
+		++KeepCount;
+	}
+
+	PendingRequests.SetNum(KeepCount, EAllowShrinking::No);
+
+	// expire old results and reservations. Results are kept for a second cache window, so they can be served while their refresh runs
+	for (auto It = Cache.CreateIterator(); It; ++It)
+	{
+		const FCombatQueryCacheEntry& Entry = It.Value();
+
+		if (Entry.QueryId == INDEX_NONE && (!Entry.bHasResult || Now - Entry.Time > 2.0 * GCombatQueryCacheTime))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = Reservations.CreateIterator(); It; ++It)
+	{
+		if (Now > It.Value().ExpireTime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (TTuple<FOnCombatQueryFinished, bool, FVector>& Result : Finished)
+	{
+		Result.Get<0>().ExecuteIfBound(Result.Get<1>(), Result.Get<2>());
+	}
+
+	Stats.Pending = PendingRequests.Num();
+	Stats.InFlight = RunningQueries.Num();
+	Stats.QueryTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+FCombatQueryKey UCombatQuerySubsystem::MakeKey(const ACombatEnemy* Querier, const FCombatQueryRequest& Request, int32 UnsharedRequestId) const
+{
+	const float GridSize = FMath::Max(GCombatQueryQuantizeSize, 1.0f);
+
+	FCombatQueryKey Key;
+	Key.Template = Request.Template.Get();
+
+	// only requests with the same config overrides see the same results
+	for (const FAIDynamicParam& Param : Request.QueryConfig)
+	{
+		Key.ConfigHash = HashCombineFast(Key.ConfigHash, HashCombineFast(GetTypeHash(Param.ParamName), GetTypeHash(Param.Value)));
+	}
+
+	Key.UnsharedRequestId = UnsharedRequestId;
+	Key.QuerierCell = QuantizeLocation(Querier->GetActorLocation(), GridSize);
+	Key.DangerCell = QuantizeLocation(Querier->GetLastDangerLocation(), GridSize);
+
+	if (const FPlayerSnapshot* PlayerSnapshot = UPlayerSnapshotSubsystem::Get(this))
+	{
+		Key.PlayerCell = QuantizeLocation(PlayerSnapshot->Location, GridSize);
+	}
+
+	return Key;
+}
+
+bool UCombatQuerySubsystem::StartQuery(const FCombatQueryRequest& Request, const FCombatQueryKey& Key, FCombatQueryCacheEntry& Entry)
+{
+	UEnvQueryManager* QueryManager = UEnvQueryManager::GetCurrent(GetWorld());
+
+	if (!QueryManager)
+	{
+		return false;
+	}
+
+	// run the query with the requesting enemy as the owner, so its contexts resolve as usual.
+	// EQS time slices it across frames and calls us back once it's done
+	FEnvQueryRequest QueryRequest(Request.Template.Get(), Request.Querier.Get());
+
+	for (const FAIDynamicParam& Param : Request.QueryConfig)
+	{
+		QueryRequest.SetDynamicParam(Param);
+	}
+
+	const int32 QueryId = QueryManager->RunQuery(QueryRequest, EEnvQueryRunMode::AllMatching,
+		FQueryFinishedSignature::CreateUObject(this, &UCombatQuerySubsystem::OnQueryFinished));
+
+	if (QueryId == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Entry.QueryId = QueryId;
+	Entry.QueryOwner = Request.Querier;
+	RunningQueries.Add(QueryId, Key);
+
+	++Stats.QueriesRun;
+
+	return true;
+}
+
+void UCombatQuerySubsystem::OnQueryFinished(TSharedPtr<FEnvQueryResult> Result)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(Queries);
+
+	FCombatQueryKey Key;
+
+	// ignore runs we've already dropped
+	if (!Result.IsValid() || !RunningQueries.RemoveAndCopyValue(Result->QueryID, Key))
+	{
+		return;
+	}
+
+	FCombatQueryCacheEntry* Entry = Cache.Find(Key);
+
+	if (!Entry || Entry->QueryId != Result->QueryID)
+	{
+		return;
+	}
+
+	Entry->QueryId = INDEX_NONE;
+	Entry->QueryOwner.Reset();
+
+	// an aborted run leaves the previous result in place
+	if (Result->IsAborted())
+	{
+		return;
+	}
+
+	Entry->Time = GetWorld()->GetTimeSeconds();
+	Entry->bHasResult = true;
+	Entry->Points.Reset();
+
+	// keep the best scoring points. All matching results come sorted by score
+	if (Result->IsSuccessful())
+	{
+		const int32 NumPoints = FMath::Min(Result->Items.Num(), FMath::Max(GCombatQueryMaxPoints, 1));
+		Entry->Points.Reserve(NumPoints);
+
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			Entry->Points.Add(Result->GetItemAsLocation(i));
+		}
+	}
+}
+
+void UCombatQuerySubsystem::AbortQuery(FCombatQueryCacheEntry& Entry)
+{
+	if (Entry.QueryId == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (UEnvQueryManager* QueryManager = UEnvQueryManager::GetCurrent(GetWorld()))
+	{
+		QueryManager->AbortQuery(Entry.QueryId);
+	}
+
+	RunningQueries.Remove(Entry.QueryId);
+
+	Entry.QueryId = INDEX_NONE;
+	Entry.QueryOwner.Reset();
+}
+
+bool UCombatQuerySubsystem::ReservePoint(const ACombatEnemy* Querier, EEnvQueryRunMode::Type RunMode, const FCombatQueryCacheEntry& Entry, FVector& OutLocation)
+{
+	if (Entry.Points.Num() == 0)
+	{
+		return false;
+	}
+
+	const float RadiusSquared = FMath::Square(GCombatQueryReservationRadius);
+	const TObjectKey<ACombatEnemy> QuerierKey(Querier);
+
+	// random modes pick among the best few points, like EQS picks among the best scores
+	int32 NumCandidates = 1;
+
+	if (RunMode == EEnvQueryRunMode::RandomBest5Pct)
+	{
+		NumCandidates = FMath::CeilToInt32(Entry.Points.Num() * 0.05f);
+	}
+	else if (RunMode == EEnvQueryRunMode::RandomBest25Pct)
+	{
+		NumCandidates = FMath::CeilToInt32(Entry.Points.Num() * 0.25f);
+	}
+
+	// take the best points that nobody else has claimed. Fall back to the best point if they're all taken
+	TArray<int32, TInlineAllocator<16>> Candidates;
+
+	for (int32 i = 0; i < Entry.Points.Num() && Candidates.Num() < NumCandidates; ++i)
+	{
+		bool bReserved = false;
+
+		for (const TPair<TObjectKey<ACombatEnemy>, FCombatQueryReservation>& Pair : Reservations)
+		{
+			if (Pair.Key != QuerierKey && FVector::DistSquared(Pair.Value.Location, Entry.Points[i]) < RadiusSquared)
+			{
+				bReserved = true;
+				break;
+			}
+		}
+
+		if (!bReserved)
+		{
+			Candidates.Add(i);
+		}
+	}
+
+	if (Candidates.Num() > 0 && Candidates[0] > 0)
+	{
+		++Stats.ReservationsAvoided;
+	}
+
+	const int32 ChosenIndex = Candidates.Num() > 0 ? Candidates[FMath::RandHelper(Candidates.Num())] : 0;
+
+	OutLocation = Entry.Points[ChosenIndex];
+
+	FCombatQueryReservation& Reservation = Reservations.FindOrAdd(QuerierKey);
+	Reservation.Location = OutLocation;
+	Reservation.ExpireTime = GetWorld()->GetTimeSeconds() + GCombatQueryReservationTime;
+
+	return true;
+}
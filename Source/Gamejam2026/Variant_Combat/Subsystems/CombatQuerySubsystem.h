@@ -0,0 +1,245 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "EnvironmentQuery/EnvQueryTypes.h"
+#include "DataProviders/AIDataProvider.h"
+#include "GameWorldTickFunction.h"
+#include "CombatQuerySubsystem.generated.h"
+
+class ACombatEnemy;
+class UEnvQuery;
+struct FEnvQueryResult;
+
+/** Called when a shared query request resolves. Location is only valid on success */
+DECLARE_DELEGATE_TwoParams(FOnCombatQueryFinished, bool /*bSuccess*/, const FVector& /*Location*/);
+
+/**
+ *  Identifies queries that can share results.
+ *  Context locations are quantized so enemies standing close together against the same player position match.
+ */
+struct FCombatQueryKey
+{
+	/** Query template */
+	TObjectKey<UEnvQuery> Template;
+
+	/** Quantized querier location */
+	FIntVector QuerierCell = FIntVector::ZeroValue;
+
+	/** Quantized player location */
+	FIntVector PlayerCell = FIntVector::ZeroValue;
+
+	/** Quantized last danger location */
+	FIntVector DangerCell = FIntVector::ZeroValue;
+
+	/** Hash of the query config overrides */
+	uint32 ConfigHash = 0;
+
+	/** Id of the request that owns the run when sharing is disabled, otherwise INDEX_NONE */
+	int32 UnsharedRequestId = INDEX_NONE;
+
+	bool operator==(const FCombatQueryKey& Other) const
+	{
+		return Template == Other.Template && QuerierCell == Other.QuerierCell && PlayerCell == Other.PlayerCell && DangerCell == Other.DangerCell
+			&& ConfigHash == Other.ConfigHash && UnsharedRequestId == Other.UnsharedRequestId;
+	}
+
+	friend uint32 GetTypeHash(const FCombatQueryKey& Key)
+	{
+		uint32 Hash = GetTypeHash(Key.Template);
+		Hash = HashCombineFast(Hash, GetTypeHash(Key.QuerierCell));
+		Hash = HashCombineFast(Hash, GetTypeHash(Key.PlayerCell));
+		Hash = HashCombineFast(Hash, GetTypeHash(Key.DangerCell));
+		Hash = HashCombineFast(Hash, Key.ConfigHash);
+		return HashCombineFast(Hash, GetTypeHash(Key.UnsharedRequestId));
+	}
+};
+
+/**
+ *  Cached result of a query run, and the run refreshing it
+ */
+struct FCombatQueryCacheEntry
+{
+	/** Result locations, best score first */
+	TArray<FVector> Points;
+
+	/** Game time the last run finished */
+	double Time = 0.0;
+
+	/** If true, a run has finished and Points can be served */
+	bool bHasResult = false;
+
+	/** Id of the EQS run in flight for this entry, or INDEX_NONE */
+	int32 QueryId = INDEX_NONE;
+
+	/** Enemy that owns the run in flight. The run is dropped if it goes away */
+	TWeakObjectPtr<ACombatEnemy> QueryOwner;
+};
+
+/**
+ *  A queued query request
+ */
+struct FCombatQueryRequest
+{
+	/** Handle returned to the caller */
+	int32 RequestId = INDEX_NONE;
+
+	/** Enemy running the query */
+	TWeakObjectPtr<ACombatEnemy> Querier;
+
+	/** Query template to run */
+	TWeakObjectPtr<UEnvQuery> Template;
+
+	/** Query config overrides */
+	TArray<FAIDynamicParam> QueryConfig;
+
+	/** How the result point is picked. Random modes pick among the best few unreserved points */
+	TEnumAsByte<EEnvQueryRunMode::Type> RunMode = EEnvQueryRunMode::SingleResult;
+
+	/** Called when the request resolves */
+	FOnCombatQueryFinished OnFinished;
+
+	/** Cache entry the request is waiting on, once a run has been started for it */
+	TOptional<FCombatQueryKey> WaitingKey;
+};
+
+/**
+ *  A result point reserved by an enemy
+ */
+struct FCombatQueryReservation
+{
+	/** Reserved location */
+	FVector Location = FVector::ZeroVector;
+
+	/** Game time the reservation expires */
+	double ExpireTime = 0.0;
+};
+
+/**
+ *  Running statistics for the shared query layer
+ */
+USTRUCT(BlueprintType)
+struct FCombatQueryStats
+{
+	GENERATED_BODY()
+
+	/** Total number of requests */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Query")
+	int32 Requests = 0;
+
+	/** Total number of requests answered from a cached run */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Query")
+	int32 CacheHits = 0;
+
+	/** Total number of EQS runs */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Query")
+	int32 QueriesRun = 0;
+
+	/** Total number of times a reserved point was skipped in favor of a free one */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Query")
+	int32 ReservationsAvoided = 0;
+
+	/** Total number of requests answered from an expired result while its refresh was in flight */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Query")
+	int32 StaleHits = 0;
+
+	/** Number of requests waiting for a first result after the last update */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Query")
+	int32 Pending = 0;
+
+	/** Number of EQS runs in flight after the last update */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Query")
+	int32 InFlight = 0;
+
+	/** Time spent resolving requests during the last update */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Query", meta = (Units = "ms"))
+	float QueryTimeMs = 0.0f;
+};
+
+/**
+ *  Coalesces and caches the EQS positioning queries run by combat enemies.
+ *  Requests with the same template and near-identical contexts within the cache window share a single EQS run.
+ *  Each enemy reserves a distinct result point so enemies sharing a result don't stack on the same spot.
+ *  Queries run asynchronously through the EQS manager's time sliced queue. Resolving requests and starting runs is held to a
+ *  per-frame millisecond budget, and the number of runs in flight is capped so enemy queries can't crowd the EQS queue.
+ *  Once a result expires, the next matching request starts a refresh and is answered from the old result while it runs.
+ *  Requests with no result to serve yet wait for the run to finish.
+ */
+UCLASS()
+class UCombatQuerySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Requests waiting to run, oldest first */
+	TArray<FCombatQueryRequest> PendingRequests;
+
+	/** Results of recent query runs */
+	TMap<FCombatQueryKey, FCombatQueryCacheEntry> Cache;
+
+	/** Cache entries waiting on each EQS run in flight, by query id */
+	TMap<int32, FCombatQueryKey> RunningQueries;
+
+	/** Result points reserved by each enemy */
+	TMap<TObjectKey<ACombatEnemy>, FCombatQueryReservation> Reservations;
+
+	/** Tick function that processes the pending requests */
+	FGameWorldTickFunction ProcessTickFunction;
+
+	/** Last request handle given out */
+	int32 LastRequestId = 0;
+
+	/** Query statistics */
+	FCombatQueryStats Stats;
+
+public:
+
+	/** Queues a query for the enemy. Returns a handle that can be used to cancel it */
+	int32 RequestQuery(ACombatEnemy* Querier, UEnvQuery* Template, FOnCombatQueryFinished OnFinished,
+		EEnvQueryRunMode::Type RunMode = EEnvQueryRunMode::SingleResult, const TArray<FAIDynamicParam>& QueryConfig = TArray<FAIDynamicParam>());
+
+	/** Cancels a queued request. Its delegate won't be called */
+	void CancelQuery(int32 RequestId);
+
+	/** Releases the point reserved by the enemy */
+	void ReleaseReservation(const ACombatEnemy* Querier);
+
+	/** Returns the query statistics */
+	const FCombatQueryStats& GetStats() const { return Stats; }
+
+	/** Writes the query statistics to the log */
+	void DumpStats() const;
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the processing tick function */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Resolves pending requests from the cache, starts the runs they need, then expires old results and reservations */
+	void ProcessRequests(float DeltaTime);
+
+	/** Builds the sharing key for a request. Pass a request id to give the request a run of its own */
+	FCombatQueryKey MakeKey(const ACombatEnemy* Querier, const FCombatQueryRequest& Request, int32 UnsharedRequestId = INDEX_NONE) const;
+
+	/** Starts an async EQS run that will fill the cache entry. Returns false if the run couldn't start */
+	bool StartQuery(const FCombatQueryRequest& Request, const FCombatQueryKey& Key, FCombatQueryCacheEntry& Entry);
+
+	/** Stores the results of a finished EQS run in its cache entry */
+	void OnQueryFinished(TSharedPtr<FEnvQueryResult> Result);
+
+	/** Aborts an EQS run in flight and detaches it from its cache entry */
+	void AbortQuery(FCombatQueryCacheEntry& Entry);
+
+	/** Picks a result point not reserved by another enemy according to the run mode, and reserves it */
+	bool ReservePoint(const ACombatEnemy* Querier, EEnvQueryRunMode::Type RunMode, const FCombatQueryCacheEntry& Entry, FVector& OutLocation);
+};
@@ -0,0 +1,535 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatReplaySubsystem.h"
+#include "CombatCharacter.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Gamejam2026.h"
+
+namespace
+{
+	/** Replay file identifier */
+	constexpr uint32 ReplayMagic = 0x4C505243; // "CRPL"
+
+	/** Replay file version. Bump when the format changes */
+	constexpr uint16 ReplayVersion = 1;
+
+	/** Flag set on an event header when the axis value is the same as the last event of its type */
+	constexpr uint8 RepeatFlag = 0x80;
+
+	/** Returns true for inputs that carry an axis value */
+	bool HasAxisValue(ECombatReplayInput Input)
+	{
+		return Input == ECombatReplayInput::Move || Input == ECombatReplayInput::Look;
+	}
+}
+
+static FAutoConsoleCommandWithWorld CombatReplayStopCommand(
+	TEXT("Combat.Replay.Stop"),
+	TEXT("Stops the combat replay recording and writes it to disk"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UCombatReplaySubsystem* Replay = World ? World->GetSubsystem<UCombatReplaySubsystem>() : nullptr)
+		{
+			Replay->StopRecording();
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorld CombatReplayStatsCommand(
+	TEXT("Combat.Replay.Stats"),
+	TEXT("Logs the combat replay mode, frame and event counts"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UCombatReplaySubsystem* Replay = World ? World->GetSubsystem<UCombatReplaySubsystem>() : nullptr)
+		{
+			Replay->DumpStats();
+		}
+	})
+);
+
+int32 UCombatReplaySubsystem::NextSeed()
+{
+	return static_cast<int32>(SeedStream.GetUnsignedInt());
+}
+
+int32 UCombatReplaySubsystem::MakeSeed(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+
+	if (UCombatReplaySubsystem* Replay = World ? World->GetSubsystem<UCombatReplaySubsystem>() : nullptr)
+	{
+		return Replay->NextSeed();
+	}
+
+	return FMath::Rand();
+}
+
+bool UCombatReplaySubsystem::ProcessInput(ACombatCharacter* Character, ECombatReplayInput Input, const FVector2D& Value)
+{
+	// only the player's input is replayed
+	if (!Character || !Character->IsPlayerControlled())
+	{
+		return true;
+	}
+
+	UCombatReplaySubsystem* Replay = Character->GetWorld()->GetSubsystem<UCombatReplaySubsystem>();
+
+	if (!Replay)
+	{
+		return true;
+	}
+
+	switch (Replay->Mode)
+	{
+	case ECombatReplayMode::Recording:
+		Replay->RecordInput(Input, Value);
+		return true;
+
+	case ECombatReplayMode::Playback:
+		// swallow live input, only let the recorded stream through
+		return Replay->bInjectingInput;
+
+	default:
+		return true;
+	}
+}
+
+void UCombatReplaySubsystem::StopRecording()
+{
+	if (Mode != ECombatReplayMode::Recording)
+	{
+		return;
+	}
+
+	Mode = ECombatReplayMode::Idle;
+	StreamArchive.Reset();
+
+	NumFrames = FrameIndex + 1;
+
+	// write the header followed by the event stream
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+
+	uint32 Magic = ReplayMagic;
+	uint16 Version = ReplayVersion;
+	FString MapName = GetWorld()->GetMapName();
+
+	Writer << Magic;
+	Writer << Version;
+	Writer << FixedFrameRate;
+	Writer << Seed;
+	Writer << MapName;
+	Writer << NumFrames;
+	Writer << NumEvents;
+	Writer << Stream;
+
+	const FString FilePath = GetReplayPath();
+
+	if (FFileHelper::SaveArrayToFile(FileData, *FilePath))
+	{
+		UE_LOG(LogGamejam2026, Log, TEXT("Combat replay: recorded %d frames and %d events (%d bytes) to %s"), NumFrames, NumEvents, FileData.Num(), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogGamejam2026, Error, TEXT("Combat replay: couldn't write %s"), *FilePath);
+	}
+
+	const FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"));
+	WriteFrameCSV(FPaths::Combine(FPaths::ProfilingDir(), TEXT("CombatReplay"), FString::Printf(TEXT("%s-Record-%s.csv"), *ReplayName, *Timestamp)));
+}
+
+void UCombatReplaySubsystem::DumpStats() const
+{
+	static const TCHAR* ModeNames[] = { TEXT("idle"), TEXT("recording"), TEXT("playing back") };
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat replay: %s '%s', frame %d of %d, %d events, %d stream bytes, seed %d"),
+		ModeNames[static_cast<int32>(Mode)], *ReplayName, FrameIndex, NumFrames, NumEvents, Stream.Num(), Seed);
+}
+
+bool UCombatReplaySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatReplaySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FParse::Value(CommandLine, TEXT("CombatReplayFPS="), FixedFrameRate);
+	FParse::Value(CommandLine, TEXT("CombatReplayDuration="), RecordDuration);
+
+	FixedFrameRate = FMath::Max(FixedFrameRate, 1.0f);
+
+	if (FParse::Value(CommandLine, TEXT("CombatReplayPlay="), ReplayName))
+	{
+		if (LoadReplay(GetReplayPath()))
+		{
+			Mode = ECombatReplayMode::Playback;
+		}
+	}
+	else if (FParse::Value(CommandLine, TEXT("CombatReplayRecord="), ReplayName) || FParse::Param(CommandLine, TEXT("CombatReplayRecord")))
+	{
+		if (ReplayName.IsEmpty())
+		{
+			ReplayName = FString::Printf(TEXT("CombatReplay-%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+		}
+
+		if (!FParse::Value(CommandLine, TEXT("CombatReplaySeed="), Seed))
+		{
+			Seed = FMath::Rand();
+		}
+
+		Stream.Reset();
+		StreamArchive = MakeUnique<FMemoryWriter>(Stream);
+
+		Mode = ECombatReplayMode::Recording;
+	}
+
+	if (Mode == ECombatReplayMode::Idle)
+	{
+		SeedStream.GenerateNewSeed();
+		return;
+	}
+
+	// start from the same repeat state on both ends
+	for (FVector2f& LastValue : LastValues)
+	{
+		LastValue = FVector2f::ZeroVector;
+	}
+
+	// seed every random source from the session seed
+	SeedStream.Initialize(Seed);
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+
+	// simulate on a fixed time step so each frame covers the same game time.
+	// This is global engine state, so remember the previous values to restore them when we're done
+	bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+	bOverrodeFixedTimeStep = true;
+
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / FixedFrameRate);
+
+	// step the frame before the player controller processes input
+	FrameTickFunction.OnTick.BindUObject(this, &UCombatReplaySubsystem::StepFrame);
+	FrameTickFunction.Register(&InWorld, TG_PrePhysics, true, TEXT("CombatReplay"));
+
+	OrderBeforePlayerController();
+
+	Frames.Reserve(Mode == ECombatReplayMode::Playback ? NumFrames : FMath::CeilToInt32(FMath::Max(RecordDuration, 60.0f) * FixedFrameRate));
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat replay: %s '%s' at %.0f fps, seed %d"),
+		Mode == ECombatReplayMode::Playback ? TEXT("playing back") : TEXT("recording"), *ReplayName, FixedFrameRate, Seed);
+}
+
+void UCombatReplaySubsystem::Deinitialize()
+{
+	// don't lose a recording when the world shuts down
+	StopRecording();
+
+	if (APlayerController* PlayerController = OrderedPlayerController.Get())
+	{
+		PlayerController->PrimaryActorTick.RemovePrerequisite(this, FrameTickFunction);
+	}
+
+	OrderedPlayerController.Reset();
+
+	FrameTickFunction.Unregister();
+	StreamArchive.Reset();
+
+	// give the editor or the next world its own time step back
+	if (bOverrodeFixedTimeStep)
+	{
+		FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+		FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+		bOverrodeFixedTimeStep = false;
+	}
+
+	Super::Deinitialize();
+}
+
+void UCombatReplaySubsystem::StepFrame(float DeltaTime)
+{
+	// pick up a player controller that was created or replaced after begin play. Takes effect on the next frame
+	OrderBeforePlayerController();
+
+	const double Now = FPlatformTime::Seconds();
+
+	// close out the previous frame's timings
+	if (LastFrameStartTime > 0.0 && Mode != ECombatReplayMode::Idle)
+	{
+		FCombatReplayFrame& Frame = Frames.AddDefaulted_GetRef();
+		Frame.FrameTimeMs = static_cast<float>((Now - LastFrameStartTime) * 1000.0);
+		Frame.GameThreadTimeMs = static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime));
+	}
+
+	LastFrameStartTime = Now;
+
+	++FrameIndex;
+
+	if (Mode == ECombatReplayMode::Recording)
+	{
+		if (RecordDuration > 0.0f && FrameIndex >= FMath::CeilToInt32(RecordDuration * FixedFrameRate))
+		{
+			StopRecording();
+		}
+	}
+	else if (Mode == ECombatReplayMode::Playback)
+	{
+		if (FrameIndex >= NumFrames)
+		{
+			FinishPlayback();
+			return;
+		}
+
+		InjectFrameInput();
+	}
+}
+
+void UCombatReplaySubsystem::OrderBeforePlayerController()
+{
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+
+	if (PlayerController == OrderedPlayerController.Get())
+	{
+		return;
+	}
+
+	if (APlayerController* PreviousController = OrderedPlayerController.Get())
+	{
+		PreviousController->PrimaryActorTick.RemovePrerequisite(this, FrameTickFunction);
+	}
+
+	// the controller processes input during its tick, and the pawn moves after its controller
+	if (PlayerController)
+	{
+		PlayerController->PrimaryActorTick.AddPrerequisite(this, FrameTickFunction);
+	}
+
+	OrderedPlayerController = PlayerController;
+}
+
+void UCombatReplaySubsystem::RecordInput(ECombatReplayInput Input, const FVector2D& Value)
+{
+	FArchive& Ar = *StreamArchive;
+
+	// frames are stored as a delta from the previous event
+	const int32 CurrentFrame = FMath::Max(FrameIndex, 0);
+	uint32 FrameDelta = static_cast<uint32>(CurrentFrame - LastEventFrame);
+	Ar.SerializeIntPacked(FrameDelta);
+
+	LastEventFrame = CurrentFrame;
+
+	// held axes usually repeat their last value, so only store values that changed
+	const int32 InputIndex = static_cast<int32>(Input);
+	const FVector2f AxisValue(Value);
+	const bool bRepeat = HasAxisValue(Input) && AxisValue == LastValues[InputIndex];
+
+	uint8 Header = static_cast<uint8>(Input) | (bRepeat ? RepeatFlag : 0);
+	Ar << Header;
+
+	if (HasAxisValue(Input) && !bRepeat)
+	{
+		FVector2f StoredValue = AxisValue;
+		Ar << StoredValue.X;
+		Ar << StoredValue.Y;
+
+		LastValues[InputIndex] = AxisValue;
+	}
+
+	++NumEvents;
+}
+
+bool UCombatReplaySubsystem::LoadReplay(const FString& FilePath)
+{
+	TArray<uint8> FileData;
+
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+	{
+		UE_LOG(LogGamejam2026, Error, TEXT("Combat replay: couldn't read %s"), *FilePath);
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	FString MapName;
+
+	Reader << Magic;
+	Reader << Version;
+
+	if (Magic != ReplayMagic || Version != ReplayVersion)
+	{
+		UE_LOG(LogGamejam2026, Error, TEXT("Combat replay: %s isn't a version %d replay"), *FilePath, ReplayVersion);
+		return false;
+	}
+
+	Reader << FixedFrameRate;
+	Reader << Seed;
+	Reader << MapName;
+	Reader << NumFrames;
+	Reader << NumEvents;
+	Reader << Stream;
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogGamejam2026, Error, TEXT("Combat replay: %s is truncated"), *FilePath);
+		return false;
+	}
+
+	if (MapName != GetWorld()->GetMapName())
+	{
+		UE_LOG(LogGamejam2026, Warning, TEXT("Combat replay: %s was recorded on %s, not %s"), *FilePath, *MapName, *GetWorld()->GetMapName());
+	}
+
+	StreamArchive = MakeUnique<FMemoryReader>(Stream);
+	ReadNextEventFrame();
+
+	return true;
+}
+
+void UCombatReplaySubsystem::ReadNextEventFrame()
+{
+	FArchive& Ar = *StreamArchive;
+
+	if (Ar.AtEnd())
+	{
+		NextEventFrame = INDEX_NONE;
+		return;
+	}
+
+	uint32 FrameDelta = 0;
+	Ar.SerializeIntPacked(FrameDelta);
+
+	NextEventFrame = LastEventFrame + static_cast<int32>(FrameDelta);
+}
+
+void UCombatReplaySubsystem::InjectFrameInput()
+{
+	ACombatCharacter* Character = GetPlayerCharacter();
+
+	// let the recorded input through the live input filter
+	TGuardValue<bool> InjectGuard(bInjectingInput, true);
+
+	while (NextEventFrame == FrameIndex)
+	{
+		FArchive& Ar = *StreamArchive;
+
+		uint8 Header = 0;
+		Ar << Header;
+
+		const ECombatReplayInput Input = static_cast<ECombatReplayInput>(Header & ~RepeatFlag);
+		const int32 InputIndex = static_cast<int32>(Input);
+
+		if (Ar.IsError() || InputIndex >= static_cast<int32>(ECombatReplayInput::Count))
+		{
+			UE_LOG(LogGamejam2026, Error, TEXT("Combat replay: corrupt event stream at frame %d"), FrameIndex);
+			NextEventFrame = INDEX_NONE;
+			return;
+		}
+
+		if (HasAxisValue(Input) && !(Header & RepeatFlag))
+		{
+			Ar << LastValues[InputIndex].X;
+			Ar << LastValues[InputIndex].Y;
+		}
+
+		const FVector2f& Value = LastValues[InputIndex];
+
+		// route the input the same way the input bindings do
+		if (Character)
+		{
+			switch (Input)
+			{
+			case ECombatReplayInput::Move:
+				Character->DoMove(Value.X, Value.Y);
+				break;
+
+			case ECombatReplayInput::Look:
+				Character->DoLook(Value.X, Value.Y);
+				break;
+
+			case ECombatReplayInput::ComboAttackStart:
+				Character->DoComboAttackStart();
+				break;
+
+			case ECombatReplayInput::ComboAttackEnd:
+				Character->DoComboAttackEnd();
+				break;
+
+			case ECombatReplayInput::ChargedAttackStart:
+				Character->DoChargedAttackStart();
+				break;
+
+			case ECombatReplayInput::ChargedAttackEnd:
+				Character->DoChargedAttackEnd();
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		LastEventFrame = NextEventFrame;
+		ReadNextEventFrame();
+	}
+}
+
+void UCombatReplaySubsystem::FinishPlayback()
+{
+	// we're inside the frame tick, so only disable it. Deinitialize unregisters it
+	Mode = ECombatReplayMode::Idle;
+	FrameTickFunction.SetTickFunctionEnable(false);
+
+	const FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"));
+	const FString FilePath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("CombatReplay"), FString::Printf(TEXT("%s-Playback-%s.csv"), *ReplayName, *Timestamp));
+
+	WriteFrameCSV(FilePath);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat replay: played back %d frames, timings written to %s"), NumFrames, *FilePath);
+
+	FPlatformMisc::RequestExitWithStatus(false, 0);
+}
+
+void UCombatReplaySubsystem::WriteFrameCSV(const FString& FilePath) const
+{
+	TArray<FString> Lines;
+	Lines.Reserve(Frames.Num() + 1);
+
+	Lines.Add(TEXT("Frame,FrameMs,GameThreadMs"));
+
+	// frame timings are recorded at the start of the following frame
+	for (int32 i = 0; i < Frames.Num(); ++i)
+	{
+		Lines.Add(FString::Printf(TEXT("%d,%.3f,%.3f"), i, Frames[i].FrameTimeMs, Frames[i].GameThreadTimeMs));
+	}
+
+	FFileHelper::SaveStringArrayToFile(Lines, *FilePath);
+}
+
+FString UCombatReplaySubsystem::GetReplayPath() const
+{
+	return FPaths::Combine(FPaths::ProfilingDir(), TEXT("CombatReplay"), ReplayName + TEXT(".replay"));
+}
+
+ACombatCharacter* UCombatReplaySubsystem::GetPlayerCharacter() const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+
+	return PlayerController ? Cast<ACombatCharacter>(PlayerController->GetPawn()) : nullptr;
+}
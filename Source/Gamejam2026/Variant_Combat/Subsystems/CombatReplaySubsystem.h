@@ -0,0 +1,195 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Math/RandomStream.h"
+#include "GameWorldTickFunction.h"
+#include "CombatReplaySubsystem.generated.h"
+
+class ACombatCharacter;
+class APlayerController;
+
+/**
+ *  Player inputs captured by the combat replay
+ */
+enum class ECombatReplayInput : uint8
+{
+	Move,
+	Look,
+	ComboAttackStart,
+	ComboAttackEnd,
+	ChargedAttackStart,
+	ChargedAttackEnd,
+	Count
+};
+
+/**
+ *  What the combat replay is doing this session
+ */
+enum class ECombatReplayMode : uint8
+{
+	Idle,
+	Recording,
+	Playback
+};
+
+/**
+ *  Timings captured for a single replay frame
+ */
+struct FCombatReplayFrame
+{
+	/** Wall time of the whole frame */
+	float FrameTimeMs = 0.0f;
+
+	/** Game thread time of the previous frame */
+	float GameThreadTimeMs = 0.0f;
+};
+
+/**
+ *  Records and plays back combat sessions so performance can be compared across identical runs.
+ *
+ *  Start the game with -CombatReplayRecord=<Name> to record, or -CombatReplayPlay=<Name> to play back.
+ *  Both run on a fixed time step (-CombatReplayFPS, defaults to 60). The session seed drives every
+ *  random stream handed out through MakeSeed, and the player character's inputs are written to a
+ *  compact binary stream stamped with the frame they happened on. Playback replaces live input with
+ *  the recorded stream, writes per-frame timings to a CSV next to the replay, then exits.
+ */
+UCLASS()
+class UCombatReplaySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Current mode */
+	ECombatReplayMode Mode = ECombatReplayMode::Idle;
+
+	/** Name of the replay file, without extension */
+	FString ReplayName;
+
+	/** Session seed */
+	int32 Seed = 0;
+
+	/** Stream used to hand out deterministic seeds */
+	FRandomStream SeedStream;
+
+	/** Fixed frame rate used while recording or playing back */
+	float FixedFrameRate = 60.0f;
+
+	/** If set, recording stops after this many seconds */
+	float RecordDuration = 0.0f;
+
+	/** Current frame, counted from the start of play */
+	int32 FrameIndex = -1;
+
+	/** Frame of the last event written or read */
+	int32 LastEventFrame = 0;
+
+	/** Total number of recorded frames, read from the replay header during playback */
+	int32 NumFrames = 0;
+
+	/** Number of input events recorded or played back */
+	int32 NumEvents = 0;
+
+	/** Encoded input events */
+	TArray<uint8> Stream;
+
+	/** Writer or reader over the input events */
+	TUniquePtr<FArchive> StreamArchive;
+
+	/** Frame of the next event to play back, or INDEX_NONE at the end of the stream */
+	int32 NextEventFrame = INDEX_NONE;
+
+	/** Last axis values recorded or played back for each input, used to skip repeated values */
+	FVector2f LastValues[static_cast<int32>(ECombatReplayInput::Count)];
+
+	/** If true, we're feeding recorded input to the character, so it shouldn't be swallowed */
+	bool bInjectingInput = false;
+
+	/** Per-frame timings */
+	TArray<FCombatReplayFrame> Frames;
+
+	/** Time the current frame started */
+	double LastFrameStartTime = 0.0;
+
+	/** Tick function that advances the frame counter and injects recorded input */
+	FGameWorldTickFunction FrameTickFunction;
+
+	/** Player controller whose tick waits for the frame step */
+	TWeakObjectPtr<APlayerController> OrderedPlayerController;
+
+	/** If true, we've overridden the engine's fixed time step and need to put it back */
+	bool bOverrodeFixedTimeStep = false;
+
+	/** Fixed time step setting before we overrode it */
+	bool bPreviousUseFixedTimeStep = false;
+
+	/** Fixed delta time before we overrode it */
+	double PreviousFixedDeltaTime = 0.0;
+
+public:
+
+	/** Returns the current mode */
+	ECombatReplayMode GetMode() const { return Mode; }
+
+	/** Returns the current frame */
+	int32 GetFrameIndex() const { return FrameIndex; }
+
+	/** Returns a seed for a random stream. Deterministic while recording or playing back */
+	int32 NextSeed();
+
+	/** Returns a seed from the world's replay subsystem, or a random one if there's no subsystem */
+	static int32 MakeSeed(const UObject* WorldContextObject);
+
+	/** Records a player input, if recording. Returns false if live input should be ignored because a replay is playing */
+	static bool ProcessInput(ACombatCharacter* Character, ECombatReplayInput Input, const FVector2D& Value = FVector2D::ZeroVector);
+
+	/** Stops recording and writes the replay to disk */
+	void StopRecording();
+
+	/** Writes the current state to the log */
+	void DumpStats() const;
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Reads the command line, sets up the seed and time step and starts recording or playback */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Saves any recording in progress and restores the engine time step */
+	virtual void Deinitialize() override;
+
+	/** Advances the frame and injects recorded input */
+	void StepFrame(float DeltaTime);
+
+	/** Makes the player controller's tick wait for the frame step, so input is stamped and injected before it's processed */
+	void OrderBeforePlayerController();
+
+	/** Encodes one input event */
+	void RecordInput(ECombatReplayInput Input, const FVector2D& Value);
+
+	/** Loads a replay file. Returns false if it can't be read */
+	bool LoadReplay(const FString& FilePath);
+
+	/** Reads the frame of the next event */
+	void ReadNextEventFrame();
+
+	/** Plays back every event for the current frame */
+	void InjectFrameInput();
+
+	/** Finishes playback, writes the timings and exits */
+	void FinishPlayback();
+
+	/** Writes the frame timings to a CSV file */
+	void WriteFrameCSV(const FString& FilePath) const;
+
+	/** Returns the path of the replay file */
+	FString GetReplayPath() const;
+
+	/** Returns the first local player's combat character */
+	ACombatCharacter* GetPlayerCharacter() const;
+};
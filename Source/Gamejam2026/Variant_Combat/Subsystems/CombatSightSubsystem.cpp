@@ -0,0 +1,280 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatSightSubsystem.h"
+#include "CombatStats.h"
+#include "CombatEnemy.h"
+#include "CombatSignificanceSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "CollisionQueryParams.h"
+#include "Algo/Sort.h"
+#include "HAL/IConsoleManager.h"
+#include "Gamejam2026.h"
+
+static int32 GCombatSightBudget = 8;
+static FAutoConsoleVariableRef CVarCombatSightBudget(
+	TEXT("Combat.Sight.Budget"),
+	GCombatSightBudget,
+	TEXT("Maximum number of line of sight traces issued each frame"),
+	ECVF_Default
+);
+
+static float GCombatSightRefreshTime = 0.2f;
+static FAutoConsoleVariableRef CVarCombatSightRefreshTime(
+	TEXT("Combat.Sight.RefreshTime"),
+	GCombatSightRefreshTime,
+	TEXT("Age a line of sight result has to reach before it's traced again, in seconds"),
+	ECVF_Default
+);
+
+static float GCombatSightTimeToLive = 1.0f;
+static FAutoConsoleVariableRef CVarCombatSightTimeToLive(
+	TEXT("Combat.Sight.TimeToLive"),
+	GCombatSightTimeToLive,
+	TEXT("Age after which a line of sight result is no longer returned to queries, in seconds"),
+	ECVF_Default
+);
+
+static float GCombatSightForgetTime = 2.0f;
+static FAutoConsoleVariableRef CVarCombatSightForgetTime(
+	TEXT("Combat.Sight.ForgetTime"),
+	GCombatSightForgetTime,
+	TEXT("Entries that haven't been queried for this long are dropped, in seconds"),
+	ECVF_Default
+);
+
+static float GCombatSightDistanceFalloff = 2000.0f;
+static FAutoConsoleVariableRef CVarCombatSightDistanceFalloff(
+	TEXT("Combat.Sight.DistanceFalloff"),
+	GCombatSightDistanceFalloff,
+	TEXT("Distance at which a viewer's refresh priority is halved, in cm"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithWorld CombatSightStatsCommand(
+	TEXT("Combat.Sight.Stats"),
+	TEXT("Logs the line of sight cache hit rate and trace budget use"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UCombatSightSubsystem* Sight = World ? World->GetSubsystem<UCombatSightSubsystem>() : nullptr)
+		{
+			Sight->DumpStats();
+		}
+	})
+);
+
+namespace
+{
+	/** Refresh priority multiplier for each significance bucket */
+	constexpr float SignificanceWeights[static_cast<int32>(ECombatSignificance::Count)] = { 4.0f, 2.0f, 1.0f, 0.5f };
+
+	/** Priority bonus for entries that have never been traced, so new viewers get an answer quickly */
+	constexpr float NoResultPriority = 100.0f;
+
+	/** Returns the location the actor looks from */
+	FVector GetViewLocation(const AActor* Actor)
+	{
+		const APawn* Pawn = Cast<APawn>(Actor);
+		return Pawn ? Pawn->GetPawnViewLocation() : Actor->GetActorLocation();
+	}
+}
+
+bool UCombatSightSubsystem::QueryLineOfSight(AActor* Viewer, AActor* Target, bool& bOutHasLineOfSight)
+{
+	if (!Viewer || !Target)
+	{
+		return false;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	FCombatSightEntry& Entry = Entries.FindOrAdd(FCombatSightKey(Viewer, Target));
+	Entry.LastQueryTime = Now;
+
+	// fill in new entries
+	if (!Entry.Viewer.IsValid())
+	{
+		Entry.Viewer = Viewer;
+		Entry.Target = Target;
+	}
+
+	// is the result still alive?
+	if (!Entry.bHasResult || Now - Entry.ResultTime > GCombatSightTimeToLive)
+	{
+		++Stats.Misses;
+		return false;
+	}
+
+	++Stats.Hits;
+
+	bOutHasLineOfSight = Entry.bHasLineOfSight;
+	return true;
+}
+
+void UCombatSightSubsystem::ForgetViewer(const AActor* Viewer)
+{
+	const TObjectKey<AActor> ViewerKey(Viewer);
+
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Key == ViewerKey)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UCombatSightSubsystem::DumpStats() const
+{
+	const int32 Queries = Stats.Hits + Stats.Misses;
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat sight: %d viewer/target pairs, %d traces last frame, %d deferred, oldest refresh %.2f s"),
+		Stats.Entries, Stats.TracesLastFrame, Stats.Deferred, Stats.OldestRefreshAge);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat sight: %d queries, %.1f%% answered from cache, %d traces total"),
+		Queries, Queries > 0 ? 100.0f * Stats.Hits / Queries : 0.0f, Stats.TotalTraces);
+}
+
+bool UCombatSightSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatSightSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// collect last frame's traces and issue new ones before the AI ticks
+	UpdateTickFunction.OnTick.BindUObject(this, &UCombatSightSubsystem::UpdateSight);
+	UpdateTickFunction.Register(&InWorld, TG_PrePhysics, true, TEXT("CombatSight"));
+}
+
+void UCombatSightSubsystem::Deinitialize()
+{
+	UpdateTickFunction.Unregister();
+
+	Entries.Empty();
+	Candidates.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatSightSubsystem::UpdateSight(float DeltaTime)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(LineOfSight);
+
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+
+	Candidates.Reset();
+
+	FTraceDatum TraceDatum;
+
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		FCombatSightEntry& Entry = It.Value();
+
+		const AActor* Viewer = Entry.Viewer.Get();
+		const AActor* Target = Entry.Target.Get();
+
+		// drop entries nobody is asking about anymore
+		if (!Viewer || !Target || Now - Entry.LastQueryTime > GCombatSightForgetTime)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// collect the result of the trace in flight
+		if (Entry.TraceHandle.IsValid())
+		{
+			if (World->QueryTraceData(Entry.TraceHandle, TraceDatum))
+			{
+				// test traces only report a hit when something blocked the line
+				Entry.bHasLineOfSight = TraceDatum.OutHits.IsEmpty();
+				Entry.bHasResult = true;
+				Entry.ResultTime = Now;
+				Entry.TraceHandle = FTraceHandle();
+			}
+			else if (!World->IsTraceHandleValid(Entry.TraceHandle, false))
+			{
+				// the results have expired, so trace again
+				Entry.TraceHandle = FTraceHandle();
+			}
+			else
+			{
+				continue;
+			}
+		}
+
+		// queue a refresh once the result is old enough
+		if (!Entry.bHasResult || Now - Entry.ResultTime >= GCombatSightRefreshTime)
+		{
+			Candidates.Emplace(GetPriority(Entry, Viewer, Target, Now), It.Key());
+		}
+	}
+
+	// issue the highest priority traces within the budget
+	const int32 NumTraces = FMath::Min(Candidates.Num(), FMath::Max(GCombatSightBudget, 0));
+
+	if (NumTraces < Candidates.Num())
+	{
+		Algo::Sort(Candidates, [](const TPair<float, FCombatSightKey>& A, const TPair<float, FCombatSightKey>& B)
+		{
+			return A.Key > B.Key;
+		});
+	}
+
+	Stats.OldestRefreshAge = 0.0f;
+
+	for (int32 Index = 0; Index < NumTraces; ++Index)
+	{
+		FCombatSightEntry& Entry = Entries.FindChecked(Candidates[Index].Value);
+
+		const AActor* Viewer = Entry.Viewer.Get();
+		const AActor* Target = Entry.Target.Get();
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatSight), false, Viewer);
+		QueryParams.AddIgnoredActor(Target);
+
+		Entry.TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Test, GetViewLocation(Viewer), Target->GetActorLocation(), ECC_Visibility, QueryParams);
+
+		if (Entry.bHasResult)
+		{
+			Stats.OldestRefreshAge = FMath::Max(Stats.OldestRefreshAge, static_cast<float>(Now - Entry.ResultTime));
+		}
+	}
+
+	COMBAT_INC_COUNTER(TracesPerFrame, NumTraces);
+
+	Stats.Entries = Entries.Num();
+	Stats.TracesLastFrame = NumTraces;
+	Stats.Deferred = Candidates.Num() - NumTraces;
+	Stats.TotalTraces += NumTraces;
+}
+
+float UCombatSightSubsystem::GetPriority(const FCombatSightEntry& Entry, const AActor* Viewer, const AActor* Target, double Now) const
+{
+	if (!Entry.bHasResult)
+	{
+		return NoResultPriority;
+	}
+
+	// staler results first
+	float Priority = (Now - Entry.ResultTime) / FMath::Max(GCombatSightRefreshTime, UE_KINDA_SMALL_NUMBER);
+
+	// favor the enemies that matter most to the player
+	if (const ACombatEnemy* Enemy = Cast<ACombatEnemy>(Viewer))
+	{
+		if (const UCombatSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UCombatSignificanceSubsystem>())
+		{
+			Priority *= SignificanceWeights[static_cast<int32>(Significance->GetSignificance(Enemy))];
+		}
+	}
+
+	// and the ones closer to their target
+	const float Distance = FVector::Dist(Viewer->GetActorLocation(), Target->GetActorLocation());
+	Priority /= 1.0f + Distance / FMath::Max(GCombatSightDistanceFalloff, 1.0f);
+
+	return Priority;
+}
@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "UObject/ObjectKey.h"
+#include "GameWorldTickFunction.h"
+#include "CombatSightSubsystem.generated.h"
+
+/** Identifies a cached line of sight by viewer and target */
+using FCombatSightKey = TPair<TObjectKey<AActor>, TObjectKey<AActor>>;
+
+/**
+ *  Cached line of sight from a viewer to a target
+ */
+struct FCombatSightEntry
+{
+	/** Actor doing the looking */
+	TWeakObjectPtr<AActor> Viewer;
+
+	/** Actor being looked at */
+	TWeakObjectPtr<AActor> Target;
+
+	/** Handle to the async trace in flight for this entry, if any */
+	FTraceHandle TraceHandle;
+
+	/** Game time of the last trace result */
+	double ResultTime = 0.0;
+
+	/** Game time the entry was last queried */
+	double LastQueryTime = 0.0;
+
+	/** If true, the last trace wasn't blocked */
+	bool bHasLineOfSight = false;
+
+	/** If true, at least one trace has completed for this pair */
+	bool bHasResult = false;
+};
+
+/**
+ *  Running statistics for the line of sight service
+ */
+USTRUCT(BlueprintType)
+struct FCombatSightStats
+{
+	GENERATED_BODY()
+
+	/** Number of cached viewer and target pairs */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Sight")
+	int32 Entries = 0;
+
+	/** Traces issued last frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Sight")
+	int32 TracesLastFrame = 0;
+
+	/** Stale entries left waiting for budget last frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Sight")
+	int32 Deferred = 0;
+
+	/** Total traces issued */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Sight")
+	int32 TotalTraces = 0;
+
+	/** Total queries answered from a live result */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Sight")
+	int32 Hits = 0;
+
+	/** Total queries with no live result */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Sight")
+	int32 Misses = 0;
+
+	/** Age of the oldest result refreshed last frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Sight", meta = (Units = "s"))
+	float OldestRefreshAge = 0.0f;
+};
+
+/**
+ *  Answers line of sight queries for combat AI from a cache, refreshed by a fixed number of async traces per frame.
+ *  Stale entries are refreshed in priority order, weighted by how stale they are, the viewer's significance
+ *  and its distance to the target. Entries nobody has queried for a while are dropped.
+ */
+UCLASS()
+class UCombatSightSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Cached line of sight, one entry per viewer and target pair, so a viewer can track several targets at once */
+	TMap<FCombatSightKey, FCombatSightEntry> Entries;
+
+	/** Scratch list of refresh candidates and their priority, reused every frame */
+	TArray<TPair<float, FCombatSightKey>> Candidates;
+
+	/** Tick function that collects trace results and issues new traces */
+	FGameWorldTickFunction UpdateTickFunction;
+
+	/** Statistics */
+	FCombatSightStats Stats;
+
+public:
+
+	/**
+	 *  Looks up the cached line of sight from the viewer to the target and keeps it scheduled for refresh.
+	 *  Returns false if there's no result younger than the time to live yet.
+	 */
+	bool QueryLineOfSight(AActor* Viewer, AActor* Target, bool& bOutHasLineOfSight);
+
+	/** Drops the cached entries for the viewer, for every target */
+	void ForgetViewer(const AActor* Viewer);
+
+	/** Returns the statistics */
+	const FCombatSightStats& GetStats() const { return Stats; }
+
+	/** Writes the statistics to the log */
+	void DumpStats() const;
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the update tick function */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Collects finished traces, drops unused entries and issues the highest priority refreshes within the budget */
+	void UpdateSight(float DeltaTime);
+
+	/** Returns the refresh priority for a stale entry */
+	float GetPriority(const FCombatSightEntry& Entry, const AActor* Viewer, const AActor* Target, double Now) const;
+};
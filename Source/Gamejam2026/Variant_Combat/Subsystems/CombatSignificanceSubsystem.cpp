@@ -0,0 +1,403 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatSignificanceSubsystem.h"
+#include "CombatSpatialSubsystem.h"
+#include "CombatEnemy.h"
+#include "PlayerSnapshotSubsystem.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Gamejam2026.h"
+
+static bool GCombatSignificanceEnabled = true;
+static FAutoConsoleVariableRef CVarCombatSignificanceEnabled(
+	TEXT("Combat.Significance.Enabled"),
+	GCombatSignificanceEnabled,
+	TEXT("If false, all combat enemies update at full rate"),
+	ECVF_Default
+);
+
+static float GCombatSignificanceHysteresis = 200.0f;
+static FAutoConsoleVariableRef CVarCombatSignificanceHysteresis(
+	TEXT("Combat.Significance.Hysteresis"),
+	GCombatSignificanceHysteresis,
+	TEXT("Distance an enemy must move past a bucket threshold before changing buckets, in cm"),
+	ECVF_Default
+);
+
+static float GCombatSignificanceInterval = 0.2f;
+static FAutoConsoleVariableRef CVarCombatSignificanceInterval(
+	TEXT("Combat.Significance.Interval"),
+	GCombatSignificanceInterval,
+	TEXT("Time between significance evaluations, in seconds"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithWorld CombatSignificanceStatsCommand(
+	TEXT("Combat.Significance.Stats"),
+	TEXT("Logs the number of combat enemies in each significance bucket, the ticks skipped and the last measured game thread times"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UCombatSignificanceSubsystem* Significance = World ? World->GetSubsystem<UCombatSignificanceSubsystem>() : nullptr)
+		{
+			Significance->DumpStats();
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorldAndArgs CombatSignificanceMeasureCommand(
+	TEXT("Combat.Significance.Measure"),
+	TEXT("Measures the game thread time with significance throttling on, then with every enemy at full rate. Usage: Combat.Significance.Measure [Frames]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UCombatSignificanceSubsystem* Significance = World ? World->GetSubsystem<UCombatSignificanceSubsystem>() : nullptr)
+		{
+			Significance->StartMeasurement(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 300);
+		}
+	})
+);
+
+namespace
+{
+	/** Frames to wait after switching update rates before sampling, so the new tick intervals have kicked in */
+	constexpr int32 MeasureSettleFrames = 60;
+
+	/** Returns the fraction of per-frame ticks skipped when ticking at the given interval */
+	float GetSkippedTickFraction(float TickInterval, float FrameTime)
+	{
+		return TickInterval > FrameTime ? 1.0f - (FrameTime / TickInterval) : 0.0f;
+	}
+
+	/** Builds a significance bucket */
+	FCombatSignificanceBucket MakeBucket(float MaxDistance, float ActorTickInterval, float StateTreeTickInterval, float MovementTickInterval, int32 AnimFrameSkip)
+	{
+		FCombatSignificanceBucket Bucket;
+		Bucket.MaxDistance = MaxDistance;
+		Bucket.ActorTickInterval = ActorTickInterval;
+		Bucket.StateTreeTickInterval = StateTreeTickInterval;
+		Bucket.MovementTickInterval = MovementTickInterval;
+		Bucket.AnimFrameSkip = AnimFrameSkip;
+		return Bucket;
+	}
+}
+
+ECombatSignificance UCombatSignificanceSubsystem::GetSignificance(const ACombatEnemy* Enemy) const
+{
+	const ECombatSignificance* Bucket = EnemyBuckets.Find(Enemy);
+	return Bucket ? *Bucket : ECombatSignificance::High;
+}
+
+void UCombatSignificanceSubsystem::DumpStats() const
+{
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat significance: %d high, %d medium, %d low, %d minimal (%d changes last pass, %.3f ms)"),
+		Stats.BucketCounts[0], Stats.BucketCounts[1], Stats.BucketCounts[2], Stats.BucketCounts[3], Stats.BucketChanges, Stats.EvaluationTimeMs);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat significance: ~%.0f ticks skipped per second, based on the bucket tick intervals"),
+		Stats.TicksSkippedPerSecond);
+
+	// only report time saved when it was actually measured
+	if (Stats.MeasuredFullRateMs > 0.0f)
+	{
+		UE_LOG(LogGamejam2026, Log, TEXT("Combat significance: measured game thread %.3f ms throttled, %.3f ms at full rate (%.3f ms saved)"),
+			Stats.MeasuredThrottledMs, Stats.MeasuredFullRateMs, Stats.MeasuredFullRateMs - Stats.MeasuredThrottledMs);
+
+	} else {
+
+		UE_LOG(LogGamejam2026, Log, TEXT("Combat significance: no time measurement yet, run Combat.Significance.Measure"));
+	}
+}
+
+void UCombatSignificanceSubsystem::StartMeasurement(int32 Frames)
+{
+	// ignore the request if we're already measuring
+	if (MeasureFrames > 0 || !MeasureTickFunction.IsTickFunctionRegistered())
+	{
+		return;
+	}
+
+	MeasureFrames = FMath::Max(Frames, 1);
+	MeasureFrameIndex = -MeasureSettleFrames;
+	MeasureAccumulatedMs = 0.0;
+
+	// start with throttling, and apply it right away instead of waiting for the next evaluation
+	bForceFullRate = false;
+	Evaluate(0.0f);
+
+	MeasureTickFunction.SetTickFunctionEnable(true);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat significance: measuring %d frames throttled, then %d frames at full rate"), MeasureFrames, MeasureFrames);
+}
+
+void UCombatSignificanceSubsystem::ReleaseEnemy(ACombatEnemy* Enemy)
+{
+	if (Enemy && EnemyBuckets.Remove(Enemy) > 0)
+	{
+		RestoreDefaults(Enemy);
+	}
+}
+
+void UCombatSignificanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// set up the default buckets, from most to least significant
+	Buckets.Reset(static_cast<int32>(ECombatSignificance::Count));
+
+	Buckets.Add(MakeBucket(1500.0f, 0.0f, 0.0f, 0.0f, 0));
+	Buckets.Add(MakeBucket(3000.0f, 0.0f, 0.1f, 0.0f, 1));
+	Buckets.Add(MakeBucket(6000.0f, 0.1f, 0.25f, 0.05f, 3));
+	Buckets.Add(MakeBucket(MAX_flt, 0.25f, 0.5f, 0.1f, 7));
+}
+
+bool UCombatSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatSignificanceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// evaluate a few times per second, after the spatial index has refreshed enemy locations
+	EvaluateTickFunction.TickInterval = GCombatSignificanceInterval;
+	EvaluateTickFunction.OnTick.BindUObject(this, &UCombatSignificanceSubsystem::Evaluate);
+	EvaluateTickFunction.Register(&InWorld, TG_PrePhysics, false, TEXT("CombatSignificance"));
+
+	// only ticks while a measurement is running
+	MeasureTickFunction.OnTick.BindUObject(this, &UCombatSignificanceSubsystem::SampleMeasurement);
+	MeasureTickFunction.Register(&InWorld, TG_PrePhysics, false, TEXT("CombatSignificanceMeasure"));
+	MeasureTickFunction.SetTickFunctionEnable(false);
+}
+
+void UCombatSignificanceSubsystem::Deinitialize()
+{
+	EvaluateTickFunction.Unregister();
+	MeasureTickFunction.Unregister();
+
+	EnemyBuckets.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatSignificanceSubsystem::Evaluate(float DeltaTime)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// pick up interval changes from the console
+	EvaluateTickFunction.UpdateTickIntervalAndCoolDown(GCombatSignificanceInterval);
+
+	const UCombatSpatialSubsystem* Spatial = GetWorld()->GetSubsystem<UCombatSpatialSubsystem>();
+	const FPlayerSnapshot* PlayerSnapshot = UPlayerSnapshotSubsystem::Get(this);
+
+	if (!Spatial || !PlayerSnapshot)
+	{
+		return;
+	}
+
+	FCombatSignificanceStats NewStats;
+
+	const TArray<TObjectPtr<ACombatEnemy>>& Enemies = Spatial->GetEnemies();
+	const TArray<FVector>& Locations = Spatial->GetEnemyLocations();
+
+	TMap<TObjectKey<ACombatEnemy>, ECombatSignificance> NewEnemyBuckets;
+	NewEnemyBuckets.Reserve(Enemies.Num());
+
+	const float FrameTime = FMath::Max(GetWorld()->GetDeltaSeconds(), UE_KINDA_SMALL_NUMBER);
+
+	for (int32 Slot = 0; Slot < Enemies.Num(); ++Slot)
+	{
+		ACombatEnemy* Enemy = Enemies[Slot];
+
+		if (!IsValid(Enemy))
+		{
+			continue;
+		}
+
+		const ECombatSignificance* PreviousBucket = EnemyBuckets.Find(Enemy);
+		const ECombatSignificance CurrentBucket = PreviousBucket ? *PreviousBucket : ECombatSignificance::High;
+
+		// choose the new bucket
+		ECombatSignificance NewBucket = ECombatSignificance::High;
+
+		if (GCombatSignificanceEnabled && !bForceFullRate && PlayerSnapshot->IsValid())
+		{
+			const float Distance = FVector::Dist(Locations[Slot], PlayerSnapshot->Location);
+			NewBucket = ChooseBucket(Distance, Enemy->GetMesh()->WasRecentlyRendered(0.5f), CurrentBucket);
+		}
+
+		// only touch the components when the bucket changes, or the first time we see this enemy
+		if (!PreviousBucket || NewBucket != CurrentBucket)
+		{
+			ApplyBucket(Enemy, NewBucket);
+			++NewStats.BucketChanges;
+		}
+
+		NewEnemyBuckets.Add(Enemy, NewBucket);
+		++NewStats.BucketCounts[static_cast<int32>(NewBucket)];
+
+		// count the ticks we're skipping. Their cost is only known from a measurement
+		const FCombatSignificanceBucket& Settings = Buckets[static_cast<int32>(NewBucket)];
+
+		const float SkippedActor = GetSkippedTickFraction(Settings.ActorTickInterval, FrameTime);
+		const float SkippedStateTree = GetSkippedTickFraction(Settings.StateTreeTickInterval, FrameTime);
+		const float SkippedMovement = GetSkippedTickFraction(Settings.MovementTickInterval, FrameTime);
+		const float SkippedAnim = static_cast<float>(Settings.AnimFrameSkip) / static_cast<float>(Settings.AnimFrameSkip + 1);
+
+		NewStats.TicksSkippedPerSecond += (SkippedActor + SkippedStateTree + SkippedMovement + SkippedAnim) / FrameTime;
+	}
+
+	// enemies that are no longer indexed are dropped here
+	EnemyBuckets = MoveTemp(NewEnemyBuckets);
+
+	// keep the last measurement around
+	NewStats.MeasuredThrottledMs = Stats.MeasuredThrottledMs;
+	NewStats.MeasuredFullRateMs = Stats.MeasuredFullRateMs;
+	NewStats.EvaluationTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	Stats = NewStats;
+}
+
+ECombatSignificance UCombatSignificanceSubsystem::ChooseBucket(float Distance, bool bRecentlyRendered, ECombatSignificance CurrentBucket) const
+{
+	const int32 Current = static_cast<int32>(CurrentBucket);
+
+	// find the raw bucket for this distance
+	int32 Raw = 0;
+
+	while (Raw < Buckets.Num() - 1 && Distance > Buckets[Raw].MaxDistance)
+	{
+		++Raw;
+	}
+
+	// only demote once we're clearly past the current bucket's threshold
+	if (Raw > Current && Distance < Buckets[Current].MaxDistance + GCombatSignificanceHysteresis)
+	{
+		Raw = Current;
+	}
+
+	// only promote once we're clearly inside the new bucket's threshold
+	if (Raw < Current && Distance > Buckets[Raw].MaxDistance - GCombatSignificanceHysteresis)
+	{
+		Raw = FMath::Min(Raw + 1, Current);
+	}
+
+	// enemies the player can't see drop one bucket.
+	// The recently rendered check already has its own time window so this doesn't flap
+	if (!bRecentlyRendered)
+	{
+		Raw = FMath::Min(Raw + 1, Buckets.Num() - 1);
+	}
+
+	return static_cast<ECombatSignificance>(Raw);
+}
+
+void UCombatSignificanceSubsystem::ApplyBucket(ACombatEnemy* Enemy, ECombatSignificance Bucket) const
+{
+	const FCombatSignificanceBucket& Settings = Buckets[static_cast<int32>(Bucket)];
+
+	// actor tick
+	Enemy->SetActorTickInterval(Settings.ActorTickInterval);
+
+	// character movement
+	Enemy->GetCharacterMovement()->SetComponentTickInterval(Settings.MovementTickInterval);
+
+	// StateTree
+	if (AAIController* AIController = Cast<AAIController>(Enemy->GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->SetComponentTickInterval(Settings.StateTreeTickInterval);
+		}
+	}
+
+	// animation update rate. Use the same frame skip for every LOD
+	USkeletalMeshComponent* Mesh = Enemy->GetMesh();
+
+	if (Mesh->bEnableUpdateRateOptimizations && Mesh->AnimUpdateRateParams)
+	{
+		FAnimUpdateRateParameters* UpdateRateParams = Mesh->AnimUpdateRateParams;
+		UpdateRateParams->bShouldUseLodMap = true;
+		UpdateRateParams->LODToFrameSkipMap.Reset();
+
+		for (int32 LODIndex = 0; LODIndex < FMath::Max(Mesh->GetNumLODs(), 1); ++LODIndex)
+		{
+			UpdateRateParams->LODToFrameSkipMap.Add(LODIndex, Settings.AnimFrameSkip);
+		}
+	}
+}
+
+void UCombatSignificanceSubsystem::RestoreDefaults(ACombatEnemy* Enemy) const
+{
+	// actor tick
+	Enemy->SetActorTickInterval(Enemy->GetClass()->GetDefaultObject<ACombatEnemy>()->PrimaryActorTick.TickInterval);
+
+	// character movement
+	UCharacterMovementComponent* Movement = Enemy->GetCharacterMovement();
+	Movement->SetComponentTickInterval(CastChecked<UActorComponent>(Movement->GetArchetype())->PrimaryComponentTick.TickInterval);
+
+	// StateTree
+	if (AAIController* AIController = Cast<AAIController>(Enemy->GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->SetComponentTickInterval(CastChecked<UActorComponent>(Brain->GetArchetype())->PrimaryComponentTick.TickInterval);
+		}
+	}
+
+	// animation update rate
+	USkeletalMeshComponent* Mesh = Enemy->GetMesh();
+
+	if (Mesh->AnimUpdateRateParams)
+	{
+		Mesh->AnimUpdateRateParams->bShouldUseLodMap = false;
+		Mesh->AnimUpdateRateParams->LODToFrameSkipMap.Reset();
+	}
+}
+
+void UCombatSignificanceSubsystem::SampleMeasurement(float DeltaTime)
+{
+	// give the new update rates time to settle before sampling
+	if (MeasureFrameIndex++ < 0)
+	{
+		return;
+	}
+
+	// GGameThreadTime holds the previous frame's game thread time
+	MeasureAccumulatedMs += FPlatformTime::ToMilliseconds(GGameThreadTime);
+
+	if (MeasureFrameIndex < MeasureFrames)
+	{
+		return;
+	}
+
+	const float AverageMs = static_cast<float>(MeasureAccumulatedMs / MeasureFrames);
+
+	MeasureFrameIndex = -MeasureSettleFrames;
+	MeasureAccumulatedMs = 0.0;
+
+	if (!bForceFullRate)
+	{
+		// throttled half done, run the same number of frames at full rate
+		Stats.MeasuredThrottledMs = AverageMs;
+
+		bForceFullRate = true;
+		Evaluate(0.0f);
+		return;
+	}
+
+	Stats.MeasuredFullRateMs = AverageMs;
+
+	// go back to normal throttling
+	bForceFullRate = false;
+	Evaluate(0.0f);
+
+	MeasureFrames = 0;
+	MeasureTickFunction.SetTickFunctionEnable(false);
+
+	DumpStats();
+}
@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GameWorldTickFunction.h"
+#include "CombatSignificanceSubsystem.generated.h"
+
+class ACombatEnemy;
+
+/**
+ *  Significance buckets for combat enemies, from most to least relevant to the player
+ */
+UENUM(BlueprintType)
+enum class ECombatSignificance : uint8
+{
+	High,
+	Medium,
+	Low,
+	Minimal,
+	Count UMETA(Hidden)
+};
+
+/**
+ *  Update rates applied to enemies in a significance bucket
+ */
+USTRUCT(BlueprintType)
+struct FCombatSignificanceBucket
+{
+	GENERATED_BODY()
+
+	/** Enemies closer than this distance to the player can be placed in this bucket */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Significance", meta = (Units = "cm"))
+	float MaxDistance = 0.0f;
+
+	/** Actor tick interval. Zero ticks every frame */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Significance", meta = (Units = "s"))
+	float ActorTickInterval = 0.0f;
+
+	/** StateTree component tick interval */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Significance", meta = (Units = "s"))
+	float StateTreeTickInterval = 0.0f;
+
+	/** Character movement component tick interval */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Significance", meta = (Units = "s"))
+	float MovementTickInterval = 0.0f;
+
+	/** Number of frames animation update rate optimization will skip between updates */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Significance")
+	int32 AnimFrameSkip = 0;
+};
+
+/**
+ *  Running statistics for the significance manager
+ */
+USTRUCT(BlueprintType)
+struct FCombatSignificanceStats
+{
+	GENERATED_BODY()
+
+	/** Number of enemies in each bucket after the last evaluation */
+	int32 BucketCounts[static_cast<int32>(ECombatSignificance::Count)] = {};
+
+	/** Number of bucket changes during the last evaluation */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Significance")
+	int32 BucketChanges = 0;
+
+	/** Estimated number of actor, StateTree, movement and animation ticks skipped per second */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Significance")
+	float TicksSkippedPerSecond = 0.0f;
+
+	/** Measured average game thread time with significance throttling, from the last Combat.Significance.Measure run */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Significance", meta = (Units = "ms"))
+	float MeasuredThrottledMs = 0.0f;
+
+	/** Measured average game thread time with every enemy at full rate, from the last Combat.Significance.Measure run */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Significance", meta = (Units = "ms"))
+	float MeasuredFullRateMs = 0.0f;
+
+	/** Time spent in the last evaluation */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Significance", meta = (Units = "ms"))
+	float EvaluationTimeMs = 0.0f;
+};
+
+/**
+ *  Buckets living combat enemies by distance and visibility to the player
+ *  and scales their actor, StateTree, movement and animation update rates per bucket.
+ *  Distance thresholds use a hysteresis margin so enemies don't flap between buckets.
+ */
+UCLASS()
+class UCombatSignificanceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Update rates for each bucket */
+	UPROPERTY()
+	TArray<FCombatSignificanceBucket> Buckets;
+
+	/** Current bucket for each evaluated enemy */
+	TMap<TObjectKey<ACombatEnemy>, ECombatSignificance> EnemyBuckets;
+
+	/** Tick function that runs the evaluation */
+	FGameWorldTickFunction EvaluateTickFunction;
+
+	/** Statistics from the last evaluation */
+	FCombatSignificanceStats Stats;
+
+	/** Tick function that samples the game thread time while measuring */
+	FGameWorldTickFunction MeasureTickFunction;
+
+	/** Number of frames sampled in each half of the measurement */
+	int32 MeasureFrames = 0;
+
+	/** Frame index within the current half of the measurement. Negative while settling */
+	int32 MeasureFrameIndex = 0;
+
+	/** Game thread time accumulated in the current half of the measurement, in milliseconds */
+	double MeasureAccumulatedMs = 0.0;
+
+	/** If true, every enemy is kept at full rate regardless of the enabled cvar */
+	bool bForceFullRate = false;
+
+public:
+
+	/** Returns the statistics from the last evaluation */
+	const FCombatSignificanceStats& GetStats() const { return Stats; }
+
+	/** Returns the current bucket for the enemy */
+	ECombatSignificance GetSignificance(const ACombatEnemy* Enemy) const;
+
+	/** Writes the statistics to the log */
+	void DumpStats() const;
+
+	/**
+	 *  Measures the real game thread time with throttling on and then with every enemy at full rate,
+	 *  sampling the given number of frames for each. Results are logged and kept in the stats
+	 */
+	void StartMeasurement(int32 Frames);
+
+	/** Restores an enemy's default update rates and forgets its bucket. Called when the enemy is parked in the pool */
+	void ReleaseEnemy(ACombatEnemy* Enemy);
+
+protected:
+
+	/** Sets up the default buckets */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the evaluation tick function */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Re-buckets all living enemies and applies the update rates for any bucket changes */
+	void Evaluate(float DeltaTime);
+
+	/** Picks a bucket for an enemy based on its distance to the player and its current bucket */
+	ECombatSignificance ChooseBucket(float Distance, bool bRecentlyRendered, ECombatSignificance CurrentBucket) const;
+
+	/** Applies a bucket's update rates to an enemy */
+	void ApplyBucket(ACombatEnemy* Enemy, ECombatSignificance Bucket) const;
+
+	/** Puts the enemy's update rates back to its class defaults */
+	void RestoreDefaults(ACombatEnemy* Enemy) const;
+
+	/** Samples one frame of game thread time for the measurement */
+	void SampleMeasurement(float DeltaTime);
+};
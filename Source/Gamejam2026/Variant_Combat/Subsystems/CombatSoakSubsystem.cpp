@@ -0,0 +1,490 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatSoakSubsystem.h"
+#include "CombatCharacter.h"
+#include "CombatEnemy.h"
+#include "CombatEnemySpawner.h"
+#include "CombatSpatialSubsystem.h"
+#include "CombatCrowdSubsystem.h"
+#include "PlayerSnapshotSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Gamejam2026.h"
+
+namespace
+{
+	/**
+	 *  Column names for the timed tick phases. Each phase is bracketed by the world's actor tick delegates
+	 *  or its physics tick functions, since those are the only points the tick order guarantees.
+	 *  PrePhysics also covers the StartPhysics group up to the physics kick off, DuringPhysics covers the kick off,
+	 *  EndPhysics is the wait for the physics results and PostPhysics runs to the end of the actor tick
+	 */
+	const TCHAR* SoakTickGroupNames[CombatSoakNumTickGroups] =
+	{
+		TEXT("PrePhysics"),
+		TEXT("DuringPhysics"),
+		TEXT("EndPhysics"),
+		TEXT("PostPhysics")
+	};
+
+	/** Returns the given percentile of a sorted list of samples */
+	float GetPercentile(const TArray<float>& SortedSamples, float Percentile)
+	{
+		if (SortedSamples.Num() == 0)
+		{
+			return 0.0f;
+		}
+
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Percentile * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+		return SortedSamples[Index];
+	}
+
+	/** Adds the percentiles of a set of samples to a JSON object */
+	TSharedRef<FJsonObject> MakePercentiles(TArray<float> Samples)
+	{
+		Samples.Sort();
+
+		double Sum = 0.0;
+
+		for (const float Sample : Samples)
+		{
+			Sum += Sample;
+		}
+
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetNumberField(TEXT("avg"), Samples.Num() > 0 ? Sum / Samples.Num() : 0.0);
+		Object->SetNumberField(TEXT("p50"), GetPercentile(Samples, 0.50f));
+		Object->SetNumberField(TEXT("p90"), GetPercentile(Samples, 0.90f));
+		Object->SetNumberField(TEXT("p95"), GetPercentile(Samples, 0.95f));
+		Object->SetNumberField(TEXT("p99"), GetPercentile(Samples, 0.99f));
+		Object->SetNumberField(TEXT("max"), Samples.Num() > 0 ? Samples.Last() : 0.0f);
+
+		return Object;
+	}
+}
+
+bool UCombatSoakSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && FParse::Param(FCommandLine::Get(), TEXT("CombatSoak"));
+}
+
+bool UCombatSoakSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatSoakSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// read the benchmark parameters
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FParse::Value(CommandLine, TEXT("CombatSoakSpawners="), NumSpawners);
+	FParse::Value(CommandLine, TEXT("CombatSoakEnemies="), EnemiesPerSpawner);
+	FParse::Value(CommandLine, TEXT("CombatSoakDuration="), Duration);
+	FParse::Value(CommandLine, TEXT("CombatSoakWarmup="), WarmupTime);
+	FParse::Value(CommandLine, TEXT("CombatSoakFPS="), FixedFrameRate);
+	FParse::Value(CommandLine, TEXT("CombatSoakRadius="), ArenaRadius);
+	bUseCrowd = FParse::Param(CommandLine, TEXT("CombatSoakCrowd"));
+
+	FixedFrameRate = FMath::Max(FixedFrameRate, 1.0f);
+
+	// simulate on a fixed time step so every run covers the same game time.
+	// This is global engine state, so remember the previous values to restore them when we're done
+	bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+	bOverrodeFixedTimeStep = true;
+
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / FixedFrameRate);
+
+	// the actor tick delegates bracket the whole frame
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UCombatSoakSubsystem::OnPreActorTick);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UCombatSoakSubsystem::OnPostActorTick);
+
+	// order within a tick group is undefined, so the boundaries in between are tied to the world's physics tick functions:
+	// the world's start physics waits for the first marker, the world's end physics waits for the second,
+	// and the third waits for the world's end physics
+	for (int32 i = 0; i < CombatSoakNumTickGroups - 1; ++i)
+	{
+		GroupMarkers[i].OnTick.BindUObject(this, &UCombatSoakSubsystem::OnGroupMarker, i + 1);
+	}
+
+	GroupMarkers[0].Register(&InWorld, TG_StartPhysics, true, TEXT("CombatSoakPhysicsStart"));
+	InWorld.StartPhysicsTickFunction.AddPrerequisite(this, GroupMarkers[0]);
+
+	GroupMarkers[1].Register(&InWorld, TG_EndPhysics, true, TEXT("CombatSoakPhysicsWait"));
+	InWorld.EndPhysicsTickFunction.AddPrerequisite(this, GroupMarkers[1]);
+
+	GroupMarkers[2].Register(&InWorld, TG_EndPhysics, true, TEXT("CombatSoakPhysicsEnd"));
+	GroupMarkers[2].AddPrerequisite(&InWorld, InWorld.EndPhysicsTickFunction);
+
+	Frames.Reserve(FMath::CeilToInt32((Duration + WarmupTime) * FixedFrameRate));
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat soak: %d spawners x %d enemies, %.0f s at %.0f fps%s"),
+		NumSpawners, EnemiesPerSpawner, Duration, FixedFrameRate, bUseCrowd ? TEXT(", crowd mode") : TEXT(""));
+}
+
+void UCombatSoakSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	// don't leave the world's physics tick functions waiting on markers that are going away
+	GetWorld()->StartPhysicsTickFunction.RemovePrerequisite(this, GroupMarkers[0]);
+	GetWorld()->EndPhysicsTickFunction.RemovePrerequisite(this, GroupMarkers[1]);
+
+	for (FGameWorldTickFunction& Marker : GroupMarkers)
+	{
+		Marker.Unregister();
+	}
+
+	// give the editor or the next world its own time step back
+	if (bOverrodeFixedTimeStep)
+	{
+		FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+		FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+		bOverrodeFixedTimeStep = false;
+	}
+
+	Super::Deinitialize();
+}
+
+void UCombatSoakSubsystem::OnPreActorTick(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+	// only time our own world while it's actually ticking
+	if (World != GetWorld() || TickType == LEVELTICK_ViewportsOnly || bFinished)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	// close out the previous frame
+	if (bArenaGenerated && ElapsedTime >= WarmupTime && LastFrameStartTime > 0.0)
+	{
+		FCombatSoakFrame& Frame = Frames.AddDefaulted_GetRef();
+		Frame.FrameTimeMs = static_cast<float>((Now - LastFrameStartTime) * 1000.0);
+		Frame.GameThreadTimeMs = static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+		for (int32 i = 0; i < CombatSoakNumTickGroups; ++i)
+		{
+			Frame.TickGroupTimeMs[i] = static_cast<float>(FMath::Max(MarkerTimes[i + 1] - MarkerTimes[i], 0.0) * 1000.0);
+		}
+
+		Frame.UsedPhysicalBytes = FPlatformMemory::GetStats().UsedPhysical;
+		PeakUsedPhysicalBytes = FMath::Max(PeakUsedPhysicalBytes, Frame.UsedPhysicalBytes);
+
+		if (const UCombatSpatialSubsystem* Spatial = GetWorld()->GetSubsystem<UCombatSpatialSubsystem>())
+		{
+			Frame.ActiveEnemies = Spatial->GetNumEnemies();
+		}
+
+		if (const UCombatCrowdSubsystem* Crowd = GetWorld()->GetSubsystem<UCombatCrowdSubsystem>())
+		{
+			Frame.CrowdEntities = Crowd->GetStats().Entities;
+		}
+	}
+
+	LastFrameStartTime = Now;
+
+	// run the benchmark before the time stamp, so it isn't counted against PrePhysics
+	StepBenchmark(DeltaTime);
+
+	MarkerTimes[0] = FPlatformTime::Seconds();
+}
+
+void UCombatSoakSubsystem::OnPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+	if (World == GetWorld() && TickType != LEVELTICK_ViewportsOnly)
+	{
+		MarkerTimes[CombatSoakNumTickGroups] = FPlatformTime::Seconds();
+	}
+}
+
+void UCombatSoakSubsystem::OnGroupMarker(float DeltaTime, int32 MarkerIndex)
+{
+	MarkerTimes[MarkerIndex] = FPlatformTime::Seconds();
+}
+
+void UCombatSoakSubsystem::StepBenchmark(float DeltaTime)
+{
+	// generate the arena once the player has spawned
+	if (!bArenaGenerated)
+	{
+		bArenaGenerated = GenerateArena();
+
+		// give up if the map never gives us a player
+		ElapsedTime += DeltaTime;
+
+		if (!bArenaGenerated && ElapsedTime > 30.0f)
+		{
+			UE_LOG(LogGamejam2026, Error, TEXT("Combat soak: no player character or spawner class found, aborting"));
+			FPlatformMisc::RequestExitWithStatus(false, 1);
+		}
+
+		if (bArenaGenerated)
+		{
+			ElapsedTime = 0.0f;
+		}
+
+		return;
+	}
+
+	ElapsedTime += DeltaTime;
+
+	// are we done?
+	if (ElapsedTime >= WarmupTime + Duration)
+	{
+		FinishBenchmark();
+		return;
+	}
+
+	DrivePlayer();
+}
+
+bool UCombatSoakSubsystem::GenerateArena()
+{
+	const FPlayerSnapshot* PlayerSnapshot = UPlayerSnapshotSubsystem::Get(this);
+
+	if (!PlayerSnapshot || !Cast<ACombatCharacter>(PlayerSnapshot->Pawn))
+	{
+		return false;
+	}
+
+	UWorld* World = GetWorld();
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	// resolve the spawner and enemy classes from the command line, or from a spawner placed in the map
+	TSubclassOf<ACombatEnemySpawner> SpawnerClass;
+	TSubclassOf<ACombatEnemy> EnemyClass;
+
+	FString ClassPath;
+
+	if (FParse::Value(CommandLine, TEXT("CombatSoakSpawnerClass="), ClassPath))
+	{
+		SpawnerClass = LoadClass<ACombatEnemySpawner>(nullptr, *ClassPath);
+	}
+
+	if (FParse::Value(CommandLine, TEXT("CombatSoakEnemyClass="), ClassPath))
+	{
+		EnemyClass = LoadClass<ACombatEnemy>(nullptr, *ClassPath);
+	}
+
+	for (TActorIterator<ACombatEnemySpawner> It(World); It && (!SpawnerClass || !EnemyClass); ++It)
+	{
+		if (!SpawnerClass)
+		{
+			SpawnerClass = It->GetClass();
+		}
+
+		if (!EnemyClass)
+		{
+			EnemyClass = It->GetEnemyClass();
+		}
+	}
+
+	if (!SpawnerClass || !EnemyClass)
+	{
+		return false;
+	}
+
+	// there's no generated level geometry, the spawners are laid out in a ring around the player in the loaded map, facing inwards
+	const FVector Center = PlayerSnapshot->Location;
+
+	for (int32 i = 0; i < NumSpawners; ++i)
+	{
+		const float Angle = (2.0f * UE_PI * i) / FMath::Max(NumSpawners, 1);
+		const FVector Offset(FMath::Cos(Angle) * ArenaRadius, FMath::Sin(Angle) * ArenaRadius, 0.0f);
+		const FTransform SpawnTransform((-Offset).Rotation(), Center + Offset - FVector(0.0f, 0.0f, 90.0f));
+
+		ACombatEnemySpawner* Spawner = World->SpawnActorDeferred<ACombatEnemySpawner>(SpawnerClass, SpawnTransform);
+
+		if (Spawner)
+		{
+			Spawner->SetupSpawner(EnemyClass, EnemiesPerSpawner, 0.5f, bUseCrowd);
+			Spawner->FinishSpawning(SpawnTransform);
+
+			ArenaSpawners.Add(Spawner);
+		}
+	}
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat soak: placed %d spawners around %s"), ArenaSpawners.Num(), *Center.ToString());
+
+	return ArenaSpawners.Num() > 0;
+}
+
+void UCombatSoakSubsystem::DrivePlayer()
+{
+	const FPlayerSnapshot* PlayerSnapshot = UPlayerSnapshotSubsystem::Get(this);
+	ACombatCharacter* Player = PlayerSnapshot ? Cast<ACombatCharacter>(PlayerSnapshot->Pawn) : nullptr;
+
+	if (!Player)
+	{
+		return;
+	}
+
+	// loop through a fixed six second script
+	const float ScriptTime = FMath::Fmod(ElapsedTime, 6.0f);
+	const int32 Frame = FMath::FloorToInt32(ElapsedTime * FixedFrameRate);
+
+	if (ScriptTime < 3.0f)
+	{
+		// mash the combo attack
+		if (Frame % FMath::Max(FMath::RoundToInt32(FixedFrameRate * 0.2f), 1) == 0)
+		{
+			Player->DoComboAttackStart();
+			Player->DoComboAttackEnd();
+		}
+	}
+	else if (ScriptTime < 4.5f)
+	{
+		// hold the charged attack
+		if (ScriptTime - 3.0f < 1.0f / FixedFrameRate)
+		{
+			Player->DoChargedAttackStart();
+		}
+	}
+	else
+	{
+		// release the charged attack, then circle the arena
+		if (ScriptTime - 4.5f < 1.0f / FixedFrameRate)
+		{
+			Player->DoChargedAttackEnd();
+		}
+
+		Player->DoMove(FMath::Sin(ElapsedTime), FMath::Cos(ElapsedTime));
+	}
+}
+
+void UCombatSoakSubsystem::FinishBenchmark()
+{
+	// only finish once. Exiting takes a few frames, so stop the markers without unregistering them from inside the tick.
+	// Deinitialize unregisters them
+	bFinished = true;
+
+	for (FGameWorldTickFunction& Marker : GroupMarkers)
+	{
+		Marker.SetTickFunctionEnable(false);
+	}
+
+	const FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"));
+	const FString BaseName = FPaths::Combine(FPaths::ProfilingDir(), TEXT("CombatSoak"), FString::Printf(TEXT("CombatSoak-%s"), *Timestamp));
+
+	WriteFrameCSV(BaseName + TEXT(".csv"));
+	WriteSummaryJSON(BaseName + TEXT(".json"));
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Combat soak: recorded %d frames, results written to %s.[csv|json]"), Frames.Num(), *BaseName);
+
+	FPlatformMisc::RequestExitWithStatus(false, 0);
+}
+
+void UCombatSoakSubsystem::WriteFrameCSV(const FString& FilePath) const
+{
+	TArray<FString> Lines;
+	Lines.Reserve(Frames.Num() + 1);
+
+	// header
+	FString Header = TEXT("Frame,FrameMs,GameThreadMs");
+
+	for (const TCHAR* GroupName : SoakTickGroupNames)
+	{
+		Header += FString::Printf(TEXT(",%sMs"), GroupName);
+	}
+
+	Header += TEXT(",UsedPhysicalMB,ActiveEnemies,CrowdEntities");
+	Lines.Add(Header);
+
+	// one row per frame
+	for (int32 FrameIndex = 0; FrameIndex < Frames.Num(); ++FrameIndex)
+	{
+		const FCombatSoakFrame& Frame = Frames[FrameIndex];
+
+		FString Line = FString::Printf(TEXT("%d,%.3f,%.3f"), FrameIndex, Frame.FrameTimeMs, Frame.GameThreadTimeMs);
+
+		for (const float GroupTime : Frame.TickGroupTimeMs)
+		{
+			Line += FString::Printf(TEXT(",%.3f"), GroupTime);
+		}
+
+		Line += FString::Printf(TEXT(",%.1f,%d,%d"), Frame.UsedPhysicalBytes / (1024.0 * 1024.0), Frame.ActiveEnemies, Frame.CrowdEntities);
+		Lines.Add(Line);
+	}
+
+	FFileHelper::SaveStringArrayToFile(Lines, *FilePath);
+}
+
+void UCombatSoakSubsystem::WriteSummaryJSON(const FString& FilePath) const
+{
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+
+	// run parameters
+	Root->SetStringField(TEXT("map"), GetWorld()->GetMapName());
+	Root->SetNumberField(TEXT("spawners"), NumSpawners);
+	Root->SetNumberField(TEXT("enemiesPerSpawner"), EnemiesPerSpawner);
+	Root->SetBoolField(TEXT("crowd"), bUseCrowd);
+	Root->SetNumberField(TEXT("durationSeconds"), Duration);
+	Root->SetNumberField(TEXT("fixedFrameRate"), FixedFrameRate);
+	Root->SetNumberField(TEXT("frames"), Frames.Num());
+
+	// frame and game thread time percentiles
+	TArray<float> FrameTimes;
+	TArray<float> GameThreadTimes;
+	TArray<float> GroupTimes[CombatSoakNumTickGroups];
+
+	int32 PeakEnemies = 0;
+
+	for (const FCombatSoakFrame& Frame : Frames)
+	{
+		FrameTimes.Add(Frame.FrameTimeMs);
+		GameThreadTimes.Add(Frame.GameThreadTimeMs);
+
+		for (int32 i = 0; i < CombatSoakNumTickGroups; ++i)
+		{
+			GroupTimes[i].Add(Frame.TickGroupTimeMs[i]);
+		}
+
+		PeakEnemies = FMath::Max(PeakEnemies, Frame.ActiveEnemies + Frame.CrowdEntities);
+	}
+
+	Root->SetObjectField(TEXT("frameMs"), MakePercentiles(FrameTimes));
+	Root->SetObjectField(TEXT("gameThreadMs"), MakePercentiles(GameThreadTimes));
+
+	TSharedRef<FJsonObject> TickGroups = MakeShared<FJsonObject>();
+
+	for (int32 i = 0; i < CombatSoakNumTickGroups; ++i)
+	{
+		TickGroups->SetObjectField(SoakTickGroupNames[i], MakePercentiles(GroupTimes[i]));
+	}
+
+	Root->SetObjectField(TEXT("tickGroupMs"), TickGroups);
+
+	// memory high water marks
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+
+	TSharedRef<FJsonObject> Memory = MakeShared<FJsonObject>();
+	Memory->SetNumberField(TEXT("peakUsedPhysicalMB"), PeakUsedPhysicalBytes / (1024.0 * 1024.0));
+	Memory->SetNumberField(TEXT("processPeakUsedPhysicalMB"), MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0));
+	Memory->SetNumberField(TEXT("processPeakUsedVirtualMB"), MemoryStats.PeakUsedVirtual / (1024.0 * 1024.0));
+
+	Root->SetObjectField(TEXT("memory"), Memory);
+	Root->SetNumberField(TEXT("peakEnemies"), PeakEnemies);
+
+	FString Output;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	FFileHelper::SaveStringToFile(Output, *FilePath);
+}
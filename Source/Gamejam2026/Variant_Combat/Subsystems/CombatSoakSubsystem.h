@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameWorldTickFunction.h"
+#include "CombatSoakSubsystem.generated.h"
+
+class ACombatEnemySpawner;
+class ACombatEnemy;
+
+/** Number of tick phases timed by the soak benchmark */
+static constexpr int32 CombatSoakNumTickGroups = 4;
+
+/**
+ *  Measurements for a single soak benchmark frame
+ */
+struct FCombatSoakFrame
+{
+	/** Wall clock time since the previous frame */
+	float FrameTimeMs = 0.0f;
+
+	/** Game thread time reported by the engine */
+	float GameThreadTimeMs = 0.0f;
+
+	/** Time spent in each timed tick phase */
+	float TickGroupTimeMs[CombatSoakNumTickGroups] = {};
+
+	/** Physical memory in use at the end of the frame */
+	uint64 UsedPhysicalBytes = 0;
+
+	/** Number of active enemy actors */
+	int32 ActiveEnemies = 0;
+
+	/** Number of enemies living as crowd entities */
+	int32 CrowdEntities = 0;
+};
+
+/**
+ *  Headless combat soak benchmark.
+ *  Only created when the game runs with -CombatSoak, for example:
+ *  Gamejam2026 <Map> -CombatSoak -nullrhi -unattended -CombatSoakSpawners=8 -CombatSoakEnemies=10 -CombatSoakDuration=60
+ *  Places a ring of enemy spawners around the player in the loaded map, scripts the player through combo and charged attacks
+ *  on a fixed time step, then writes frame time percentiles, per tick phase game thread time
+ *  and memory high water marks to Saved/Profiling/CombatSoak as CSV and JSON, and exits.
+ */
+UCLASS()
+class UCombatSoakSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Spawners generated for the arena */
+	UPROPERTY()
+	TArray<TObjectPtr<ACombatEnemySpawner>> ArenaSpawners;
+
+	/** Tick functions marking the boundaries between timed tick phases. Ordered against the world's physics tick functions */
+	FGameWorldTickFunction GroupMarkers[CombatSoakNumTickGroups - 1];
+
+	/** Time each phase boundary was reached this frame, from the start of the actor tick to its end */
+	double MarkerTimes[CombatSoakNumTickGroups + 1] = {};
+
+	/** Handle to the world's pre actor tick delegate, which starts the frame */
+	FDelegateHandle PreActorTickHandle;
+
+	/** Handle to the world's post actor tick delegate, which ends the frame */
+	FDelegateHandle PostActorTickHandle;
+
+	/** If true, the results have been written and we're waiting to exit */
+	bool bFinished = false;
+
+	/** If true, we've overridden the engine's fixed time step and need to put it back */
+	bool bOverrodeFixedTimeStep = false;
+
+	/** Fixed time step setting before we overrode it */
+	bool bPreviousUseFixedTimeStep = false;
+
+	/** Fixed delta time before we overrode it */
+	double PreviousFixedDeltaTime = 0.0;
+
+	/** Recorded frames */
+	TArray<FCombatSoakFrame> Frames;
+
+	/** Number of spawners to generate */
+	int32 NumSpawners = 8;
+
+	/** Number of enemies per spawner */
+	int32 EnemiesPerSpawner = 10;
+
+	/** Simulated time to record for */
+	float Duration = 60.0f;
+
+	/** Simulated time to wait before recording, so spawning and loading don't skew the results */
+	float WarmupTime = 5.0f;
+
+	/** Fixed simulation rate */
+	float FixedFrameRate = 60.0f;
+
+	/** Radius of the spawner ring */
+	float ArenaRadius = 1500.0f;
+
+	/** If true, spawners will feed the crowd instead of spawning actors directly */
+	bool bUseCrowd = false;
+
+	/** If true, the spawner ring has been placed */
+	bool bArenaGenerated = false;
+
+	/** Simulated time since the spawner ring was placed */
+	float ElapsedTime = 0.0f;
+
+	/** Highest physical memory use seen while recording */
+	uint64 PeakUsedPhysicalBytes = 0;
+
+	/** Wall clock time the last frame started */
+	double LastFrameStartTime = 0.0;
+
+public:
+
+	/** Only create the subsystem for soak runs */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Reads the command line and registers the tick group markers */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Removes the markers and restores the engine time step */
+	virtual void Deinitialize() override;
+
+	/** Closes out the previous frame and runs the benchmark before any actor ticks */
+	void OnPreActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+	/** Records the end of the last timed tick phase */
+	void OnPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+	/** Records the time a tick phase boundary was reached */
+	void OnGroupMarker(float DeltaTime, int32 MarkerIndex);
+
+	/** Runs the benchmark state machine at the start of the frame */
+	void StepBenchmark(float DeltaTime);
+
+	/** Spawns the spawner ring around the player */
+	bool GenerateArena();
+
+	/** Drives the player through attacks and movement */
+	void DrivePlayer();
+
+	/** Writes the results, stops the markers and requests exit */
+	void FinishBenchmark();
+
+	/** Writes the per-frame CSV file */
+	void WriteFrameCSV(const FString& FilePath) const;
+
+	/** Writes the JSON summary */
+	void WriteSummaryJSON(const FString& FilePath) const;
+};
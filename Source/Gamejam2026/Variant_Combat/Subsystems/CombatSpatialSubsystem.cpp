@@ -0,0 +1,419 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatSpatialSubsystem.h"
+#include "CombatStats.h"
+#include "CombatEnemy.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/GameplayStatics.h"
+#include "EngineUtils.h"
+#include "Algo/Sort.h"
+#include "Gamejam2026.h"
+
+static float GCombatSpatialCellSize = 500.0f;
+static FAutoConsoleVariableRef CVarCombatSpatialCellSize(
+	TEXT("Combat.Spatial.CellSize"),
+	GCombatSpatialCellSize,
+	TEXT("Size of the grid cells used to index combat enemies, in cm"),
+	ECVF_Default
+);
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs CombatSpatialBenchmarkCommand(
+	TEXT("Combat.Spatial.Benchmark"),
+	TEXT("Compares the danger sweep and the spatial grid query at 10, 100 and 500 enemies. Optional argument: enemy class path. Defaults to the class of the first indexed enemy"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UCombatSpatialSubsystem* Spatial = World ? World->GetSubsystem<UCombatSpatialSubsystem>() : nullptr;
+		APawn* PlayerPawn = World ? UGameplayStatics::GetPlayerPawn(World, 0) : nullptr;
+
+		if (!Spatial || !PlayerPawn)
+		{
+			UE_LOG(LogGamejam2026, Warning, TEXT("Combat.Spatial.Benchmark requires a game world with a player pawn"));
+			return;
+		}
+
+		// resolve the enemy class to benchmark with
+		TSubclassOf<ACombatEnemy> EnemyClass;
+
+		if (Args.Num() > 0)
+		{
+			EnemyClass = LoadClass<ACombatEnemy>(nullptr, *Args[0]);
+		}
+		else
+		{
+			for (TActorIterator<ACombatEnemy> It(World); It; ++It)
+			{
+				EnemyClass = It->GetClass();
+				break;
+			}
+		}
+
+		if (!EnemyClass)
+		{
+			UE_LOG(LogGamejam2026, Warning, TEXT("Combat.Spatial.Benchmark could not find an enemy class to spawn"));
+			return;
+		}
+
+		Spatial->RunDangerBenchmark(EnemyClass, PlayerPawn);
+	})
+);
+
+#endif
+
+void UCombatSpatialSubsystem::RegisterEnemy(ACombatEnemy* Enemy)
+{
+	// ensure the enemy is valid and not already indexed
+	if (!IsValid(Enemy) || SlotLookup.Contains(Enemy))
+	{
+		return;
+	}
+
+	const int32 Slot = Enemies.Add(Enemy);
+	SlotLookup.Add(Enemy, Slot);
+
+	// seed the slot so queries work before the next rebuild
+	Locations.Add(Enemy->GetActorLocation());
+	DangerLocations.Add(FVector::ZeroVector);
+	DangerTimes.Add(NoDangerTime);
+
+	bGridDirty = true;
+}
+
+void UCombatSpatialSubsystem::UnregisterEnemy(ACombatEnemy* Enemy)
+{
+	int32 Slot = INDEX_NONE;
+
+	if (!SlotLookup.RemoveAndCopyValue(Enemy, Slot))
+	{
+		return;
+	}
+
+	// fill the hole with the last slot to keep the arrays packed
+	Enemies.RemoveAtSwap(Slot, EAllowShrinking::No);
+	Locations.RemoveAtSwap(Slot, EAllowShrinking::No);
+	DangerLocations.RemoveAtSwap(Slot, EAllowShrinking::No);
+	DangerTimes.RemoveAtSwap(Slot, EAllowShrinking::No);
+
+	// update the lookup for the enemy that was moved into the hole
+	if (Enemies.IsValidIndex(Slot))
+	{
+		SlotLookup.Add(Enemies[Slot], Slot);
+	}
+
+	bGridDirty = true;
+}
+
+void UCombatSpatialSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees, float NearRadius, TArray<ACombatEnemy*>& OutEnemies)
+{
+	// make sure the grid matches the registered enemies
+	if (bGridDirty)
+	{
+		RebuildGrid(0.0f);
+	}
+
+	const FVector2D Origin2D(Origin);
+	const FVector2D Direction2D = FVector2D(Direction).GetSafeNormal();
+	const float RangeSquared = FMath::Square(Range);
+	const float NearRadiusSquared = FMath::Square(NearRadius);
+	const float ConeAngleCos = FMath::Cos(FMath::DegreesToRadians(HalfAngleDegrees));
+
+	// visit every cell overlapped by the query range
+	const FIntPoint MinCell = GetCell(Origin - FVector(Range));
+	const FIntPoint MaxCell = GetCell(Origin + FVector(Range));
+
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			const FCombatSpatialCell* Cell = Cells.Find(FIntPoint(CellX, CellY));
+
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (int32 i = Cell->Start; i < Cell->Start + Cell->Count; ++i)
+			{
+				const int32 Slot = SortedSlots[i];
+
+				// range check
+				const float DistanceSquared = FVector::DistSquared(Locations[Slot], Origin);
+
+				if (DistanceSquared > RangeSquared)
+				{
+					continue;
+				}
+
+				// enemies right next to the origin are always in danger, otherwise check the cone
+				if (DistanceSquared > NearRadiusSquared)
+				{
+					const FVector2D ToEnemy = (FVector2D(Locations[Slot]) - Origin2D).GetSafeNormal();
+
+					if (FVector2D::DotProduct(ToEnemy, Direction2D) < ConeAngleCos)
+					{
+						continue;
+					}
+				}
+
+				OutEnemies.Add(Enemies[Slot]);
+			}
+		}
+	}
+}
+
+int32 UCombatSpatialSubsystem::BroadcastDanger(AActor* DangerSource, const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees, float NearRadius)
+{
+	TArray<ACombatEnemy*> Threatened;
+	QueryCone(Origin, Direction, Range, HalfAngleDegrees, NearRadius, Threatened);
+
+	// notify the enemies. They may filter out danger sources they don't care about
+	for (ACombatEnemy* Enemy : Threatened)
+	{
+		if (IsValid(Enemy) && Enemy != DangerSource)
+		{
+			Enemy->NotifyDanger(Origin, DangerSource);
+		}
+	}
+
+	return Threatened.Num();
+}
+
+void UCombatSpatialSubsystem::RecordDanger(const ACombatEnemy* Enemy, const FVector& DangerLocation)
+{
+	if (const int32* Slot = SlotLookup.Find(Enemy))
+	{
+		DangerLocations[*Slot] = DangerLocation;
+		DangerTimes[*Slot] = GetWorld()->GetTimeSeconds();
+	}
+}
+
+FVector UCombatSpatialSubsystem::GetLastDangerLocation(const ACombatEnemy* Enemy) const
+{
+	const int32* Slot = SlotLookup.Find(Enemy);
+	return Slot ? DangerLocations[*Slot] : FVector::ZeroVector;
+}
+
+float UCombatSpatialSubsystem::GetLastDangerTime(const ACombatEnemy* Enemy) const
+{
+	const int32* Slot = SlotLookup.Find(Enemy);
+	return Slot ? DangerTimes[*Slot] : NoDangerTime;
+}
+
+bool UCombatSpatialSubsystem::IsInDanger(const ACombatEnemy* Enemy, float MinReactionTime, float MaxReactionTime, float SightConeAngleCos) const
+{
+	const int32* Slot = SlotLookup.Find(Enemy);
+
+	if (!Slot)
+	{
+		return false;
+	}
+
+	// is the last detected danger event within the reaction threshold?
+	const float ReactionDelta = GetWorld()->GetTimeSeconds() - DangerTimes[*Slot];
+
+	if (ReactionDelta >= MaxReactionTime || ReactionDelta <= MinReactionTime)
+	{
+		return false;
+	}
+
+	// do a dot product check to determine if the danger location is within the enemy's detection cone.
+	// Use the live transform since the enemy may have moved since the last rebuild
+	const FVector DangerDir = (DangerLocations[*Slot] - Enemy->GetActorLocation()).GetSafeNormal2D();
+
+	return FVector::DotProduct(DangerDir, Enemy->GetActorForwardVector()) > SightConeAngleCos;
+}
+
+bool UCombatSpatialSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatSpatialSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// rebuild the grid at the start of the frame, before the player and AI act on it
+	RebuildTickFunction.OnTick.BindUObject(this, &UCombatSpatialSubsystem::RebuildGrid);
+	RebuildTickFunction.Register(&InWorld, TG_PrePhysics, true, TEXT("CombatSpatialGrid"));
+}
+
+void UCombatSpatialSubsystem::Deinitialize()
+{
+	RebuildTickFunction.Unregister();
+
+	Enemies.Empty();
+	Locations.Empty();
+	DangerLocations.Empty();
+	DangerTimes.Empty();
+	SlotLookup.Empty();
+	SortedSlots.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatSpatialSubsystem::RebuildGrid(float DeltaTime)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(SpatialGrid);
+	COMBAT_SET_COUNTER(EnemiesAlive, Enemies.Num());
+
+	CellSize = FMath::Max(GCombatSpatialCellSize, 50.0f);
+
+	// refresh the cached positions in a single pass
+	for (int32 Slot = 0; Slot < Enemies.Num(); ++Slot)
+	{
+		if (const ACombatEnemy* Enemy = Enemies[Slot])
+		{
+			Locations[Slot] = Enemy->GetActorLocation();
+		}
+	}
+
+	// sort the slots by cell so each cell is a contiguous run
+	SortedSlots.Reset(Enemies.Num());
+
+	for (int32 Slot = 0; Slot < Enemies.Num(); ++Slot)
+	{
+		SortedSlots.Add(Slot);
+	}
+
+	Algo::SortBy(SortedSlots, [this](int32 Slot)
+	{
+		const FIntPoint Cell = GetCell(Locations[Slot]);
+		return (static_cast<uint64>(static_cast<uint32>(Cell.Y)) << 32) | static_cast<uint32>(Cell.X);
+	});
+
+	// record the run for each occupied cell
+	Cells.Reset();
+
+	for (int32 i = 0; i < SortedSlots.Num(); ++i)
+	{
+		FCombatSpatialCell& Cell = Cells.FindOrAdd(GetCell(Locations[SortedSlots[i]]));
+
+		if (Cell.Count == 0)
+		{
+			Cell.Start = i;
+		}
+
+		++Cell.Count;
+	}
+
+	bGridDirty = false;
+}
+
+FIntPoint UCombatSpatialSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+#if !UE_BUILD_SHIPPING
+
+void UCombatSpatialSubsystem::RunDangerBenchmark(TSubclassOf<ACombatEnemy> EnemyClass, const AActor* Source)
+{
+	UWorld* World = GetWorld();
+
+	if (!Source || !EnemyClass)
+	{
+		return;
+	}
+
+	// use the same parameters as the player character's defaults
+	const float TraceDistance = 300.0f;
+	const float TraceRadius = 100.0f;
+	const float ConeHalfAngle = 35.0f;
+	const float Spacing = 150.0f;
+	const int32 Iterations = 1000;
+
+	const FVector Origin = Source->GetActorLocation();
+	const FVector Forward = Source->GetActorForwardVector();
+
+	const int32 EnemyCounts[] = { 10, 100, 500 };
+
+	for (const int32 EnemyCount : EnemyCounts)
+	{
+		// lay out the enemies in a square around the source. They're spawned outside the pool and without AI,
+		// so they only serve as collision and index entries and don't skew the pool or the level
+		TArray<ACombatEnemy*> Spawned;
+		const int32 Side = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(EnemyCount)));
+
+		for (int32 i = 0; i < EnemyCount; ++i)
+		{
+			const FVector Offset((i % Side - Side / 2) * Spacing, (i / Side - Side / 2) * Spacing, 0.0f);
+			const FTransform SpawnTransform(Source->GetActorRotation(), Origin + Offset + Forward * Spacing);
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			SpawnParams.bDeferConstruction = true;
+
+			if (ACombatEnemy* Enemy = World->SpawnActor<ACombatEnemy>(EnemyClass, SpawnTransform, SpawnParams))
+			{
+				Enemy->AutoPossessAI = EAutoPossessAI::Disabled;
+				Enemy->PrimaryActorTick.bStartWithTickEnabled = false;
+				Enemy->FinishSpawning(SpawnTransform);
+
+				Spawned.Add(Enemy);
+			}
+		}
+
+		RebuildGrid(0.0f);
+
+		// time the physics sweep the character used to run
+		FCollisionObjectQueryParams ObjectParams;
+		ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatDangerBenchmark), false, Source);
+
+		TArray<FHitResult> OutHits;
+		int32 SweepHits = 0;
+
+		double StartTime = FPlatformTime::Seconds();
+
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			OutHits.Reset();
+			World->SweepMultiByObjectType(OutHits, Origin, Origin + Forward * TraceDistance, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(TraceRadius), QueryParams);
+			SweepHits = OutHits.Num();
+		}
+
+		const double SweepUs = (FPlatformTime::Seconds() - StartTime) * 1000000.0 / Iterations;
+
+		// time the grid query
+		TArray<ACombatEnemy*> Found;
+		int32 GridHits = 0;
+
+		StartTime = FPlatformTime::Seconds();
+
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			Found.Reset();
+			QueryCone(Origin, Forward, TraceDistance + TraceRadius, ConeHalfAngle, TraceRadius, Found);
+			GridHits = Found.Num();
+		}
+
+		const double QueryUs = (FPlatformTime::Seconds() - StartTime) * 1000000.0 / Iterations;
+
+		// time the per-frame rebuild
+		StartTime = FPlatformTime::Seconds();
+
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			RebuildGrid(0.0f);
+		}
+
+		const double RebuildUs = (FPlatformTime::Seconds() - StartTime) * 1000000.0 / Iterations;
+
+		UE_LOG(LogGamejam2026, Log, TEXT("Combat danger benchmark: %d enemies indexed | sweep %.2f us (%d hits) | grid query %.2f us (%d hits) | grid rebuild %.2f us"),
+			Enemies.Num(), SweepUs, SweepHits, QueryUs, GridHits, RebuildUs);
+
+		// remove the test enemies
+		for (ACombatEnemy* Enemy : Spawned)
+		{
+			Enemy->Destroy();
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GameWorldTickFunction.h"
+#include "CombatSpatialSubsystem.generated.h"
+
+class ACombatEnemy;
+
+/**
+ *  Range of sorted enemy slots that fall inside a single grid cell
+ */
+struct FCombatSpatialCell
+{
+	/** First entry in the sorted slot list */
+	int32 Start = 0;
+
+	/** Number of entries in this cell */
+	int32 Count = 0;
+};
+
+/**
+ *  Spatial index of living combat enemies.
+ *  Keeps enemy positions and danger records in flat arrays
+ *  and buckets them into a uniform 2D grid rebuilt once per frame,
+ *  so danger broadcasts and danger checks don't need physics scene queries.
+ */
+UCLASS()
+class UCombatSpatialSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Registered enemies. Indexed by slot */
+	UPROPERTY()
+	TArray<TObjectPtr<ACombatEnemy>> Enemies;
+
+	/** Enemy locations, as of the last grid rebuild. Indexed by slot */
+	TArray<FVector> Locations;
+
+	/** Last recorded location each enemy was attacked from. Indexed by slot */
+	TArray<FVector> DangerLocations;
+
+	/** Last recorded game time each enemy was attacked. Indexed by slot */
+	TArray<float> DangerTimes;
+
+	/** Enemy to slot lookup */
+	TMap<TObjectKey<ACombatEnemy>, int32> SlotLookup;
+
+	/** Enemy slots sorted by grid cell */
+	TArray<int32> SortedSlots;
+
+	/** Grid cells that contain at least one enemy */
+	TMap<FIntPoint, FCombatSpatialCell> Cells;
+
+	/** Tick function that refreshes the grid */
+	FGameWorldTickFunction RebuildTickFunction;
+
+	/** Size of each grid cell */
+	float CellSize = 500.0f;
+
+	/** If true, the grid no longer matches the slot arrays and must be rebuilt before the next query */
+	bool bGridDirty = false;
+
+public:
+
+	/** Game time value used for enemies that have never been in danger */
+	static constexpr float NoDangerTime = -1000.0f;
+
+	/** Adds a living enemy to the index */
+	void RegisterEnemy(ACombatEnemy* Enemy);
+
+	/** Removes an enemy from the index. Safe to call on unregistered enemies */
+	void UnregisterEnemy(ACombatEnemy* Enemy);
+
+	/** Returns the number of indexed enemies */
+	int32 GetNumEnemies() const { return Enemies.Num(); }
+
+	/** Returns the indexed enemies. Indexed by slot */
+	const TArray<TObjectPtr<ACombatEnemy>>& GetEnemies() const { return Enemies; }
+
+	/** Returns the enemy locations as of the last grid rebuild. Indexed by slot */
+	const TArray<FVector>& GetEnemyLocations() const { return Locations; }
+
+	/**
+	 *  Finds all indexed enemies inside a horizontal cone.
+	 *  Enemies within NearRadius of the origin are always included.
+	 */
+	void QueryCone(const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees, float NearRadius, TArray<ACombatEnemy*>& OutEnemies);
+
+	/** Notifies every enemy inside the cone of an incoming attack. Returns the number of enemies notified */
+	int32 BroadcastDanger(AActor* DangerSource, const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees, float NearRadius);
+
+	/** Saves a danger event for the enemy */
+	void RecordDanger(const ACombatEnemy* Enemy, const FVector& DangerLocation);
+
+	/** Returns the last recorded location the enemy was attacked from */
+	FVector GetLastDangerLocation(const ACombatEnemy* Enemy) const;
+
+	/** Returns the last game time the enemy was attacked */
+	float GetLastDangerTime(const ACombatEnemy* Enemy) const;
+
+	/**
+	 *  Returns true if the enemy's last danger event happened inside the reaction time window
+	 *  and its location falls inside the enemy's sight cone
+	 */
+	bool IsInDanger(const ACombatEnemy* Enemy, float MinReactionTime, float MaxReactionTime, float SightConeAngleCos) const;
+
+#if !UE_BUILD_SHIPPING
+
+	/** Compares the physics sweep and the grid query for danger broadcasts at several enemy counts */
+	void RunDangerBenchmark(TSubclassOf<ACombatEnemy> EnemyClass, const AActor* Source);
+
+#endif
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the rebuild tick function */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Refreshes positions and rebuilds the grid */
+	void RebuildGrid(float DeltaTime);
+
+	/** Returns the grid cell for a world location */
+	FIntPoint GetCell(const FVector& Location) const;
+};
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatLifeBarLayer.h"
+#include "CombatLifeBarSubsystem.h"
+#include "Engine/World.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+
+UCombatLifeBarLayer::UCombatLifeBarLayer(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// never block clicks or focus
+	SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+int32 UCombatLifeBarLayer::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	LayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	const UCombatLifeBarSubsystem* LifeBars = GetWorld() ? GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>() : nullptr;
+
+	if (!LifeBars)
+	{
+		return LayerId;
+	}
+
+	const FSlateBrush* Brush = FCoreStyle::Get().GetBrush(TEXT("WhiteBrush"));
+
+	const FLinearColor TintedBackground = BackgroundColor * InWidgetStyle.GetColorAndOpacityTint();
+	const FLinearColor TintedFill = FillColor * InWidgetStyle.GetColorAndOpacityTint();
+
+	// backgrounds first, then fills on the layer above, so Slate can batch each layer into a single draw
+	for (const FCombatLifeBarDrawItem& Item : LifeBars->GetDrawItems())
+	{
+		const FVector2D Size = BarSize * Item.Scale;
+		const FVector2D Border(BorderSize);
+
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 1,
+			AllottedGeometry.ToPaintGeometry(Size + Border * 2.0, FSlateLayoutTransform(Item.Position - Size * 0.5 - Border)),
+			Brush, ESlateDrawEffect::None, TintedBackground);
+	}
+
+	for (const FCombatLifeBarDrawItem& Item : LifeBars->GetDrawItems())
+	{
+		if (Item.Percent <= 0.0f)
+		{
+			continue;
+		}
+
+		const FVector2D Size = BarSize * Item.Scale;
+		const FVector2D FillSize(Size.X * Item.Percent, Size.Y);
+
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 2,
+			AllottedGeometry.ToPaintGeometry(FillSize, FSlateLayoutTransform(Item.Position - Size * 0.5)),
+			Brush, ESlateDrawEffect::None, TintedFill);
+	}
+
+	return LayerId + 2;
+}
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "CombatLifeBarLayer.generated.h"
+
+/**
+ *  Full screen HUD layer that draws every batched enemy life bar in a single paint pass.
+ *  Bar positions come from the UCombatLifeBarSubsystem draw list.
+ */
+UCLASS()
+class UCombatLifeBarLayer : public UUserWidget
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Size of a bar at full scale */
+	UPROPERTY(EditAnywhere, Category="Life Bar")
+	FVector2D BarSize = FVector2D(80.0f, 8.0f);
+
+	/** Thickness of the border around the bar */
+	UPROPERTY(EditAnywhere, Category="Life Bar")
+	float BorderSize = 1.0f;
+
+	/** Background color */
+	UPROPERTY(EditAnywhere, Category="Life Bar")
+	FLinearColor BackgroundColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.6f);
+
+	/** Fill color */
+	UPROPERTY(EditAnywhere, Category="Life Bar")
+	FLinearColor FillColor = FLinearColor(0.8f, 0.05f, 0.05f, 1.0f);
+
+public:
+
+	/** Constructor */
+	UCombatLifeBarLayer(const FObjectInitializer& ObjectInitializer);
+
+protected:
+
+	/** Draws the batched life bars */
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+};
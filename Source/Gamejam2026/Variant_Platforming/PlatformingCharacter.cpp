@@ -5,24 +5,21 @@
 
 #include "Components/CapsuleComponent.h"
 #include "Engine/World.h"
-#include "GameFramework/CharacterMovementComponent.h"
+#include "GameCharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Camera/CameraComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "EnhancedInputComponent.h"
-#include "TimerManager.h"
 #include "Engine/LocalPlayer.h"
 
-APlatformingCharacter::APlatformingCharacter()
+APlatformingCharacter::APlatformingCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UGameCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
  	PrimaryActorTick.bCanEverTick = true;
 
 	// initialize the flags
-	bHasWallJumped = false;
 	bHasDoubleJumped = false;
-	bHasDashed = false;
-	bIsDashing = false;
 
 	// bind the dash montage ended delegate
 	OnDashMontageEnded.BindUObject(this, &APlatformingCharacter::DashMontageEnded);
@@ -61,6 +58,11 @@ APlatformingCharacter::APlatformingCharacter()
 	GetCharacterMovement()->NavAgentProps.AgentRadius = 42.0;
 	GetCharacterMovement()->NavAgentProps.AgentHeight = 192.0;
 
+	// configure the wall jump
+	GetPlatformingMovement()->WallJumpHorizontalSpeed = 800.0f;
+	GetPlatformingMovement()->WallJumpVerticalSpeed = 900.0f;
+	GetPlatformingMovement()->WallJumpLockTime = 0.1f;
+
 	// create the camera boom
 	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
 	CameraBoom->SetupAttachment(RootComponent);
@@ -104,106 +106,67 @@ void APlatformingCharacter::Dash()
 void APlatformingCharacter::MultiJump()
 {
 	// ignore jumps while dashing
-	if(bIsDashing)
+	if (GetPlatformingMovement()->IsDashing())
 		return;
 
-	// are we already in the air?
-	if (GetCharacterMovement()->IsFalling())
+	// are we grounded?
+	if (!GetCharacterMovement()->IsFalling())
 	{
+		// we're grounded so just do a regular jump
+		Jump();
 
-		// have we already wall jumped?
-		if (!bHasWallJumped)
-		{
-			// run a sphere sweep to check if we're in front of a wall
-			FHitResult OutHit;
-
-			const FVector TraceStart = GetActorLocation();
-			const FVector TraceEnd = TraceStart + (GetActorForwardVector() * WallJumpTraceDistance);
-			const FCollisionShape TraceShape = FCollisionShape::MakeSphere(WallJumpTraceRadius);
-
-			FCollisionQueryParams QueryParams;
-			QueryParams.AddIgnoredActor(this);
-
-			if (GetWorld()->SweepSingleByChannel(OutHit, TraceStart, TraceEnd, FQuat(), ECollisionChannel::ECC_Visibility, TraceShape, QueryParams))
-			{
-				// rotate the character to face away from the wall, so we're correctly oriented for the next wall jump
-				FRotator WallOrientation = OutHit.ImpactNormal.ToOrientationRotator();
-				WallOrientation.Pitch = 0.0f;
-				WallOrientation.Roll = 0.0f;
-
-				SetActorRotation(WallOrientation);
-
-				// apply a launch impulse to the character to perform the actual wall jump
-				const FVector WallJumpImpulse = (OutHit.ImpactNormal * WallJumpBounceImpulse) + (FVector::UpVector * WallJumpVerticalImpulse);
-
-				LaunchCharacter(WallJumpImpulse, true, true);
-
-				// enable the jump trail
-				SetJumpTrailState(true);
-
-				// raise the wall jump flag to prevent an immediate second wall jump
-				bHasWallJumped = true;
+		// activate the jump trail
+		SetJumpTrailState(true);
+		return;
+	}
 
-				GetWorld()->GetTimerManager().SetTimer(WallJumpTimer, this, &APlatformingCharacter::ResetWallJump, DelayBetweenWallJumps, false);
-			}
-			// no wall jump, try a double jump next
-			else
-			{
-				// are we still within coyote time frames?
-				if (GetWorld()->GetTimeSeconds() - LastFallTime < MaxCoyoteTime)
-				{
-					UE_LOG(LogTemp, Warning, TEXT("Coyote Jump"));
+	// ignore jumps during the wall jump input lock
+	if (GetPlatformingMovement()->IsWallJumping())
+		return;
 
-					// use the built-in CMC functionality to do the jump
-					Jump();
+	// try to jump off a wall we've recently touched. The movement component predicts the jump and rotates us away from the wall
+	if (GetPlatformingMovement()->WallJump())
+	{
+		// enable the jump trail
+		SetJumpTrailState(true);
+		return;
+	}
 
-					// enable the jump trail
-					SetJumpTrailState(true);
+	// no wall jump, try a double jump next
+	// are we still within coyote time frames?
+	if (GetWorld()->GetTimeSeconds() - LastFallTime < MaxCoyoteTime)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Coyote Jump"));
 
-				// no coyote time jump
-				} else {
+		// use the built-in CMC functionality to do the jump
+		Jump();
 
-					// only double jump once while we're in the air
-					if (!bHasDoubleJumped)
-					{
-						bHasDoubleJumped = true;
+		// enable the jump trail
+		SetJumpTrailState(true);
 
-						// use the built-in CMC functionality to do the double jump
-						Jump();
+	// no coyote time jump
+	} else {
 
-						// enable the jump trail
-						SetJumpTrailState(true);
-					}
+		// only double jump once while we're in the air
+		if (!bHasDoubleJumped)
+		{
+			bHasDoubleJumped = true;
 
-				}
+			// use the built-in CMC functionality to do the double jump
+			Jump();
 
-				
-			}
+			// enable the jump trail
+			SetJumpTrailState(true);
 		}
-
-	}
-	else
-	{
-		// we're grounded so just do a regular jump
-		Jump();
-
-		// activate the jump trail
-		SetJumpTrailState(true);
 	}
 }
 
-void APlatformingCharacter::ResetWallJump()
-{
-	// reset the wall jump input lock
-	bHasWallJumped = false;
-}
-
 void APlatformingCharacter::DoMove(float Right, float Forward)
 {
 	if (GetController() != nullptr)
 	{
 		// momentarily disable movement inputs if we've just wall jumped
-		if (!bHasWallJumped)
+		if (!GetPlatformingMovement()->IsWallJumping())
 		{
 			// find out which way is forward
 			const FRotator Rotation = GetController()->GetControlRotation();
@@ -234,20 +197,11 @@ void APlatformingCharacter::DoLook(float Yaw, float Pitch)
 
 void APlatformingCharacter::DoDash()
 {
-	// ignore the input if we've already dashed and have yet to reset
-	if (bHasDashed)
+	// request the dash. The movement component ignores gravity and momentum while dashing,
+	// and refuses if we've already dashed and have yet to land
+	if (!GetPlatformingMovement()->Dash())
 		return;
 
-	// raise the dash flags
-	bIsDashing = true;
-	bHasDashed = true;
-
-	// disable gravity while dashing
-	GetCharacterMovement()->GravityScale = 0.0f;
-
-	// reset the character velocity so we don't carry momentum into the dash
-	GetCharacterMovement()->Velocity = FVector::ZeroVector;
-
 	// enable the jump trails
 	SetJumpTrailState(true);
 
@@ -284,19 +238,13 @@ void APlatformingCharacter::DashMontageEnded(UAnimMontage* Montage, bool bInterr
 
 void APlatformingCharacter::EndDash()
 {
-	// restore gravity
-	GetCharacterMovement()->GravityScale = 2.5f;
-
-	// reset the dashing flag
-	bIsDashing = false;
+	// end the dash mode
+	GetPlatformingMovement()->StopDash();
 
 	// are we grounded after the dash?
 	if (GetCharacterMovement()->IsMovingOnGround())
 	{
-		// reset the dash usage flag, since we won't receive a landed event
-		bHasDashed = false;
-
-		// deactivate the jump trails
+		// deactivate the jump trails, since we won't receive a landed event
 		SetJumpTrailState(false);
 	}
 }
@@ -308,15 +256,12 @@ bool APlatformingCharacter::HasDoubleJumped() const
 
 bool APlatformingCharacter::HasWallJumped() const
 {
-	return bHasWallJumped;
+	return GetPlatformingMovement()->IsWallJumping();
 }
 
-void APlatformingCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+UGameCharacterMovementComponent* APlatformingCharacter::GetPlatformingMovement() const
 {
-	Super::EndPlay(EndPlayReason);
-
-	// clear the wall jump reset timer
-	GetWorld()->GetTimerManager().ClearTimer(WallJumpTimer);
+	return CastChecked<UGameCharacterMovementComponent>(GetCharacterMovement());
 }
 
 void APlatformingCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -345,9 +290,8 @@ void APlatformingCharacter::Landed(const FHitResult& Hit)
 {
 	Super::Landed(Hit);
 
-	// reset the double jump and dash flags
+	// reset the double jump flag. The movement component resets the dash
 	bHasDoubleJumped = false;
-	bHasDashed = false;
 
 	// deactivate the jump trail
 	SetJumpTrailState(false);
@@ -357,8 +301,9 @@ void APlatformingCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode
 {
 	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
 
-	// are we falling?
-	if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Falling)
+	// have we walked off a ledge? Jumps also leave walking for falling, but with the jump input still pressed.
+	// Wall jumps and dashes leave a custom mode, so they don't count towards coyote time either
+	if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Falling && PrevMovementMode == EMovementMode::MOVE_Walking && !bPressedJump)
 	{
 		// save the game time when we started falling, so we can check it later for coyote time jumps
 		LastFallTime = GetWorld()->GetTimeSeconds();
@@ -13,6 +13,7 @@ class UCameraComponent;
 class UInputAction;
 struct FInputActionValue;
 class UAnimMontage;
+class UGameCharacterMovementComponent;
 
 /**
  *  An enhanced Third Person Character with the following functionality:
@@ -60,7 +61,7 @@ protected:
 public:
 
 	/** Constructor */
-	APlatformingCharacter();
+	APlatformingCharacter(const FObjectInitializer& ObjectInitializer);
 
 protected:
 
@@ -76,9 +77,6 @@ protected:
 	/** Called for jump pressed to check for advanced multi-jump conditions */
 	void MultiJump();
 
-	/** Resets the wall jump input lock */
-	void ResetWallJump();
-
 public:
 
 	/** Handles move inputs from either controls or UI interfaces */
@@ -125,10 +123,10 @@ public:
 	UFUNCTION(BlueprintPure, Category="Platforming")
 	bool HasWallJumped() const;
 
+	/** Returns the platforming movement component */
+	UGameCharacterMovementComponent* GetPlatformingMovement() const;
+
 public:	
-	
-	/** EndPlay cleanup */
-	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/** Sets up input action bindings */
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -142,37 +140,11 @@ public:
 protected:
 
 	/** movement state flag bits, packed into a uint8 for memory efficiency */
-	uint8 bHasWallJumped : 1;
 	uint8 bHasDoubleJumped : 1;
-	uint8 bHasDashed : 1;
-	uint8 bIsDashing : 1;
-
-	/** timer for wall jump input reset */
-	FTimerHandle WallJumpTimer;
 
 	/** Dash montage ended delegate */
 	FOnMontageEnded OnDashMontageEnded;
 
-	/** Distance to trace ahead of the character to look for walls to jump from */
-	UPROPERTY(EditAnywhere, Category="Wall Jump", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm"))
-	float WallJumpTraceDistance = 50.0f;
-
-	/** Radius of the wall jump sphere trace check */
-	UPROPERTY(EditAnywhere, Category="Wall Jump", meta = (ClampMin = 0, ClampMax = 100, Units = "cm"))
-	float WallJumpTraceRadius = 25.0f;
-
-	/** Impulse to apply away from the wall when wall jumping */
-	UPROPERTY(EditAnywhere, Category="Wall Jump", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm/s"))
-	float WallJumpBounceImpulse = 800.0f;
-
-	/** Vertical impulse to apply when wall jumping */
-	UPROPERTY(EditAnywhere, Category="Wall Jump", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm/s"))
-	float WallJumpVerticalImpulse = 900.0f;
-
-	/** Time to ignore jump inputs after a wall jump */
-	UPROPERTY(EditAnywhere, Category="Wall Jump", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
-	float DelayBetweenWallJumps = 0.1f;
-
 	/** AnimMontage to use for the Dash action */
 	UPROPERTY(EditAnywhere, Category="Dash")
 	UAnimMontage* DashMontage;
@@ -4,7 +4,6 @@
 #include "SideScrollingNPC.h"
 #include "Engine/World.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "TimerManager.h"
 
 ASideScrollingNPC::ASideScrollingNPC()
 {
@@ -13,14 +12,6 @@ ASideScrollingNPC::ASideScrollingNPC()
 	GetCharacterMovement()->MaxWalkSpeed = 150.0f;
 }
 
-void ASideScrollingNPC::EndPlay(EEndPlayReason::Type EndPlayReason)
-{
-	Super::EndPlay(EndPlayReason);
-
-	// clear the deactivation timer
-	GetWorld()->GetTimerManager().ClearTimer(DeactivationTimer);
-}
-
 void ASideScrollingNPC::Interaction(AActor* Interactor)
 {
 	// ignore if this NPC has already been deactivated
@@ -42,8 +33,11 @@ void ASideScrollingNPC::Interaction(AActor* Interactor)
 
 	LaunchCharacter(LaunchVector, true, true);
 
-	// set up a timer to schedule reactivation
-	GetWorld()->GetTimerManager().SetTimer(DeactivationTimer, this, &ASideScrollingNPC::ResetDeactivation, DeactivationTime, false);
+	// schedule reactivation
+	if (UGameCooldownSubsystem* Cooldowns = GetWorld()->GetSubsystem<UGameCooldownSubsystem>())
+	{
+		Cooldowns->SetCooldown(DeactivationCooldown, DeactivationTime, FSimpleDelegate::CreateUObject(this, &ASideScrollingNPC::ResetDeactivation));
+	}
 }
 
 void ASideScrollingNPC::ResetDeactivation()
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "SideScrollingInteractable.h"
+#include "GameCooldownSubsystem.h"
 #include "SideScrollingNPC.generated.h"
 
 /**
@@ -37,19 +38,14 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="NPC")
 	bool bDeactivated = false;
 
-	/** Timer to reactivate the NPC */
-	FTimerHandle DeactivationTimer;
+	/** Cooldown to reactivate the NPC */
+	FGameCooldownHandle DeactivationCooldown;
 
 public:
 
 	/** Constructor */
 	ASideScrollingNPC();
 
-public:
-
-	/** Cleanup */
-	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
-
 public:
 
 //	~begin IInteractable interface 
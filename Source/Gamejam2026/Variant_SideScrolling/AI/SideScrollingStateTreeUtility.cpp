@@ -5,20 +5,25 @@
 #include "StateTreeExecutionContext.h"
 #include "StateTreeExecutionTypes.h"
 #include "AIController.h"
-#include "Kismet/GameplayStatics.h"
+#include "PlayerSnapshotSubsystem.h"
 
 EStateTreeRunStatus FStateTreeGetPlayerTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
 {
 	// get the instance data
 	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
+	// read the shared player snapshot for this frame
+	const FPlayerSnapshot* PlayerSnapshot = UPlayerSnapshotSubsystem::Get(InstanceData.Controller.Get());
+
 	// set the player pawn as the target
-	InstanceData.TargetPlayer = UGameplayStatics::GetPlayerPawn(InstanceData.Controller.Get(), 0);
+	InstanceData.TargetPlayer = PlayerSnapshot ? PlayerSnapshot->Pawn : nullptr;
 
 	// are the NPC and target valid?
 	if (IsValid(InstanceData.TargetPlayer) && IsValid(InstanceData.NPC))
 	{
-		InstanceData.bValidTarget = FVector::Distance(InstanceData.NPC->GetActorLocation(), InstanceData.TargetPlayer->GetActorLocation()) < InstanceData.RangeMax;
+		// compare squared distances to skip the square root
+		InstanceData.DistanceSquaredToTarget = PlayerSnapshot->DistSquaredTo(InstanceData.NPC->GetActorLocation());
+		InstanceData.bValidTarget = InstanceData.DistanceSquaredToTarget < FMath::Square(InstanceData.RangeMax);
 	}
 
 	return EStateTreeRunStatus::Running;
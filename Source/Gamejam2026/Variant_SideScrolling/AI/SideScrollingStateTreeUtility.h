@@ -33,6 +33,10 @@ struct FStateTreeGetPlayerInstanceData
 	UPROPERTY(VisibleAnywhere, Category="Output")
 	bool bValidTarget = false;
 
+	/** Squared distance to the target pawn */
+	UPROPERTY(VisibleAnywhere, Category="Output")
+	float DistanceSquaredToTarget = 0.0f;
+
 	/** Max distance to be considered a valid target */
 	UPROPERTY(EditAnywhere, Category="Parameter", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm"))
 	float RangeMax = 1000.0f;
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingGroundProfile.h"
+#include "Engine/World.h"
+#include "Engine/HitResult.h"
+#include "CollisionQueryParams.h"
+#include "Components/PrimitiveComponent.h"
+
+int32 FSideScrollingGroundProfileData::GetColumn(float X) const
+{
+	const int32 Column = FMath::RoundToInt((X - MinX) / ColumnSpacing);
+	return Column >= 0 && Column < GetNumColumns() ? Column : INDEX_NONE;
+}
+
+bool FSideScrollingGroundProfileData::FindGroundBelow(const FVector& Location, float MaxDepth, bool& bOutHasGround, float& OutGroundZ) const
+{
+	const int32 Column = GetColumn(Location.X);
+
+	if (Column == INDEX_NONE)
+	{
+		return false;
+	}
+
+	bOutHasGround = false;
+
+	// surfaces are sorted highest first, so the first one under the location is the ground
+	const int16* Surfaces = &Heights[Column * SurfacesPerColumn];
+
+	for (int32 i = 0; i < SurfacesPerColumn && Surfaces[i] != NoSurface; ++i)
+	{
+		const float SurfaceZ = BaseZ + Surfaces[i];
+
+		if (SurfaceZ <= Location.Z)
+		{
+			bOutHasGround = SurfaceZ >= Location.Z - MaxDepth;
+			OutGroundZ = SurfaceZ;
+			break;
+		}
+	}
+
+	return true;
+}
+
+void FSideScrollingGroundProfileData::Reset(float InMinX, float MaxX, float InColumnSpacing, float InPlaneY, float InTraceTop, float InTraceBottom, float InSurfaceClearance, int32 InSurfacesPerColumn)
+{
+	ColumnSpacing = FMath::Max(InColumnSpacing, 1.0f);
+	MinX = InMinX;
+	PlaneY = InPlaneY;
+	TraceTop = InTraceTop;
+	TraceBottom = FMath::Min(InTraceBottom, InTraceTop);
+	SurfaceClearance = FMath::Max(InSurfaceClearance, 1.0f);
+	SurfacesPerColumn = FMath::Max(InSurfacesPerColumn, 1);
+
+	// center the heights so the int16 offsets cover the traced range
+	BaseZ = FMath::RoundToFloat((TraceTop + TraceBottom) * 0.5f);
+
+	const int32 NumColumns = FMath::FloorToInt((MaxX - MinX) / ColumnSpacing) + 1;
+
+	Heights.Init(NoSurface, FMath::Max(NumColumns, 0) * SurfacesPerColumn);
+}
+
+void FSideScrollingGroundProfileData::BakeColumn(const UWorld* World, int32 Column)
+{
+	if (!World || Column < 0 || Column >= GetNumColumns())
+	{
+		return;
+	}
+
+	int16* Surfaces = &Heights[Column * SurfacesPerColumn];
+
+	for (int32 i = 0; i < SurfacesPerColumn; ++i)
+	{
+		Surfaces[i] = NoSurface;
+	}
+
+	// trace the same channel as the camera's ground check, so query-only triggers like pickups and jump pads don't count as ground
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SideScrollingGroundProfile), false);
+
+	const float X = MinX + Column * ColumnSpacing;
+	float StartZ = TraceTop;
+
+	// trace down repeatedly, skipping the clearance under each surface to find the ones below it
+	for (int32 i = 0; i < SurfacesPerColumn && StartZ > TraceBottom;)
+	{
+		FHitResult Hit;
+
+		if (!World->LineTraceSingleByChannel(Hit, FVector(X, PlaneY, StartZ), FVector(X, PlaneY, TraceBottom), ECC_Visibility, QueryParams))
+		{
+			break;
+		}
+
+		// pawns standing on the ground aren't part of it, so look through them
+		if (UPrimitiveComponent* HitComponent = Hit.GetComponent())
+		{
+			if (HitComponent->GetCollisionObjectType() == ECC_Pawn)
+			{
+				QueryParams.AddIgnoredComponent(HitComponent);
+				continue;
+			}
+		}
+
+		Surfaces[i] = static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Hit.ImpactPoint.Z - BaseZ), MIN_int16 + 1, MAX_int16));
+
+		StartZ = Hit.ImpactPoint.Z - SurfaceClearance;
+		++i;
+	}
+}
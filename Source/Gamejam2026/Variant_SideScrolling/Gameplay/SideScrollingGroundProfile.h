@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SideScrollingGroundProfile.generated.h"
+
+class UWorld;
+
+/**
+ *  Ground heights sampled in columns along the X axis of a side scrolling level.
+ *  Each column stores up to SurfacesPerColumn walkable surface heights, highest first,
+ *  as centimeter offsets from BaseZ so the whole profile stays a few kilobytes.
+ */
+USTRUCT(BlueprintType)
+struct FSideScrollingGroundProfileData
+{
+	GENERATED_BODY()
+
+	/** Marks an unused surface slot */
+	static constexpr int16 NoSurface = MIN_int16;
+
+	/** World X of the first column */
+	UPROPERTY(VisibleAnywhere, Category="Ground Profile", meta = (Units = "cm"))
+	float MinX = 0.0f;
+
+	/** Distance between columns */
+	UPROPERTY(VisibleAnywhere, Category="Ground Profile", meta = (Units = "cm"))
+	float ColumnSpacing = 25.0f;
+
+	/** World Y of the gameplay plane the columns were traced on */
+	UPROPERTY(VisibleAnywhere, Category="Ground Profile", meta = (Units = "cm"))
+	float PlaneY = 0.0f;
+
+	/** World Z the heights are relative to */
+	UPROPERTY(VisibleAnywhere, Category="Ground Profile", meta = (Units = "cm"))
+	float BaseZ = 0.0f;
+
+	/** Highest point traced down from */
+	UPROPERTY(VisibleAnywhere, Category="Ground Profile", meta = (Units = "cm"))
+	float TraceTop = 0.0f;
+
+	/** Lowest point traced down to */
+	UPROPERTY(VisibleAnywhere, Category="Ground Profile", meta = (Units = "cm"))
+	float TraceBottom = 0.0f;
+
+	/** Vertical gap skipped under each surface before looking for the next one */
+	UPROPERTY(VisibleAnywhere, Category="Ground Profile", meta = (Units = "cm"))
+	float SurfaceClearance = 100.0f;
+
+	/** Maximum number of surfaces stored per column */
+	UPROPERTY(VisibleAnywhere, Category="Ground Profile")
+	int32 SurfacesPerColumn = 4;
+
+	/** Surface heights, SurfacesPerColumn per column */
+	UPROPERTY()
+	TArray<int16> Heights;
+
+	/** Returns the number of columns */
+	int32 GetNumColumns() const { return SurfacesPerColumn > 0 ? Heights.Num() / SurfacesPerColumn : 0; }
+
+	/** Returns the column for the world X, or INDEX_NONE if it's outside the profile */
+	int32 GetColumn(float X) const;
+
+	/** Returns true if the world X falls inside the profile */
+	bool IsCovered(float X) const { return GetColumn(X) != INDEX_NONE; }
+
+	/**
+	 *  Looks for the highest surface at or below the location, no deeper than MaxDepth.
+	 *  Returns false if the location is outside the profile. bOutHasGround tells if a surface was found.
+	 */
+	bool FindGroundBelow(const FVector& Location, float MaxDepth, bool& bOutHasGround, float& OutGroundZ) const;
+
+	/** Sets up the column layout and clears every column */
+	void Reset(float InMinX, float MaxX, float InColumnSpacing, float InPlaneY, float InTraceTop, float InTraceBottom, float InSurfaceClearance, int32 InSurfacesPerColumn);
+
+	/** Traces the column against the world's static and dynamic geometry and stores its surfaces */
+	void BakeColumn(const UWorld* World, int32 Column);
+};
+
+/**
+ *  Baked ground height profile for a side scrolling level.
+ *  Generated in the editor by ASideScrollingGroundProfileVolume and used by the camera instead of ground traces.
+ */
+UCLASS(BlueprintType)
+class USideScrollingGroundProfile : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Baked ground heights */
+	UPROPERTY(VisibleAnywhere, Category="Ground Profile")
+	FSideScrollingGroundProfileData Data;
+};
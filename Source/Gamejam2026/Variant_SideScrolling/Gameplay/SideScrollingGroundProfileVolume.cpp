@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingGroundProfileVolume.h"
+#include "SideScrollingGroundProfile.h"
+#include "SideScrollingGroundSubsystem.h"
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+#include "Gamejam2026.h"
+
+ASideScrollingGroundProfileVolume::ASideScrollingGroundProfileVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// create the box. It only marks the area, so it has no collision
+	RootComponent = Box = CreateDefaultSubobject<UBoxComponent>(TEXT("Box"));
+
+	Box->SetBoxExtent(FVector(2000.0f, 100.0f, 1000.0f));
+	Box->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Box->SetCanEverAffectNavigation(false);
+}
+
+void ASideScrollingGroundProfileVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// hand the baked profile to the subsystem
+	if (USideScrollingGroundSubsystem* Ground = GetWorld()->GetSubsystem<USideScrollingGroundSubsystem>())
+	{
+		if (Profile)
+		{
+			Ground->SetProfile(Profile->Data);
+
+		} else {
+
+			UE_LOG(LogGamejam2026, Warning, TEXT("Ground profile volume %s has no profile asset. The camera will fall back to ground traces"), *GetName());
+		}
+	}
+}
+
+#if WITH_EDITOR
+
+void ASideScrollingGroundProfileVolume::BakeProfile()
+{
+	if (!Profile)
+	{
+		UE_LOG(LogGamejam2026, Warning, TEXT("Ground profile volume %s has no profile asset to bake into"), *GetName());
+		return;
+	}
+
+	// the profile is axis aligned, so only the box bounds matter
+	const FBox Bounds = Box->Bounds.GetBox();
+
+	// heights are stored as 16 bit centimeter offsets from the middle of the box, so anything further out gets clamped
+	if (Bounds.GetExtent().Z > MAX_int16)
+	{
+		UE_LOG(LogGamejam2026, Warning, TEXT("Ground profile volume %s is %.0f cm tall. Surfaces more than %d cm above or below its center will be clamped"),
+			*GetName(), Bounds.GetSize().Z, MAX_int16);
+	}
+
+	Profile->Modify();
+
+	FSideScrollingGroundProfileData& Data = Profile->Data;
+	Data.Reset(Bounds.Min.X, Bounds.Max.X, ColumnSpacing, GetActorLocation().Y, Bounds.Max.Z, Bounds.Min.Z, SurfaceClearance, SurfacesPerColumn);
+
+	for (int32 Column = 0; Column < Data.GetNumColumns(); ++Column)
+	{
+		Data.BakeColumn(GetWorld(), Column);
+	}
+
+	Profile->MarkPackageDirty();
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Baked ground profile %s: %d columns, %.1f KB"),
+		*Profile->GetName(), Data.GetNumColumns(), Data.Heights.GetAllocatedSize() / 1024.0f);
+}
+
+#endif
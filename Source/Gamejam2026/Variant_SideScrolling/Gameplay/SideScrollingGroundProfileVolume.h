@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SideScrollingGroundProfileVolume.generated.h"
+
+class UBoxComponent;
+class USideScrollingGroundProfile;
+
+/**
+ *  Defines the part of a side scrolling level covered by a ground profile.
+ *  The box's X and Z extents set the traced range, and its Y location sets the gameplay plane.
+ *  The profile is baked in the editor from the level's collision, and handed to the ground subsystem at runtime.
+ */
+UCLASS()
+class ASideScrollingGroundProfileVolume : public AActor
+{
+	GENERATED_BODY()
+
+	/** Area covered by the profile */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UBoxComponent> Box;
+
+protected:
+
+	/** Asset the profile is baked into */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ground Profile")
+	TObjectPtr<USideScrollingGroundProfile> Profile;
+
+	/** Distance between baked columns */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ground Profile", meta = (ClampMin = 5, ClampMax = 500, Units = "cm"))
+	float ColumnSpacing = 25.0f;
+
+	/** Maximum number of stacked surfaces stored per column */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ground Profile", meta = (ClampMin = 1, ClampMax = 16))
+	int32 SurfacesPerColumn = 4;
+
+	/** Vertical gap skipped under each surface before looking for the next one. Should be about the thickness of the level's platforms */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ground Profile", meta = (ClampMin = 1, ClampMax = 1000, Units = "cm"))
+	float SurfaceClearance = 100.0f;
+
+public:
+
+	/** Constructor */
+	ASideScrollingGroundProfileVolume();
+
+	/** Returns the profile asset */
+	USideScrollingGroundProfile* GetProfile() const { return Profile; }
+
+protected:
+
+	/** Registers the profile with the ground subsystem */
+	virtual void BeginPlay() override;
+
+#if WITH_EDITOR
+
+	/** Traces the level's collision inside the box and stores the result in the profile asset */
+	UFUNCTION(CallInEditor, Category="Ground Profile")
+	void BakeProfile();
+
+#endif
+};
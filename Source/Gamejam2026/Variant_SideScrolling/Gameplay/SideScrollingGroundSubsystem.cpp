@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingGroundSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Gamejam2026.h"
+
+static int32 GSideScrollingGroundRefreshColumnsPerFrame = 16;
+static FAutoConsoleVariableRef CVarSideScrollingGroundRefreshColumnsPerFrame(
+	TEXT("SideScrolling.Ground.RefreshColumnsPerFrame"),
+	GSideScrollingGroundRefreshColumnsPerFrame,
+	TEXT("Maximum number of dirty ground profile columns re-traced each frame"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithWorld SideScrollingGroundStatsCommand(
+	TEXT("SideScrolling.Ground.Stats"),
+	TEXT("Logs the ground profile size and the number of dirty columns"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (USideScrollingGroundSubsystem* Ground = World ? World->GetSubsystem<USideScrollingGroundSubsystem>() : nullptr)
+		{
+			Ground->DumpStats();
+		}
+	})
+);
+
+void USideScrollingGroundSubsystem::SetProfile(const FSideScrollingGroundProfileData& InProfile)
+{
+	if (bHasProfile)
+	{
+		UE_LOG(LogGamejam2026, Warning, TEXT("Side scrolling ground subsystem already has a profile. Only one ground profile volume is supported per level"));
+	}
+
+	Profile = InProfile;
+	bHasProfile = Profile.GetNumColumns() > 0;
+
+	DirtyQueue.Reset();
+	DirtyColumns.Init(false, Profile.GetNumColumns());
+	RefreshedColumns = 0;
+}
+
+bool USideScrollingGroundSubsystem::FindGroundBelow(const FVector& Location, float MaxDepth, bool& bOutHasGround, float& OutGroundZ) const
+{
+	return bHasProfile && Profile.FindGroundBelow(Location, MaxDepth, bOutHasGround, OutGroundZ);
+}
+
+void USideScrollingGroundSubsystem::MarkDirty(float MinX, float MaxX)
+{
+	if (!bHasProfile)
+	{
+		return;
+	}
+
+	// clamp the range to the profile
+	const int32 NumColumns = Profile.GetNumColumns();
+	const int32 FirstColumn = FMath::Max(FMath::FloorToInt((MinX - Profile.MinX) / Profile.ColumnSpacing), 0);
+	const int32 LastColumn = FMath::Min(FMath::CeilToInt((MaxX - Profile.MinX) / Profile.ColumnSpacing), NumColumns - 1);
+
+	for (int32 Column = FirstColumn; Column <= LastColumn; ++Column)
+	{
+		if (!DirtyColumns[Column])
+		{
+			DirtyColumns[Column] = true;
+			DirtyQueue.Add(Column);
+		}
+	}
+
+	// wake up the refresh
+	if (DirtyQueue.Num() > 0)
+	{
+		RefreshTickFunction.SetTickFunctionEnable(true);
+	}
+}
+
+void USideScrollingGroundSubsystem::DumpStats() const
+{
+	UE_LOG(LogGamejam2026, Log, TEXT("Side scrolling ground: %d columns, %d surfaces per column, %.1f KB"),
+		Profile.GetNumColumns(), Profile.SurfacesPerColumn, Profile.Heights.GetAllocatedSize() / 1024.0f);
+
+	UE_LOG(LogGamejam2026, Log, TEXT("Side scrolling ground: %d dirty columns, %d columns refreshed"),
+		DirtyQueue.Num(), RefreshedColumns);
+}
+
+bool USideScrollingGroundSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USideScrollingGroundSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// refresh after physics so moved platforms are at their final location for the frame
+	RefreshTickFunction.OnTick.BindUObject(this, &USideScrollingGroundSubsystem::RefreshColumns);
+	RefreshTickFunction.Register(&InWorld, TG_PostPhysics, false, TEXT("SideScrollingGround"));
+
+	// only tick while there are dirty columns
+	RefreshTickFunction.SetTickFunctionEnable(DirtyQueue.Num() > 0);
+}
+
+void USideScrollingGroundSubsystem::Deinitialize()
+{
+	RefreshTickFunction.Unregister();
+
+	DirtyQueue.Empty();
+	DirtyColumns.Empty();
+
+	Super::Deinitialize();
+}
+
+void USideScrollingGroundSubsystem::RefreshColumns(float DeltaTime)
+{
+	const int32 NumToRefresh = FMath::Min(FMath::Max(GSideScrollingGroundRefreshColumnsPerFrame, 1), DirtyQueue.Num());
+
+	// re-trace the oldest dirty columns first
+	for (int32 i = 0; i < NumToRefresh; ++i)
+	{
+		const int32 Column = DirtyQueue[i];
+
+		Profile.BakeColumn(GetWorld(), Column);
+		DirtyColumns[Column] = false;
+	}
+
+	DirtyQueue.RemoveAt(0, NumToRefresh, EAllowShrinking::No);
+	RefreshedColumns += NumToRefresh;
+
+	// go back to sleep once everything is up to date
+	if (DirtyQueue.Num() == 0)
+	{
+		RefreshTickFunction.SetTickFunctionEnable(false);
+	}
+}
@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameWorldTickFunction.h"
+#include "SideScrollingGroundProfile.h"
+#include "SideScrollingGroundSubsystem.generated.h"
+
+/**
+ *  Answers ground height queries for a side scrolling level from its baked ground profile.
+ *  Lookups are a single column read instead of a physics trace. Columns affected by moving geometry
+ *  are marked dirty and re-traced in the background, a few per frame.
+ */
+UCLASS()
+class USideScrollingGroundSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Runtime copy of the baked profile, so refreshed columns don't touch the asset */
+	FSideScrollingGroundProfileData Profile;
+
+	/** If true, a profile has been set for this world */
+	bool bHasProfile = false;
+
+	/** Columns waiting to be re-traced */
+	TArray<int32> DirtyQueue;
+
+	/** Columns already in the dirty queue */
+	TBitArray<> DirtyColumns;
+
+	/** Number of columns re-traced since the profile was set */
+	int32 RefreshedColumns = 0;
+
+	/** Tick function that re-traces the dirty columns */
+	FGameWorldTickFunction RefreshTickFunction;
+
+public:
+
+	/** Sets the profile used for lookups */
+	void SetProfile(const FSideScrollingGroundProfileData& InProfile);
+
+	/** Returns true if a profile covers the world X */
+	bool IsCovered(float X) const { return bHasProfile && Profile.IsCovered(X); }
+
+	/**
+	 *  Looks for the highest ground at or below the location, no deeper than MaxDepth.
+	 *  Returns false if no profile covers the location, in which case the caller should trace instead.
+	 */
+	bool FindGroundBelow(const FVector& Location, float MaxDepth, bool& bOutHasGround, float& OutGroundZ) const;
+
+	/** Queues the columns in the world X range to be re-traced */
+	void MarkDirty(float MinX, float MaxX);
+
+	/** Writes the profile size and refresh state to the log */
+	void DumpStats() const;
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the refresh tick */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Re-traces dirty columns up to the per-frame budget */
+	void RefreshColumns(float DeltaTime);
+};
@@ -2,16 +2,77 @@
 
 
 #include "SideScrollingMovingPlatform.h"
+#include "SideScrollingGroundSubsystem.h"
 #include "Components/SceneComponent.h"
+#include "Engine/World.h"
 
 ASideScrollingMovingPlatform::ASideScrollingMovingPlatform()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	// only tick while moving, to keep the ground profile up to date. Movement wakes the tick up
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// create the root comp
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
 }
 
+void ASideScrollingMovingPlatform::BeginPlay()
+{
+	Super::BeginPlay();
+
+	LastGroundBounds = GetComponentsBoundingBox();
+
+	// BP may move the platform through timelines, resets or direct calls, so watch the root instead of the interaction
+	TransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(this, &ASideScrollingMovingPlatform::OnRootTransformUpdated);
+}
+
+void ASideScrollingMovingPlatform::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	RootComponent->TransformUpdated.Remove(TransformUpdatedHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ASideScrollingMovingPlatform::OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	// LastGroundBounds still holds where the platform last settled, so the tick refreshes both ends
+	StillTime = 0.0f;
+
+	if (!IsActorTickEnabled())
+	{
+		SetActorTickEnabled(true);
+	}
+}
+
+void ASideScrollingMovingPlatform::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const FBox Bounds = GetComponentsBoundingBox();
+
+	if (!Bounds.Equals(LastGroundBounds))
+	{
+		// refresh the ground both where the platform was and where it is now
+		if (USideScrollingGroundSubsystem* Ground = GetWorld()->GetSubsystem<USideScrollingGroundSubsystem>())
+		{
+			const FBox Swept = Bounds + LastGroundBounds;
+			Ground->MarkDirty(Swept.Min.X, Swept.Max.X);
+		}
+
+		LastGroundBounds = Bounds;
+		StillTime = 0.0f;
+		return;
+	}
+
+	// stop ticking once the platform has settled. Moving it again wakes the tick back up
+	StillTime += DeltaTime;
+
+	if (StillTime >= 0.5f)
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
 void ASideScrollingMovingPlatform::Interaction(AActor* Interactor)
 {
 	// ignore interactions if we're already moving
@@ -10,6 +10,7 @@
 /**
  *  Simple moving platform that can be triggered through interactions by other actors.
  *  The actual movement is performed by Blueprint code through latent execution nodes.
+ *  Whenever the platform moves, the columns of the ground profile it passes over are queued for a refresh.
  */
 UCLASS(abstract)
 class ASideScrollingMovingPlatform : public AActor, public ISideScrollingInteractable
@@ -21,6 +22,20 @@ public:
 	/** Constructor */
 	ASideScrollingMovingPlatform();
 
+	/** Refreshes the ground profile under the platform while it moves */
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+
+	/** Starts tracking the platform's movement */
+	virtual void BeginPlay() override;
+
+	/** Stops tracking the platform's movement */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Wakes up the ground profile refresh whenever the platform moves, however it was moved */
+	void OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
 protected:
 
 	/** If this is true, the platform is mid-movement and will ignore further interactions */
@@ -38,6 +53,15 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Moving Platform")
 	bool bOneShot = false;
 
+	/** Bounds the ground profile was last refreshed for */
+	FBox LastGroundBounds;
+
+	/** Time the platform has been still since it last moved */
+	float StillTime = 0.0f;
+
+	/** Handle to the root's transform updated delegate */
+	FDelegateHandle TransformUpdatedHandle;
+
 public:
 
 // ~begin IInteractable interface 
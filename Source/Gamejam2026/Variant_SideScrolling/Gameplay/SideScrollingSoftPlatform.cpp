@@ -2,14 +2,14 @@
 
 
 #include "SideScrollingSoftPlatform.h"
+#include "SideScrollingSoftPlatformSubsystem.h"
 #include "Components/SceneComponent.h"
 #include "Components/StaticMeshComponent.h"
-#include "Components/BoxComponent.h"
-#include "SideScrollingCharacter.h"
+#include "Engine/World.h"
 
 ASideScrollingSoftPlatform::ASideScrollingSoftPlatform()
 {
- 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	// create the root component
 	RootComponent = Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
@@ -21,39 +21,25 @@ ASideScrollingSoftPlatform::ASideScrollingSoftPlatform()
 	Mesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 	Mesh->SetCollisionObjectType(ECC_WorldStatic);
 	Mesh->SetCollisionResponseToAllChannels(ECR_Block);
-
-	// create the collision check box
-	CollisionCheckBox = CreateDefaultSubobject<UBoxComponent>(TEXT("Collision Check Box"));
-	CollisionCheckBox->SetupAttachment(Mesh);
-
-	CollisionCheckBox->SetRelativeLocation(FVector(0.0f, 0.0f, -40.0f));
-	CollisionCheckBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-	CollisionCheckBox->SetCollisionObjectType(ECC_WorldDynamic);
-	CollisionCheckBox->SetCollisionResponseToAllChannels(ECR_Ignore);
-	CollisionCheckBox->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
-
-	// subscribe to the overlap events
-	CollisionCheckBox->OnComponentBeginOverlap.AddDynamic(this, &ASideScrollingSoftPlatform::OnSoftCollisionOverlap);
 }
 
-void ASideScrollingSoftPlatform::OnSoftCollisionOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void ASideScrollingSoftPlatform::BeginPlay()
 {
-	// have we overlapped a character?
-	if (ASideScrollingCharacter* Char = Cast<ASideScrollingCharacter>(OtherActor))
+	Super::BeginPlay();
+
+	// let character movement know this mesh can be passed through
+	if (USideScrollingSoftPlatformSubsystem* SoftPlatforms = GetWorld()->GetSubsystem<USideScrollingSoftPlatformSubsystem>())
 	{
-		// disable the soft collision channel
-		Char->SetSoftCollision(true);
+		SoftPlatforms->RegisterPlatform(Mesh);
 	}
 }
 
-void ASideScrollingSoftPlatform::NotifyActorEndOverlap(AActor* OtherActor)
+void ASideScrollingSoftPlatform::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
-	Super::NotifyActorEndOverlap(OtherActor);
+	Super::EndPlay(EndPlayReason);
 
-	// have we overlapped a character?
-	if (ASideScrollingCharacter* Char = Cast<ASideScrollingCharacter>(OtherActor))
+	if (USideScrollingSoftPlatformSubsystem* SoftPlatforms = GetWorld()->GetSubsystem<USideScrollingSoftPlatformSubsystem>())
 	{
-		// enable the soft collision channel
-		Char->SetSoftCollision(false);
+		SoftPlatforms->UnregisterPlatform(Mesh);
 	}
 }
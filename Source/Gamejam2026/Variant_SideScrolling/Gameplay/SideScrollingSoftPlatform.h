@@ -8,10 +8,11 @@
 
 class USceneComponent;
 class UStaticMeshComponent;
-class UBoxComponent;
 
 /**
  *  A side scrolling game platform that the character can jump or drop through.
+ *  The platform only registers its mesh with the soft platform subsystem.
+ *  Pass-through is resolved by USideScrollingCharacterMovementComponent during the character's movement.
  */
 UCLASS(abstract)
 class ASideScrollingSoftPlatform : public AActor
@@ -26,10 +27,6 @@ class ASideScrollingSoftPlatform : public AActor
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* Mesh;
 
-	/** Collision volume that toggles soft collision on the character when they're below the platform. */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
-	UBoxComponent* CollisionCheckBox;
-
 public:	
 	
 	/** Constructor */
@@ -37,10 +34,9 @@ public:
 
 protected:
 
-	/** Handles soft collision check box overlaps */
-	UFUNCTION()
-	void OnSoftCollisionOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	/** Registers the platform mesh */
+	virtual void BeginPlay() override;
 
-	/** Restores soft collision state when overlap ends */
-	virtual void NotifyActorEndOverlap(AActor* OtherActor) override;
+	/** Unregisters the platform mesh */
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 };
@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingSoftPlatformSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+
+void USideScrollingSoftPlatformSubsystem::RegisterPlatform(UPrimitiveComponent* Platform)
+{
+	if (Platform)
+	{
+		Platforms.AddUnique(Platform);
+	}
+}
+
+void USideScrollingSoftPlatformSubsystem::UnregisterPlatform(UPrimitiveComponent* Platform)
+{
+	Platforms.RemoveSwap(Platform);
+}
+
+bool USideScrollingSoftPlatformSubsystem::IsSoftPlatform(const UPrimitiveComponent* Component) const
+{
+	return Component && Platforms.Contains(Component);
+}
+
+void USideScrollingSoftPlatformSubsystem::GatherPlatforms(const FBox& Box, TArray<UPrimitiveComponent*>& OutPlatforms) const
+{
+	for (const TWeakObjectPtr<UPrimitiveComponent>& PlatformPtr : Platforms)
+	{
+		UPrimitiveComponent* Platform = PlatformPtr.Get();
+
+		// component bounds are kept up to date by the component itself, so this is just a box test
+		if (Platform && Platform->Bounds.GetBox().Intersect(Box))
+		{
+			OutPlatforms.Add(Platform);
+		}
+	}
+}
+
+bool USideScrollingSoftPlatformSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
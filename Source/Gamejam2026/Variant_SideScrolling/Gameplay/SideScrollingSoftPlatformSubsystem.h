@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SideScrollingSoftPlatformSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ *  Keeps track of the soft platform colliders in the world,
+ *  so character movement can find the ones near it without overlap events or traces
+ */
+UCLASS()
+class USideScrollingSoftPlatformSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Registered platform colliders */
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> Platforms;
+
+public:
+
+	/** Adds a platform collider */
+	void RegisterPlatform(UPrimitiveComponent* Platform);
+
+	/** Removes a platform collider */
+	void UnregisterPlatform(UPrimitiveComponent* Platform);
+
+	/** Returns true if the component is a registered platform collider */
+	bool IsSoftPlatform(const UPrimitiveComponent* Component) const;
+
+	/** Adds the platform colliders whose bounds overlap the box to the list */
+	void GatherPlatforms(const FBox& Box, TArray<UPrimitiveComponent*>& OutPlatforms) const;
+
+protected:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};
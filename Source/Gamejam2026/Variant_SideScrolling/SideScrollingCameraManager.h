@@ -3,21 +3,17 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Camera/PlayerCameraManager.h"
+#include "GameCameraManager.h"
 #include "SideScrollingCameraManager.generated.h"
 
 /**
- *  Simple side scrolling camera with smooth scrolling and horizontal bounds
+ *  Side scrolling camera manager.
+ *  Uses a USideScrollingCameraMode configured from the properties below unless a default mode asset is set.
  */
 UCLASS()
-class ASideScrollingCameraManager : public APlayerCameraManager
+class ASideScrollingCameraManager : public AGameCameraManager
 {
 	GENERATED_BODY()
-	
-public:
-
-	/** Overrides the default camera view target calculation */
-	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
 
 public:
 
@@ -37,11 +33,12 @@ public:
 	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
 	float CameraXMaxBounds = 10000.0f;
 
-protected:
+	/** How far below the target to look for ground while it moves vertically. The camera holds its height while ground is in range */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float GroundCheckDepth = 1000.0f;
 
-	/** Last cached camera vertical location. The camera only adjusts its height if necessary. */
-	float CurrentZ = 0.0f;
+protected:
 
-	/** First-time update camera setup flag */
-	bool bSetup = true;
+	/** Creates a side scrolling mode from the properties above */
+	virtual UGameCameraMode* CreateFallbackMode() override;
 };
@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingCameraMode.h"
+#include "SideScrollingGroundSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/HitResult.h"
+#include "CollisionQueryParams.h"
+#include "Engine/World.h"
+
+USideScrollingCameraMode::USideScrollingCameraMode()
+{
+	FieldOfView = 65.0f;
+}
+
+void USideScrollingCameraMode::OnActivated(AActor* ViewTarget, const FGameCameraView& CurrentView)
+{
+	bSetup = true;
+}
+
+void USideScrollingCameraMode::UpdateView(AActor* ViewTarget, float DeltaTime, FGameCameraView& OutView)
+{
+	// set the view FOV and rotation
+	OutView.Rotation = ViewRotation;
+	OutView.FOV = FieldOfView;
+
+	if (!ViewTarget)
+	{
+		OutView.Location = CameraLocation;
+		return;
+	}
+
+	// cache the current location
+	const FVector CurrentActorLocation = ViewTarget->GetActorLocation();
+
+	// calculate the "zoom distance" - in reality the distance we want to keep to the target
+	const float CurrentY = Distance + CurrentActorLocation.Y;
+
+	// do first-time setup
+	if (bSetup)
+	{
+		// lower the setup flag
+		bSetup = false;
+
+		// initialize the camera viewpoint and return
+		CameraLocation = FVector(CurrentActorLocation.X, CurrentY, CurrentActorLocation.Z + HeightOffset);
+
+		// save the current camera height
+		CurrentZ = CameraLocation.Z;
+
+		OutView.Location = CameraLocation;
+		return;
+	}
+
+	// check if the camera needs to update its height
+	bool bZUpdate = false;
+
+	// is the target moving vertically?
+	if (FMath::IsNearlyZero(ViewTarget->GetVelocity().Z))
+	{
+		// determine if we need to do a height update
+		bZUpdate = FMath::IsNearlyEqual(CurrentZ, CameraLocation.Z, HeightSettleTolerance);
+
+	} else {
+
+		// look up the ground below the target in the baked profile
+		bool bHasGround = false;
+		float GroundZ = 0.0f;
+
+		UWorld* World = ViewTarget->GetWorld();
+		const USideScrollingGroundSubsystem* Ground = World->GetSubsystem<USideScrollingGroundSubsystem>();
+
+		if (Ground && Ground->FindGroundBelow(CurrentActorLocation, GroundCheckDepth, bHasGround, GroundZ))
+		{
+			// only update height if we're not about to hit ground
+			bZUpdate = !bHasGround;
+
+		} else {
+
+			// no profile covers the target, so run a trace below it instead
+			FHitResult OutHit;
+
+			const FVector End = CurrentActorLocation + FVector(0.0f, 0.0f, -GroundCheckDepth);
+
+			FCollisionQueryParams QueryParams;
+			QueryParams.AddIgnoredActor(ViewTarget);
+
+			// only update height if we're not about to hit ground
+			bZUpdate = !World->LineTraceSingleByChannel(OutHit, CurrentActorLocation, End, ECC_Visibility, QueryParams);
+		}
+
+	}
+
+	// do we need to do a height update?
+	if (bZUpdate)
+	{
+
+		// set the height goal from the actor location
+		CurrentZ = CurrentActorLocation.Z;
+
+	} else {
+
+		// are we close enough to the target height?
+		if (FMath::IsNearlyEqual(CurrentZ, CurrentActorLocation.Z, HeightSnapDistance))
+		{
+			// set the height goal from the actor location
+			CurrentZ = CurrentActorLocation.Z;
+
+		} else {
+
+			// blend the height towards the actor location
+			CurrentZ = FMath::FInterpTo(CurrentZ, CurrentActorLocation.Z, DeltaTime, HeightInterpSpeed);
+
+		}
+
+	}
+
+	// clamp the X axis to the min and max camera bounds
+	const float CurrentX = FMath::Clamp(CurrentActorLocation.X, MinX, MaxX);
+
+	// blend towards the new camera location and update the output
+	const FVector TargetCameraLocation(CurrentX, CurrentY, CurrentZ);
+
+	CameraLocation = FMath::VInterpTo(CameraLocation, TargetCameraLocation, DeltaTime, FollowInterpSpeed);
+
+	OutView.Location = CameraLocation;
+}
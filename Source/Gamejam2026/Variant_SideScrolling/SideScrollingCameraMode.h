@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCameraMode.h"
+#include "SideScrollingCameraMode.generated.h"
+
+/**
+ *  Side scrolling camera with smooth scrolling and horizontal bounds.
+ *  The camera only changes height when the target settles at a new height or falls without ground below it.
+ *  Ground below the target is looked up in the level's baked ground profile, falling back to a trace outside of it.
+ */
+UCLASS(meta = (DisplayName = "Side Scrolling"))
+class USideScrollingCameraMode : public UGameCameraMode
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Fixed camera rotation */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera")
+	FRotator ViewRotation = FRotator(0.0f, -90.0f, 0.0f);
+
+	/** How close we want to stay to the view target */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float Distance = 1000.0f;
+
+	/** How far above the target do we want the camera to focus */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float HeightOffset = 100.0f;
+
+	/** Minimum camera scrolling bounds in world space */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
+	float MinX = -400.0f;
+
+	/** Maximum camera scrolling bounds in world space */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
+	float MaxX = 10000.0f;
+
+	/** How far below the target to look for ground while it moves vertically. The camera holds its height while ground is in range */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float GroundCheckDepth = 1000.0f;
+
+	/** How close the camera needs to be to its height goal before following a grounded target to a new height */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=1000, Units="cm"))
+	float HeightSettleTolerance = 25.0f;
+
+	/** Height differences below this snap the height goal to the target instead of blending it */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=1000, Units="cm"))
+	float HeightSnapDistance = 100.0f;
+
+	/** How quickly the height goal blends towards the target */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=100))
+	float HeightInterpSpeed = 2.0f;
+
+	/** How quickly the camera follows its goal */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=100))
+	float FollowInterpSpeed = 2.0f;
+
+protected:
+
+	/** Last camera location computed by this mode */
+	FVector CameraLocation = FVector::ZeroVector;
+
+	/** Last cached camera vertical location. The camera only adjusts its height if necessary. */
+	float CurrentZ = 0.0f;
+
+	/** First-time update camera setup flag */
+	bool bSetup = true;
+
+public:
+
+	/** Constructor */
+	USideScrollingCameraMode();
+
+	/** Snaps to the target on the next update */
+	virtual void OnActivated(AActor* ViewTarget, const FGameCameraView& CurrentView) override;
+
+	/** Computes the scrolling view */
+	virtual void UpdateView(AActor* ViewTarget, float DeltaTime, FGameCameraView& OutView) override;
+};
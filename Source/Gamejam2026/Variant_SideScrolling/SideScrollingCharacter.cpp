@@ -2,7 +2,7 @@
 
 
 #include "SideScrollingCharacter.h"
-#include "GameFramework/CharacterMovementComponent.h"
+#include "SideScrollingCharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Components/InputComponent.h"
@@ -11,10 +11,9 @@
 #include "InputAction.h"
 #include "Engine/World.h"
 #include "SideScrollingInteractable.h"
-#include "Kismet/KismetMathLibrary.h"
-#include "TimerManager.h"
 
-ASideScrollingCharacter::ASideScrollingCharacter()
+ASideScrollingCharacter::ASideScrollingCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<USideScrollingCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
 	PrimaryActorTick.bCanEverTick = true;
 
@@ -55,18 +54,15 @@ ASideScrollingCharacter::ASideScrollingCharacter()
 	GetCharacterMovement()->SetPlaneConstraintNormal(FVector(0.0f, 1.0f, 0.0f));
 	GetCharacterMovement()->bConstrainToPlane = true;
 
+	// configure the wall jump. The side scroller keeps the player's input locked for longer
+	GetSideScrollingMovement()->WallJumpHorizontalSpeed = 500.0f;
+	GetSideScrollingMovement()->WallJumpVerticalSpeed = 1050.0f;
+	GetSideScrollingMovement()->WallJumpLockTime = 0.3f;
+
 	// enable double jump and coyote time
 	JumpMaxCount = 3;
 }
 
-void ASideScrollingCharacter::EndPlay(EEndPlayReason::Type EndPlayReason)
-{
-	Super::EndPlay(EndPlayReason);
-
-	// clear the wall jump timer
-	GetWorld()->GetTimerManager().ClearTimer(WallJumpTimer);
-}
-
 void ASideScrollingCharacter::SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -125,8 +121,9 @@ void ASideScrollingCharacter::OnMovementModeChanged(EMovementMode PrevMovementMo
 {
 	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
 
-	// are we falling?
-	if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Falling)
+	// have we walked off a ledge or dropped through a platform? Jumps also leave walking for falling, but with the jump input still pressed.
+	// Wall jumps leave a custom mode, so they don't count towards coyote time either
+	if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Falling && PrevMovementMode == EMovementMode::MOVE_Walking && !bPressedJump)
 	{
 		// save the game time when we started falling, so we can check it later for coyote time jumps
 		LastFallTime = GetWorld()->GetTimeSeconds();
@@ -156,7 +153,7 @@ void ASideScrollingCharacter::DropReleased(const FInputActionValue& Value)
 void ASideScrollingCharacter::DoMove(float Forward)
 {
 	// is movement temporarily disabled after wall jumping?
-	if (!bHasWallJumped)
+	if (!GetSideScrollingMovement()->IsWallJumping())
 	{
 		// save the movement values
 		ActionValueY = Forward;
@@ -220,7 +217,7 @@ void ASideScrollingCharacter::MultiJump()
 	// does the user want to drop to a lower platform?
 	if (DropValue > 0.0f)
 	{
-		CheckForSoftCollision();
+		DropFromPlatform();
 		return;
 	}
 
@@ -234,109 +231,52 @@ void ASideScrollingCharacter::MultiJump()
 		return;
 	}
 
-	// if we have a horizontal input, try for wall jump first
-	if (!bHasWallJumped && !FMath::IsNearlyZero(ActionValueY))
+	// ignore jumps during the wall jump lockout
+	if (GetSideScrollingMovement()->IsWallJumping())
 	{
-		// trace ahead of the character for walls
-		FHitResult OutHit;
-
-		const FVector Start = GetActorLocation();
-		const FVector End = Start + (FVector(ActionValueY > 0.0f ? 1.0f : -1.0f, 0.0f, 0.0f) * WallJumpTraceDistance);
-
-		FCollisionQueryParams QueryParams;
-		QueryParams.AddIgnoredActor(this);
-
-		GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECC_Visibility, QueryParams);
+		return;
+	}
 
-		if (OutHit.bBlockingHit)
+	// if we have a horizontal input, try for wall jump first
+	if (!FMath::IsNearlyZero(ActionValueY))
+	{
+		// the movement component jumps off the wall we've been pushing into
+		if (GetSideScrollingMovement()->WallJump(FVector(ActionValueY > 0.0f ? 1.0f : -1.0f, 0.0f, 0.0f)))
 		{
-			// rotate to the bounce direction
-			const FRotator BounceRot = UKismetMathLibrary::MakeRotFromX(OutHit.ImpactNormal);
-			SetActorRotation(FRotator(0.0f, BounceRot.Yaw, 0.0f));
-
-			// calculate the impulse vector
-			FVector WallJumpImpulse = OutHit.ImpactNormal * WallJumpHorizontalImpulse;
-			WallJumpImpulse.Z = GetCharacterMovement()->JumpZVelocity * WallJumpVerticalMultiplier;
-
-			// launch the character away from the wall
-			LaunchCharacter(WallJumpImpulse, true, true);
-
-			// enable wall jump lockout for a bit
-			bHasWallJumped = true;
-
-			// schedule wall jump lockout reset
-			GetWorld()->GetTimerManager().SetTimer(WallJumpTimer, this, &ASideScrollingCharacter::ResetWallJump, DelayBetweenWallJumps, false);
-
 			return;
 		}
 	}
 
+	// are we still within coyote time frames?
+	if (GetWorld()->GetTimeSeconds() - LastFallTime < MaxCoyoteTime)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Coyote Jump"));
 
+		// use the built-in CMC functionality to do the jump
+		Jump();
 
-	// test for double jump only if we haven't already tested for wall jump
-	if (!bHasWallJumped)
-	{
-		// are we still within coyote time frames?
-		if (GetWorld()->GetTimeSeconds() - LastFallTime < MaxCoyoteTime)
+	// no coyote time jump
+	} else {
+	
+		// The movement component handles double jump but we still need to manage the flag for animation
+		if (!bHasDoubleJumped)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Coyote Jump"));
+			// raise the double jump flag
+			bHasDoubleJumped = true;
 
-			// use the built-in CMC functionality to do the jump
+			// let the CMC handle jump
 			Jump();
-
-		// no coyote time jump
-		} else {
-		
-			// The movement component handles double jump but we still need to manage the flag for animation
-			if (!bHasDoubleJumped)
-			{
-				// raise the double jump flag
-				bHasDoubleJumped = true;
-
-				// let the CMC handle jump
-				Jump();
-			}
 		}
 	}
 }
 
-void ASideScrollingCharacter::CheckForSoftCollision()
+void ASideScrollingCharacter::DropFromPlatform()
 {
 	// reset the drop value
 	DropValue = 0.0f;
 
-	// trace down 
-	FHitResult OutHit;
-
-	const FVector Start = GetActorLocation();
-	const FVector End = Start + (FVector::DownVector * SoftCollisionTraceDistance);
-
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(SoftCollisionObjectType);
-
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-
-	GetWorld()->LineTraceSingleByObjectType(OutHit, Start, End, ObjectParams, QueryParams);
-
-	// did we hit a soft floor?
-	if (OutHit.GetActor())
-	{
-		// drop through the floor
-		SetSoftCollision(true);
-	}
-}
-
-void ASideScrollingCharacter::ResetWallJump()
-{
-	// reset the wall jump flag
-	bHasWallJumped = false;
-}
-
-void ASideScrollingCharacter::SetSoftCollision(bool bEnabled)
-{
-	// enable or disable collision response to the soft collision channel
-	GetCapsuleComponent()->SetCollisionResponseToChannel(SoftCollisionObjectType, bEnabled ? ECR_Ignore : ECR_Block);
+	// let the movement component drop us through the floor, if it's a soft platform
+	GetSideScrollingMovement()->DropThroughPlatform();
 }
 
 bool ASideScrollingCharacter::HasDoubleJumped() const
@@ -346,5 +286,10 @@ bool ASideScrollingCharacter::HasDoubleJumped() const
 
 bool ASideScrollingCharacter::HasWallJumped() const
 {
-	return bHasWallJumped;
+	return GetSideScrollingMovement()->IsWallJumping();
+}
+
+USideScrollingCharacterMovementComponent* ASideScrollingCharacter::GetSideScrollingMovement() const
+{
+	return CastChecked<USideScrollingCharacterMovementComponent>(GetCharacterMovement());
 }
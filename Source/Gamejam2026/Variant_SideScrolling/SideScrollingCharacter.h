@@ -8,6 +8,7 @@
 
 class UCameraComponent;
 class UInputAction;
+class USideScrollingCharacterMovementComponent;
 struct FInputActionValue;
 
 /**
@@ -48,30 +49,6 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Side Scrolling|Interaction")
 	float InteractionRadius = 200.0f;
 
-	/** Time to disable input after a wall jump to preserve momentum */
-	UPROPERTY(EditAnywhere, Category="Side Scrolling|Wall Jump")
-	float DelayBetweenWallJumps = 0.3f;
-
-	/** Distance to trace ahead of the character for wall jumps */
-	UPROPERTY(EditAnywhere, Category="Side Scrolling|Wall Jump")
-	float WallJumpTraceDistance = 50.0f;
-
-	/** Horizontal impulse to apply to the character during wall jumps */
-	UPROPERTY(EditAnywhere, Category="Side Scrolling|Wall Jump")
-	float WallJumpHorizontalImpulse = 500.0f;
-
-	/** Multiplies the jump Z velocity for wall jumps. */
-	UPROPERTY(EditAnywhere, Category="Side Scrolling|Wall Jump")
-	float WallJumpVerticalMultiplier = 1.4f;
-
-	/** Collision object type to use for soft collision traces (dropping down floors) */
-	UPROPERTY(EditAnywhere, Category="Side Scrolling|Soft Platforms")
-	TEnumAsByte<ECollisionChannel> SoftCollisionObjectType;
-
-	/** Distance to trace down during soft collision checks */
-	UPROPERTY(EditAnywhere, Category="Side Scrolling|Soft Platforms")
-	float SoftCollisionTraceDistance = 1000.0f;
-
 	/** Last recorded time when this character started falling */
 	float LastFallTime = 0.0f;
 
@@ -79,18 +56,12 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Side Scrolling|Coyote Time", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
 	float MaxCoyoteTime = 0.16f;
 
-	/** Wall jump lockout timer */
-	FTimerHandle WallJumpTimer;
-
 	/** Last captured horizontal movement input value */
 	float ActionValueY = 0.0f;
 
 	/** Last captured platform drop axis value */
 	float DropValue = 0.0f;
 
-	/** If true, this character has already wall jumped */
-	bool bHasWallJumped = false;
-
 	/** If true, this character has already double jumped */
 	bool bHasDoubleJumped = false;
 
@@ -100,13 +71,10 @@ protected:
 public:
 	
 	/** Constructor */
-	ASideScrollingCharacter();
+	ASideScrollingCharacter(const FObjectInitializer& ObjectInitializer);
 
 protected:
 
-	/** Gameplay cleanup */
-	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
-
 	/** Initialize input action bindings */
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
@@ -157,16 +125,8 @@ protected:
 	/** Handles advanced jump logic */
 	void MultiJump();
 
-	/** Checks for soft collision with platforms */
-	void CheckForSoftCollision();
-
-	/** Resets wall jump lockout. Called from timer after a wall jump */
-	void ResetWallJump();
-
-public:
-
-	/** Sets the soft collision response. True passes, False blocks */
-	void SetSoftCollision(bool bEnabled);
+	/** Drops through the soft platform we're standing on, if any */
+	void DropFromPlatform();
 
 public:
 
@@ -177,4 +137,7 @@ public:
 	/** Returns true if the character has just wall jumped */
 	UFUNCTION(BlueprintPure, Category="Side Scrolling")
 	bool HasWallJumped() const;
+
+	/** Returns the side scrolling movement component */
+	USideScrollingCharacterMovementComponent* GetSideScrollingMovement() const;
 };
@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingCharacterMovementComponent.h"
+#include "SideScrollingSoftPlatformSubsystem.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+
+bool USideScrollingCharacterMovementComponent::DropThroughPlatform()
+{
+	// only drop if we're standing on a soft platform
+	const USideScrollingSoftPlatformSubsystem* SoftPlatforms = GetWorld()->GetSubsystem<USideScrollingSoftPlatformSubsystem>();
+
+	if (!SoftPlatforms || !IsMovingOnGround() || !SoftPlatforms->IsSoftPlatform(CurrentFloor.HitResult.GetComponent()))
+	{
+		return false;
+	}
+
+	bWantsToDropThrough = true;
+	return true;
+}
+
+uint8 USideScrollingCharacterMovementComponent::GetMoveRequestFlags() const
+{
+	uint8 Flags = Super::GetMoveRequestFlags();
+
+	if (bWantsToDropThrough)
+	{
+		Flags |= FSavedMove_Character::FLAG_Custom_2;
+	}
+
+	return Flags;
+}
+
+void USideScrollingCharacterMovementComponent::SetMoveRequestFlags(uint8 Flags)
+{
+	Super::SetMoveRequestFlags(Flags);
+
+	bWantsToDropThrough = (Flags & FSavedMove_Character::FLAG_Custom_2) != 0;
+}
+
+void USideScrollingCharacterMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	UpdateSoftPlatforms(DeltaSeconds);
+}
+
+void USideScrollingCharacterMovementComponent::UpdateSoftPlatforms(float DeltaSeconds)
+{
+	const USideScrollingSoftPlatformSubsystem* SoftPlatforms = GetWorld()->GetSubsystem<USideScrollingSoftPlatformSubsystem>();
+
+	if (!SoftPlatforms || !UpdatedPrimitive || !CharacterOwner)
+	{
+		return;
+	}
+
+	// start dropping through the floor
+	if (bWantsToDropThrough)
+	{
+		bWantsToDropThrough = false;
+
+		UPrimitiveComponent* Floor = CurrentFloor.HitResult.GetComponent();
+
+		if (IsMovingOnGround() && SoftPlatforms->IsSoftPlatform(Floor))
+		{
+			DroppingPlatforms.AddUnique(Floor);
+			SetMovementMode(MOVE_Falling);
+		}
+	}
+
+	float Radius, HalfHeight;
+	CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(Radius, HalfHeight);
+
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const FVector FeetLocation = Location + GetGravityDirection() * HalfHeight;
+
+	// find the platforms this move could reach
+	const FVector Reach = Velocity.GetAbs() * DeltaSeconds + FVector(Radius, Radius, HalfHeight) + FVector(SoftPlatformTolerance);
+
+	NearbyPlatforms.Reset();
+	SoftPlatforms->GatherPlatforms(FBox(Location - Reach, Location + Reach), NearbyPlatforms);
+
+	// stop ignoring the platforms we've moved away from
+	for (int32 i = IgnoredPlatforms.Num() - 1; i >= 0; --i)
+	{
+		UPrimitiveComponent* Platform = IgnoredPlatforms[i].Get();
+
+		if (!Platform || !NearbyPlatforms.Contains(Platform))
+		{
+			if (Platform)
+			{
+				UpdatedPrimitive->IgnoreComponentWhenMoving(Platform, false);
+			}
+
+			IgnoredPlatforms.RemoveAtSwap(i, EAllowShrinking::No);
+		}
+	}
+
+	DroppingPlatforms.RemoveAllSwap([this](const TWeakObjectPtr<UPrimitiveComponent>& Platform)
+	{
+		return !Platform.IsValid() || !NearbyPlatforms.Contains(Platform.Get());
+	}, EAllowShrinking::No);
+
+	// update the nearby platforms
+	for (UPrimitiveComponent* Platform : NearbyPlatforms)
+	{
+		SetPlatformIgnored(Platform, ShouldPassThrough(Platform, FeetLocation));
+	}
+}
+
+bool USideScrollingCharacterMovementComponent::ShouldPassThrough(UPrimitiveComponent* Platform, const FVector& FeetLocation)
+{
+	// measure the feet against the platform's top surface along its up vector
+	const FVector Normal = Platform->GetUpVector();
+	const FBoxSphereBounds& Bounds = Platform->Bounds;
+
+	const float TopOffset = FVector::DotProduct(Bounds.BoxExtent, Normal.GetAbs());
+	const float FeetHeight = FVector::DotProduct(FeetLocation - Bounds.Origin, Normal) - TopOffset;
+
+	const float NormalSpeed = FVector::DotProduct(Velocity, Normal);
+
+	// keep dropping until we're below the top surface, unless we jump back up
+	const int32 DropIndex = DroppingPlatforms.IndexOfByKey(Platform);
+
+	if (DropIndex != INDEX_NONE)
+	{
+		if (NormalSpeed <= 0.0f && FeetHeight >= -SoftPlatformTolerance)
+		{
+			return true;
+		}
+
+		DroppingPlatforms.RemoveAtSwap(DropIndex, EAllowShrinking::No);
+	}
+
+	// pass through when below the top surface, or rising through it
+	return FeetHeight < -SoftPlatformTolerance || (FeetHeight < 0.0f && NormalSpeed > 0.0f);
+}
+
+void USideScrollingCharacterMovementComponent::SetPlatformIgnored(UPrimitiveComponent* Platform, bool bIgnored)
+{
+	const int32 Index = IgnoredPlatforms.IndexOfByKey(Platform);
+
+	if (bIgnored == (Index != INDEX_NONE))
+	{
+		return;
+	}
+
+	// this only touches the capsule's move ignore list. The physics filter data is never rebuilt
+	UpdatedPrimitive->IgnoreComponentWhenMoving(Platform, bIgnored);
+
+	if (bIgnored)
+	{
+		IgnoredPlatforms.Add(Platform);
+
+	} else {
+
+		IgnoredPlatforms.RemoveAtSwap(Index, EAllowShrinking::No);
+	}
+}
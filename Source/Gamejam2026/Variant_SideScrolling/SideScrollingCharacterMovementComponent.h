@@ -0,0 +1,62 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCharacterMovementComponent.h"
+#include "SideScrollingCharacterMovementComponent.generated.h"
+
+/**
+ *  Character movement for side scrolling characters.
+ *  Resolves one-way soft platforms before each move: platforms the character is below, rising through or dropping through
+ *  are added to the capsule's move ignore list, so sweeps and floor checks skip them without changing collision responses.
+ *  Drop requests travel with the saved moves alongside the shared wall jump and dash requests.
+ */
+UCLASS()
+class USideScrollingCharacterMovementComponent : public UGameCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** How far below a platform's top surface the character's feet can be and still stand on it */
+	UPROPERTY(EditAnywhere, Category="Character Movement: Soft Platforms", meta = (ClampMin = 0, ClampMax = 50, Units = "cm"))
+	float SoftPlatformTolerance = 5.0f;
+
+	/** Soft platforms currently ignored by the capsule */
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> IgnoredPlatforms;
+
+	/** Soft platforms the character has chosen to drop through */
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> DroppingPlatforms;
+
+	/** Scratch list of soft platforms near the character */
+	TArray<UPrimitiveComponent*> NearbyPlatforms;
+
+	/** If true, the character will drop through the soft platform it's standing on in the next move */
+	bool bWantsToDropThrough = false;
+
+public:
+
+	/** Requests a drop through the soft platform the character is standing on. Returns false if it isn't on one */
+	bool DropThroughPlatform();
+
+	/** Adds the drop request to the shared move request flags */
+	virtual uint8 GetMoveRequestFlags() const override;
+
+	/** Reads the drop request from the shared move request flags */
+	virtual void SetMoveRequestFlags(uint8 Flags) override;
+
+protected:
+
+	/** Resolves soft platforms before the move */
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+
+	/** Updates the capsule's ignore list for the soft platforms near the character */
+	void UpdateSoftPlatforms(float DeltaSeconds);
+
+	/** Returns true if the character should pass through the platform on this move */
+	bool ShouldPassThrough(UPrimitiveComponent* Platform, const FVector& FeetLocation);
+
+	/** Adds or removes a platform from the capsule's ignore list */
+	void SetPlatformIgnored(UPrimitiveComponent* Platform, bool bIgnored);
+};